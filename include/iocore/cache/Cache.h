@@ -27,6 +27,9 @@
 #include "iocore/cache/CacheDefs.h"
 #include "iocore/cache/HttpConfigAccessor.h"
 
+#include <string_view>
+#include <vector>
+
 static constexpr ts::ModuleVersion CACHE_MODULE_VERSION(1, 0);
 
 #define CACHE_WRITE_OPT_OVERWRITE      0x0001
@@ -36,15 +39,26 @@ static constexpr ts::ModuleVersion CACHE_MODULE_VERSION(1, 0);
 
 #define SCAN_KB_PER_SECOND 8192 // 1TB/8MB = 131072 = 36 HOURS to scan a TB
 
-#define RAM_CACHE_ALGORITHM_CLFUS 0
-#define RAM_CACHE_ALGORITHM_LRU   1
+#define RAM_CACHE_ALGORITHM_CLFUS   0
+#define RAM_CACHE_ALGORITHM_LRU     1
+#define RAM_CACHE_ALGORITHM_TINYLFU 2
 
 #define CACHE_COMPRESSION_NONE    0
 #define CACHE_COMPRESSION_FASTLZ  1
 #define CACHE_COMPRESSION_LIBZ    2
 #define CACHE_COMPRESSION_LIBLZMA 3
-
-enum { RAM_HIT_COMPRESS_NONE = 1, RAM_HIT_COMPRESS_FASTLZ, RAM_HIT_COMPRESS_LIBZ, RAM_HIT_COMPRESS_LIBLZMA, RAM_HIT_LAST_ENTRY };
+#define CACHE_COMPRESSION_ZSTD    4
+#define CACHE_COMPRESSION_LZ4     5
+
+enum {
+  RAM_HIT_COMPRESS_NONE = 1,
+  RAM_HIT_COMPRESS_FASTLZ,
+  RAM_HIT_COMPRESS_LIBZ,
+  RAM_HIT_COMPRESS_LIBLZMA,
+  RAM_HIT_COMPRESS_ZSTD,
+  RAM_HIT_COMPRESS_LZ4,
+  RAM_HIT_LAST_ENTRY
+};
 
 struct CacheVC;
 class CacheEvacuateDocVC;
@@ -103,6 +117,22 @@ struct CacheProcessor : public Processor {
    */
   CacheDisk *find_by_path(std::string_view path = std::string_view{});
 
+  /// Initialization progress of a stripe.
+  struct StripeStatus {
+    std::string_view path;            ///< Storage the stripe is on.
+    std::string_view id;              ///< Stripe identification, the storage path with the stripe offset and size.
+    std::string_view state;           ///< Initialization state.
+    int              volume;          ///< Cache volume number.
+    int64_t          size;            ///< Stripe content size in bytes.
+    int64_t          directory_bytes; ///< Size of one copy of the stripe directory.
+    int64_t          recovered_bytes; ///< Stripe content scanned by directory recovery so far.
+  };
+
+  /** Status of the stripes, including those still initializing.
+      Stripes are listed as soon as they are created, before their directory is read.
+   */
+  std::vector<StripeStatus> stripe_status() const;
+
   /** Check if there are any online storage devices.
       If this returns @c false then the cache should be disabled as there is no storage available.
   */
@@ -176,6 +206,16 @@ struct CacheVConnection : public VConnection {
   virtual int set_header(void *ptr, int len)        = 0;
   virtual int get_single_data(void **ptr, int *len) = 0;
 
+  /** Get the entire body of a single fragment document that is already in memory.
+      The block shares the cache's buffer, so no data is copied.
+      @return The body, or @c nullptr if the VC has not yet been read from or the body is not wholly in memory.
+  */
+  virtual IOBufferBlock *
+  get_single_data_block()
+  {
+    return nullptr;
+  }
+
   virtual void set_http_info(CacheHTTPInfo *info)  = 0;
   virtual void get_http_info(CacheHTTPInfo **info) = 0;
 
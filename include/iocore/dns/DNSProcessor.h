@@ -38,6 +38,7 @@
 
 #include <cstdint>
 #include <string_view>
+#include <vector>
 
 // Events
 #define DNS_EVENT_LOOKUP DNS_EVENT_EVENTS_START
@@ -97,8 +98,8 @@ struct DNSProcessor : public Processor {
   struct Options {
     using self_type = Options; ///< Self reference type.
 
-    /// Query handler to use.
-    /// Default: single threaded handler.
+    /// Query handler to use, only with SplitDNS.
+    /// Default: the shard of the queried name.
     DNSHandler *handler = nullptr;
     /// Query timeout value.
     /// Default: @c DEFAULT_DNS_TIMEOUT (or as set in records.yaml)
@@ -146,17 +147,25 @@ struct DNSProcessor : public Processor {
    * dont pass any value to the call */
   int start(int no_of_extra_dns_threads = 0, size_t stacksize = DEFAULT_STACKSIZE) override;
 
-  // Open/close a link to a 'named' (done in start())
+  // Open/close a link to a 'named' (done in start(), once per shard)
   //
-  void open(sockaddr const *ns = nullptr);
+  DNSHandler *open(EThread *t, sockaddr const *ns = nullptr);
+
+  /** The handler that resolves @a name for queries of type @a qtype.
+
+      Lookups are spread over the shards by a hash of the name and type, so
+      that identical lookups meet on one handler and are collapsed there.
+   */
+  DNSHandler *shard_for(std::string_view name, int qtype) const;
 
   DNSProcessor();
 
   // private:
   //
-  EThread         *thread  = nullptr;
-  DNSHandler      *handler = nullptr;
-  ts_imp_res_state l_res;
+  EThread                  *thread  = nullptr;
+  DNSHandler               *handler = nullptr; ///< The first shard, also used by SplitDNS.
+  std::vector<DNSHandler *> shards;            ///< Independent handlers, each with its own thread and sockets.
+  ts_imp_res_state          l_res;
   IpEndpoint       local_ipv6;
   IpEndpoint       local_ipv4;
 
@@ -68,7 +68,8 @@ public:
   int                 set_wq_max_workers(unsigned int bounded, unsigned int unbounded);
   std::pair<int, int> get_wq_max_workers();
 
-  void submit();
+  /// Submit the queued SQEs, @return the number submitted.
+  int  submit();
   void service();
   void submit_and_wait(ink_hrtime ms);
 
@@ -75,8 +75,8 @@ public:
   // Close when EventIO close;
   virtual int close() = 0;
 
-  bool has_error() const;
-  void set_error_from_socket();
+  bool         has_error() const;
+  virtual void set_error_from_socket();
 
   // get fd
   virtual int              get_fd()            = 0;
@@ -117,6 +117,7 @@ public:
     uint32_t transaction_no_activity_timeout_in = 0;
     uint32_t keep_alive_no_activity_timeout_in  = 0;
     uint32_t default_inactivity_timeout         = 0;
+    uint32_t zerocopy_min_write_size_in         = 0;
 
     /** Return the address of the first value in this struct.
 
@@ -155,6 +156,13 @@ public:
   /// updated. Event type threads that use @c NetHandler must set the
   /// corresponding bit.
   static std::bitset<std::numeric_limits<unsigned int>::digits> active_thread_types;
+#if TS_USE_LINUX_IO_URING
+  /// Whether socket IO through io_uring was requested, from @c proxy.config.io_uring.net_io.
+  static bool io_uring_net_configured;
+  /// Plain TCP socket reads and writes on this thread are submitted to the thread's io_uring instead of being issued
+  /// as syscalls. Only set if requested and the thread's ring supports the ops, otherwise the epoll path is used.
+  bool io_uring_net = false;
+#endif
 
   int        mainNetEvent(int event, Event *data);
   int        waitForActivity(ink_hrtime timeout) override;
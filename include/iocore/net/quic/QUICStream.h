@@ -62,6 +62,16 @@ public:
   void receive_data(quiche_conn *quiche_con);
   void send_data(quiche_conn *quiche_con);
 
+  /**
+   * Set the urgency and the incremental parameter of the data sent on this stream
+   *
+   * The priority is passed to quiche with the next data, which schedules the streams of a connection by it. Once a
+   * PRIORITY_UPDATE frame has set the priority ( @a is_update ), the priority of the request no longer changes it.
+   */
+  void    set_priority(uint8_t urgency, bool incremental, bool is_update = false);
+  uint8_t urgency() const;
+  bool    is_incremental() const;
+
   /*
    * QUICApplication need to call one of these functions when it process VC_EVENT_*
    */
@@ -85,6 +95,12 @@ protected:
   uint64_t                    _received_bytes   = 0;
   uint64_t                    _sent_bytes       = 0;
   bool                        _has_no_more_data = false;
+
+  // quiche's own default, so a request without a Priority field still gets the default of [RFC 9218].
+  uint8_t _urgency          = 3;
+  bool    _incremental      = true;
+  bool    _priority_changed = false;
+  bool    _priority_updated = false;
 };
 
 class QUICStreamStateListener
@@ -26,4 +26,5 @@ namespace rpc::handlers::storage
 {
 swoc::Rv<YAML::Node> set_storage_offline(std::string_view const &id, YAML::Node const &params);
 swoc::Rv<YAML::Node> get_storage_status(std::string_view const &id, YAML::Node const &params);
+swoc::Rv<YAML::Node> get_stripe_status(std::string_view const &id, YAML::Node const &params);
 } // namespace rpc::handlers::storage
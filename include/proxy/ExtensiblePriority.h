@@ -0,0 +1,128 @@
+/** @file
+
+  Extensible Prioritization Scheme for HTTP ([RFC 9218]), shared by HTTP/2 and HTTP/3.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string_view>
+
+#include "tscore/List.h"
+
+namespace ExtensiblePriority
+{
+// [RFC 9218] 4.1. Urgency
+constexpr uint8_t URGENCY_LEVELS  = 8;
+constexpr uint8_t DEFAULT_URGENCY = 3;
+
+/// The priority parameters of a response, lower urgency is sent first.
+struct Priority {
+  uint8_t urgency     = DEFAULT_URGENCY;
+  bool    incremental = false;
+
+  bool
+  operator==(const Priority &that) const
+  {
+    return urgency == that.urgency && incremental == that.incremental;
+  }
+};
+
+/** Parse a Priority field value, a Structured Fields Dictionary ([RFC 8941] 3.2).
+ *
+ * The u and i parameters present in @a value replace those in @a priority, anything else is ignored. Nothing
+ * is changed if @a value is not a valid Dictionary.
+ *
+ * @return @c false if @a value is not a valid Dictionary.
+ */
+bool parse(std::string_view value, Priority &priority);
+
+class Node
+{
+public:
+  Node(uint32_t id, const Priority &priority, void *t) : id(id), priority(priority), t(t) {}
+
+  Node(const Node &)            = delete;
+  Node &operator=(const Node &) = delete;
+
+  LINK(Node, link);
+
+  uint32_t id;
+  Priority priority;
+  bool     active  = false;
+  bool     updated = false; ///< Set by a PRIORITY_UPDATE frame, which takes precedence over the Priority header field.
+  void    *t       = nullptr;
+};
+
+/** Picks the response to send next, by urgency and then by the incremental parameter.
+ *
+ * Every urgency has a queue for non-incremental responses, sent one after the other in the order of their
+ * ids, and a queue for incremental ones, which take turns frame by frame. Non-incremental responses go first
+ * within an urgency, they are usually the ones a client cannot use before they are complete. A bit per queue
+ * tells which ones have active nodes, so top() is a count of trailing zeros. Activating a non-incremental
+ * node searches its queue from the back, which is a single step when ids only go up.
+ *
+ * Nodes are created by add() and deleted by remove().
+ */
+class Scheduler
+{
+public:
+  Node    *add(uint32_t id, const Priority &priority, void *t);
+  void     remove(Node *node);
+  void     reprioritize(Node *node, const Priority &priority);
+  Node    *top() const;
+  void     activate(Node *node);
+  void     deactivate(Node *node, uint32_t sent);
+  void     update(Node *node, uint32_t sent);
+  uint32_t size() const;
+
+private:
+  static unsigned _index(const Priority &priority);
+
+  Queue<Node> _queues[URGENCY_LEVELS * 2];
+  uint32_t    _ready = 0; ///< Bit per non-empty queue.
+  uint32_t    _size  = 0;
+};
+
+/** The priorities of PRIORITY_UPDATE frames for request streams that are not open yet ([RFC 9218] 7.1).
+ *
+ * Only the last update of a stream is kept, until the stream opens. The ids of request streams only go up, so
+ * opening one drops the updates of lower ids, which can no longer open.
+ */
+class PendingUpdates
+{
+public:
+  /// Keep @a priority for stream @a id, @return @c false if @a limit other streams have updates pending already.
+  bool add(uint64_t id, const Priority &priority, size_t limit);
+
+  /// Take the update pending for the stream @a id, which has opened, @return @c false if there is none.
+  bool take(uint64_t id, Priority &priority);
+
+  size_t size() const;
+  void   clear();
+
+private:
+  std::map<uint64_t, Priority> _updates;
+};
+
+} // namespace ExtensiblePriority
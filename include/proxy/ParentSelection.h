@@ -35,6 +35,7 @@
 #include "proxy/ControlMatcher.h"
 #include "records/RecProcess.h"
 #include "tscore/ConsistentHash.h"
+#include "tscore/MaglevHash.h"
 #include "tscore/Tokenizer.h"
 #include "tscore/ink_apidefs.h"
 #include "proxy/HostStatus.h"
@@ -313,6 +314,7 @@ private:
   // state for consistent hash.
   int                   last_lookup;
   ATSConsistentHashIter chashIter[MAX_GROUP_RINGS];
+  ATSMaglevHashIter     maglevIter[MAX_GROUP_RINGS];
 
   friend class NextHopSelectionStrategy;
   friend class NextHopRoundRobin;
@@ -280,6 +280,7 @@ struct HTTPHdrImpl : public HdrHeapObjImpl {
   // Marshaling Functions
   int    marshal(MarshalXlate *ptr_xlate, int num_ptr, MarshalXlate *str_xlate, int num_str);
   void   unmarshal(intptr_t offset);
+  void   move_objects(intptr_t offset);
   void   move_strings(HdrStrHeap *new_heap);
   size_t strings_length();
 
@@ -729,6 +730,11 @@ HTTPHdr::copy(const HTTPHdr *hdr)
 
   if (valid()) {
     http_hdr_copy_onto(hdr->m_http, hdr->m_heap, m_http, m_heap, (m_heap != hdr->m_heap) ? true : false);
+  } else if ((m_heap = hdr->m_heap->duplicate()) != nullptr) {
+    // Read from cache, copy the objects in one piece and share the strings.
+    intptr_t offset = m_heap->m_data_start - hdr->m_heap->m_data_start;
+    m_http          = reinterpret_cast<HTTPHdrImpl *>(reinterpret_cast<char *>(hdr->m_http) + offset);
+    m_mime          = m_http->m_fields_impl;
   } else {
     m_heap = new_HdrHeap();
     m_http = http_hdr_clone(hdr->m_http, hdr->m_heap, m_heap);
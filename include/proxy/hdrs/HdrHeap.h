@@ -199,6 +199,15 @@ public:
   int unmarshal_size() const; // TBD - change this name, it's confusing.
   // One option - overload marshal_length to return this value if @a magic is HdrBufMagic::MARSHALED.
 
+  /** Make a writable copy of an unmarshalled heap.
+   *
+   * The objects are copied with a single @c memcpy and their pointers moved to the copy. The strings are
+   * not copied, the copy attaches the string heaps of this heap as read only heaps.
+   *
+   * @return The copy, or @c nullptr if this is not a single block read only heap.
+   */
+  HdrHeap *duplicate() const;
+
   void inherit_string_heaps(const HdrHeap *inherit_from);
   int  attach_block(IOBufferBlock *b, const char *use_start);
   void set_ronly_str_heap_end(int slot, const char *end);
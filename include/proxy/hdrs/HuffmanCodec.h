@@ -26,8 +26,6 @@
 #include <cstddef>
 #include <cstdint>
 
-void     hpack_huffman_init();
-void     hpack_huffman_fin();
 int64_t  huffman_decode(char *dst_start, const uint8_t *src, uint32_t src_len);
 uint8_t *huffman_encode_append(uint8_t *dst, uint32_t src, int n);
 int64_t  huffman_encode(uint8_t *dst_start, const uint8_t *src, uint32_t src_len);
@@ -196,6 +196,7 @@ struct MIMEFieldBlockImpl : public HdrHeapObjImpl {
   // Marshaling Functions
   int    marshal(MarshalXlate *ptr_xlate, int num_ptr, MarshalXlate *str_xlate, int num_str);
   void   unmarshal(intptr_t offset);
+  void   move_objects(intptr_t offset);
   void   move_strings(HdrStrHeap *new_heap);
   size_t strings_length();
   bool   contains(const MIMEField *field);
@@ -318,6 +319,7 @@ struct MIMEHdrImpl : public HdrHeapObjImpl {
   // Marshaling Functions
   int    marshal(MarshalXlate *ptr_xlate, int num_ptr, MarshalXlate *str_xlate, int num_str);
   void   unmarshal(intptr_t offset);
+  void   move_objects(intptr_t offset);
   void   move_strings(HdrStrHeap *new_heap);
   size_t strings_length();
 
@@ -459,6 +461,21 @@ public:
    */
   ParseResult get(swoc::TextView &input, swoc::TextView &output, bool &output_shares_input, bool eof_p, ScanType scan_type);
 
+  /** Scan a plain field line from @a input without going through the state machine.
+   *
+   * @param input [in,out] Text to scan.
+   * @param output [out] The line, including its terminating CR LF or LF.
+   * @param colon [out] Offset of the first ':' in @a output, or @c npos if there is none.
+   * @return @c true if a line was scanned, @c false if @a input must be scanned with @c get.
+   *
+   * A plain line is complete in @a input, has no control characters other than HT before its
+   * terminating CR LF or LF, and is not folded. This is nearly every line of a real header, and for
+   * these lines this is equivalent to @c get with @c ScanType::FIELD. The delimiters are found with
+   * one vectorized pass over the line. Nothing is consumed if the scanner is in the middle of a
+   * line or the line is not plain.
+   */
+  bool get_field_line(swoc::TextView &input, swoc::TextView &output, size_t &colon);
+
 protected:
   /** Append @a text to the internal buffer.
    *
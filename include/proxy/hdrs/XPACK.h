@@ -25,6 +25,7 @@
 
 #include <cstdint>
 #include <string_view>
+#include <unordered_map>
 #include "tscore/Arena.h"
 
 const static int XPACK_ERROR_COMPRESSION_ERROR   = -1;
@@ -49,6 +50,10 @@ struct XpackDynamicTableEntry {
   uint32_t    value_len = 0;
   uint32_t    ref_count = 0;
   const char *wks       = nullptr;
+  /// Index of the next older entry with the same name hash, see XpackDynamicTable::_name_index.
+  uint32_t older_same_name = 0;
+  /// Index of the next older entry with the same name and value hash, see XpackDynamicTable::_field_index.
+  uint32_t older_same_field = 0;
 };
 
 /** The memory containing the header fields. */
@@ -239,6 +244,28 @@ private:
   uint32_t                       _entries_tail = 0;
   XpackDynamicTableStorage       _storage;
 
+  /// Marks the end of an XpackDynamicTableEntry older_same_* chain.
+  static constexpr uint32_t NO_ENTRY = UINT32_MAX;
+
+  /** Hash indices for lookups by name and by name and value.
+   *
+   * Each maps the hash of a name (or of a name and value) to the index of the newest entry with that hash. Older entries with
+   * the same hash are chained from it through XpackDynamicTableEntry::older_same_name (or older_same_field). A chain ends at
+   * NO_ENTRY or at an entry that was evicted, and may contain entries whose names or values only have the same hash, so
+   * candidates are always compared against the storage.
+   */
+  std::unordered_map<size_t, uint32_t> _name_index;
+  std::unordered_map<size_t, uint32_t> _field_index;
+
+  /** Whether the entry at @a pos has the name @a name (and the value @a value, if it is not @c nullptr). */
+  bool _entry_matches(uint32_t pos, std::string_view name, const std::string_view *value) const;
+
+  /** Remove the entry at @a pos, which is about to be evicted, from the hash indices. */
+  void _unindex_entry(uint32_t pos);
+
+  /** Calculate the position in @a _entries of the live entry with the absolute index @a index. */
+  uint32_t _entry_position(uint32_t index) const;
+
   /** Expand @a _storage to the new size.
    *
    * This takes care of expanding @a _storage's size and handles updating the
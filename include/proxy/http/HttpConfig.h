@@ -87,6 +87,7 @@ struct HttpStatsBlock {
   Metrics::Counter::AtomicType *cache_open_write_begin_time;
   Metrics::Counter::AtomicType *cache_open_write_end_time;
   Metrics::Counter::AtomicType *cache_open_write_fail_count;
+  Metrics::Counter::AtomicType *cache_ram_hit_fast_path;
   Metrics::Counter::AtomicType *cache_read_error;
   Metrics::Counter::AtomicType *cache_read_errors;
   Metrics::Counter::AtomicType *cache_updates;
@@ -168,6 +169,9 @@ struct HttpStatsBlock {
   Metrics::Counter::AtomicType *parent_proxy_response_total_bytes;
   Metrics::Counter::AtomicType *parent_proxy_transaction_time;
   Metrics::Gauge::AtomicType   *pooled_server_connections;
+  Metrics::Counter::AtomicType *pooled_server_session_hits;
+  Metrics::Counter::AtomicType *pooled_server_session_misses;
+  Metrics::Counter::AtomicType *pooled_server_session_steals;
   Metrics::Counter::AtomicType *post_body_too_large;
   Metrics::Counter::AtomicType *post_requests;
   Metrics::Counter::AtomicType *proxy_loop_detected;
@@ -760,6 +764,8 @@ public:
   MgmtInt max_payload_iobuf_index = BUFFER_SIZE_INDEX_32K;
   MgmtInt max_msg_iobuf_index     = BUFFER_SIZE_INDEX_32K;
 
+  MgmtInt cache_ram_hit_fast_path_size = 16384;
+
   char                       *redirect_actions_string      = nullptr;
   RedirectEnabled::ActionMap *redirect_actions_map         = nullptr;
   RedirectEnabled::Action     redirect_actions_self_action = RedirectEnabled::Action::INVALID;
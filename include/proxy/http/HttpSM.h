@@ -438,6 +438,7 @@ private:
   void                setup_server_send_request_api();
   HttpTunnelProducer *setup_server_transfer();
   HttpTunnelProducer *setup_cache_read_transfer();
+  IOBufferBlock      *ram_hit_body();
   void                setup_internal_transfer(HttpSMHandler handler);
   void                setup_error_transfer();
 
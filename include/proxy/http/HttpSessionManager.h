@@ -134,6 +134,13 @@ private:
   ServerSessionPool             *m_g_pool = nullptr;
   HSMresult_t                    _acquire_session(sockaddr const *ip, CryptoHash const &hostname_hash, HttpSM *sm,
                                                   TSServerSessionSharingMatchMask match_style, TSServerSessionSharingPoolType pool_type);
+  /// Take a matching session from the pool of another thread, for a sharded pool.
+  /// A multiplexed match ends the search, it cannot move to this thread.
+  HSMresult_t                    _steal_session(sockaddr const *ip, CryptoHash const &hostname_hash, HttpSM *sm,
+                                                TSServerSessionSharingMatchMask match_style);
+  /// Move the connection of @a ssn, just taken from @a pool, to @a ethread.
+  /// @return @c false if the move failed, in which case @a ssn is closed and cleared.
+  bool                           _migrate_session(ServerSessionPool *pool, PoolableSession *&ssn, HttpSM *sm, EThread *ethread);
   TSServerSessionSharingPoolType m_pool_type = TS_SERVER_SESSION_SHARING_POOL_THREAD;
 };
 
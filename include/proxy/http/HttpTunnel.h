@@ -176,6 +176,15 @@ private:
    */
   int64_t read_size();
 
+  /** Read the chunks that are complete in the first block of the chunked reader.
+   *
+   * This is a fast path for streams of small chunks, it leaves anything it
+   * does not handle to read_size and read_chunk.
+   *
+   * @return The number of bytes consumed from the chunked buffer reader.
+   */
+  int64_t read_chunks_in_block();
+
   /** Read a chunk body.
    *
    * This is called after read_size so that the chunk size is known.
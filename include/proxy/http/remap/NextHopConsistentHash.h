@@ -26,6 +26,7 @@
 #include <map>
 #include <vector>
 #include "tscore/HashSip.h"
+#include "tscore/MaglevHash.h"
 #include "proxy/http/remap/NextHopSelectionStrategy.h"
 
 enum class NHHashKeyType {
@@ -39,15 +40,22 @@ enum class NHHashKeyType {
 
 enum class NHHashUrlType { REQUEST = 0, CACHE, PARENT };
 
+enum class NHHashAlgorithmType {
+  RING = 0, // default, a ring of virtual nodes per host
+  MAGLEV
+};
+
 class NextHopConsistentHash : public NextHopSelectionStrategy
 {
   std::vector<std::shared_ptr<ATSConsistentHash>> rings;
+  std::vector<std::shared_ptr<ATSMaglevHash>>     maglev_tables;
 
   uint64_t getHashKey(uint64_t sm_id, const HttpRequestData &hrdata, ATSHash64 *h);
 
 public:
-  NHHashKeyType hash_key = NHHashKeyType::PATH_HASH_KEY;
-  NHHashUrlType hash_url = NHHashUrlType::REQUEST;
+  NHHashKeyType       hash_key       = NHHashKeyType::PATH_HASH_KEY;
+  NHHashUrlType       hash_url       = NHHashUrlType::REQUEST;
+  NHHashAlgorithmType hash_algorithm = NHHashAlgorithmType::RING;
 
   NextHopConsistentHash() = delete;
   NextHopConsistentHash(const std::string_view name, const NHPolicyType &policy, ts::Yaml::Map &n);
@@ -56,4 +64,6 @@ public:
   void                        findNextHop(TSHttpTxn txnp, void *ih = nullptr, time_t now = 0) override;
   std::shared_ptr<HostRecord> chashLookup(const std::shared_ptr<ATSConsistentHash> &ring, uint32_t cur_ring, ParentResult &result,
                                           HttpRequestData &request_info, bool *wrapped, uint64_t sm_id);
+  std::shared_ptr<HostRecord> maglevLookup(const std::shared_ptr<ATSMaglevHash> &table, uint32_t cur_ring, ParentResult &result,
+                                           HttpRequestData &request_info, bool *wrapped, uint64_t sm_id);
 };
@@ -0,0 +1,85 @@
+/** @file
+
+    Literal prefilter for regex remap rules.
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/** Selects the regex rules that can match a host in a single pass over the host.
+
+    Each rule is reduced to a literal string that every match of its regex must contain. All of the
+    literals are compiled into one Aho-Corasick automaton, so scanning the host once finds every
+    rule whose literal occurs in it. A rule without a usable literal is a candidate for every host.
+    The regexes of the candidates still have to be run, the prefilter only discards rules that
+    cannot match.
+*/
+class RegexPrefilter
+{
+public:
+  /** Find a literal that is part of every match of @a pattern.
+
+      This is the longest run of plain characters that is outside of any group, character class or
+      quantifier. Patterns with a top level alternation or constructs that change how the rest of the
+      pattern is read (inline options, quoting) have none.
+
+      @return The literal, or an empty string if there is none worth indexing.
+  */
+  static std::string required_literal(std::string_view pattern);
+
+  /** Build the automaton.
+
+      @param literals The required literal of each rule, in rank order. An empty literal makes the rule
+      a candidate for every host.
+  */
+  void build(std::vector<std::string> const &literals);
+
+  /** Find the rules that can match @a host.
+
+      @param host The lower cased host.
+      @param candidates Set to the indexes of the candidate rules, in increasing order.
+  */
+  void candidates(std::string_view host, std::vector<uint32_t> &candidates) const;
+
+  /// @return The number of rules the prefilter was built for.
+  size_t
+  size() const
+  {
+    return _n_rules;
+  }
+
+private:
+  /// Host name characters: a-z, 0-9, '.', '-' and '_'. Other characters are never part of a literal.
+  static constexpr int ALPHABET = 39;
+
+  static int symbol(char c);
+
+  using State = std::array<int32_t, ALPHABET>;
+
+  std::vector<State>                 _next;   ///< Transitions, completed along the failure links.
+  std::vector<std::vector<uint32_t>> _out;    ///< Rules whose literal ends at each state.
+  std::vector<uint32_t>              _always; ///< Rules without a literal.
+  size_t                             _n_rules = 0;
+};
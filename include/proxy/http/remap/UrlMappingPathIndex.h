@@ -28,7 +28,7 @@
 
 #include "proxy/hdrs/URL.h"
 #include "proxy/http/remap/UrlMapping.h"
-#include "tscore/Trie.h"
+#include "tscore/CompactTrie.h"
 
 class UrlMappingPathIndex
 {
@@ -36,12 +36,13 @@ public:
   UrlMappingPathIndex() {}
   virtual ~UrlMappingPathIndex();
   bool         Insert(url_mapping *mapping);
+  void         Freeze();
   url_mapping *Search(URL *request_url, int request_port, bool normal_search = true) const;
   void         Print() const;
   std::string  PrintUrlMappingPathIndex() const;
 
 private:
-  using UrlMappingTrie = Trie<url_mapping>;
+  using UrlMappingTrie = CompactTrie<url_mapping>;
 
   struct UrlMappingTrieKey {
     int scheme_wks_idx;
@@ -27,6 +27,7 @@
 #include "iocore/eventsystem/Freer.h"
 #include "proxy/http/remap/UrlMapping.h"
 #include "proxy/http/remap/UrlMappingPathIndex.h"
+#include "proxy/http/remap/RegexPrefilter.h"
 #include "proxy/http/HttpTransact.h"
 #include "tsutil/Regex.h"
 #include "proxy/http/remap/PluginFactory.h"
@@ -154,6 +155,9 @@ public:
   struct MappingsStore {
     std::unique_ptr<URLTable> hash_lookup;
     RegexMappingList          regex_list;
+    // regex_list in rank order and the prefilter over it, built once the configuration is loaded
+    std::vector<RegexMapping *> regex_rules;
+    RegexPrefilter              regex_prefilter;
     bool
     empty()
     {
@@ -171,6 +175,7 @@ public:
   {
     _destroyTable(store.hash_lookup);
     _destroyList(store.regex_list);
+    store.regex_rules.clear();
   }
 
   bool InsertForwardMapping(mapping_type maptype, url_mapping *mapping, const char *src_host);
@@ -240,8 +245,13 @@ private:
                       UrlMappingContainer &mapping_container);
   url_mapping *_tableLookup(std::unique_ptr<URLTable> &h_table, URL *request_url, int request_port, char *request_host,
                             int request_host_len);
-  bool         _regexMappingLookup(RegexMappingList &regex_mappings, URL *request_url, int request_port, const char *request_host,
+  bool         _regexMappingLookup(MappingsStore &mappings, URL *request_url, int request_port, const char *request_host,
                                    int request_host_len, int rank_ceiling, UrlMappingContainer &mapping_container);
+  bool         _regexMappingMatch(RegexMapping *reg_map, std::string_view request_scheme, int request_port,
+                                  std::string_view request_path, const char *request_host, int request_host_len,
+                                  UrlMappingContainer &mapping_container);
+  void         _buildRegexPrefilter(MappingsStore &store);
+  void         _compileStore(MappingsStore &store);
   int          _expandSubstitutions(size_t *matches_info, const RegexMapping *reg_map, const char *matched_string, char *dest_buf,
                                     int dest_buf_size);
   void         _destroyTable(std::unique_ptr<URLTable> &h_table);
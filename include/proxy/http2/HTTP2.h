@@ -56,6 +56,7 @@ const size_t HTTP2_RST_STREAM_LEN         = 4;
 const size_t HTTP2_PING_LEN               = 8;
 const size_t HTTP2_GOAWAY_LEN             = 8;
 const size_t HTTP2_WINDOW_UPDATE_LEN      = 4;
+const size_t HTTP2_PRIORITY_UPDATE_LEN    = 4;
 const size_t HTTP2_SETTINGS_PARAMETER_LEN = 6;
 
 // SETTINGS initial values. NOTE: These should not be modified
@@ -177,6 +178,9 @@ enum Http2FrameType {
   HTTP2_FRAME_TYPE_CONTINUATION  = 9,
 
   HTTP2_FRAME_TYPE_MAX,
+
+  // [RFC 9218] 7.1. PRIORITY_UPDATE, handled on its own since it is outside the densely numbered types
+  HTTP2_FRAME_TYPE_PRIORITY_UPDATE = 16,
 };
 
 extern Metrics::Counter::AtomicType *http2_frame_metrics_in[HTTP2_FRAME_TYPE_MAX + 1];
@@ -257,6 +261,16 @@ enum Http2SettingsIdentifier {
   HTTP2_SETTINGS_MAX_FRAME_SIZE         = 5,
   HTTP2_SETTINGS_MAX_HEADER_LIST_SIZE   = 6,
   HTTP2_SETTINGS_MAX, // Really just the max of the "densely numbered" core id's
+
+  // [RFC 9218] 2.1. Sent but never tracked, the value does not change during a connection
+  HTTP2_SETTINGS_NO_RFC7540_PRIORITIES = 9,
+};
+
+// Values of proxy.config.http2.stream_priority_enabled
+enum Http2PriorityScheme {
+  HTTP2_PRIORITY_SCHEME_NONE    = 0,
+  HTTP2_PRIORITY_SCHEME_RFC7540 = 1, ///< Dependency tree
+  HTTP2_PRIORITY_SCHEME_RFC9218 = 2, ///< Extensible priorities
 };
 
 // [RFC 7540] 4.1. Frame Format
@@ -372,6 +386,8 @@ bool http2_parse_goaway(IOVec, Http2Goaway &);
 
 bool http2_parse_window_update(IOVec, uint32_t &);
 
+bool http2_parse_priority_update(IOVec, Http2StreamId &);
+
 Http2ErrorCode http2_decode_header_blocks(HTTPHdr *, const uint8_t *, const uint32_t, uint32_t *, HpackHandle &, bool, uint32_t,
                                           bool is_outbound = false);
 
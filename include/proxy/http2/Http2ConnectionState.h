@@ -32,6 +32,7 @@
 #include "proxy/http2/HPACK.h"
 #include "proxy/http2/Http2Stream.h"
 #include "proxy/http2/Http2DependencyTree.h"
+#include "proxy/http2/Http2StreamTable.h"
 #include "tscore/FrequencyCounter.h"
 
 class Http2CommonSession;
@@ -79,13 +80,14 @@ public:
   Http2ConnectionState(const Http2ConnectionState &)            = delete;
   Http2ConnectionState &operator=(const Http2ConnectionState &) = delete;
 
-  ProxyError               rx_error_code;
-  ProxyError               tx_error_code;
-  Http2CommonSession      *session            = nullptr;
-  HpackHandle             *local_hpack_handle = nullptr;
-  HpackHandle             *peer_hpack_handle  = nullptr;
-  DependencyTree          *dependency_tree    = nullptr;
-  ActivityCop<Http2Stream> _cop;
+  ProxyError                     rx_error_code;
+  ProxyError                     tx_error_code;
+  Http2CommonSession            *session            = nullptr;
+  HpackHandle                   *local_hpack_handle = nullptr;
+  HpackHandle                   *peer_hpack_handle  = nullptr;
+  DependencyTree                *dependency_tree    = nullptr;
+  ExtensiblePriority::Scheduler *priority_scheduler = nullptr;
+  ActivityCop<Http2Stream>       _cop;
 
   /** The HTTP/2 settings configured by ATS and dictated to the peer via
    * SETTINGS frames. */
@@ -225,6 +227,7 @@ private:
   Http2Error rcv_goaway_frame(const Http2Frame &);
   Http2Error rcv_window_update_frame(const Http2Frame &);
   Http2Error rcv_continuation_frame(const Http2Frame &);
+  Http2Error rcv_priority_update_frame(const Http2Frame &);
 
   using http2_frame_dispatch = Http2Error (Http2ConnectionState::*)(const Http2Frame &);
   static constexpr http2_frame_dispatch _frame_handlers[HTTP2_FRAME_TYPE_MAX] = {
@@ -242,6 +245,8 @@ private:
 
   unsigned _adjust_concurrent_stream();
 
+  template <typename Scheduler> void _send_data_frames_by_priority(Scheduler &scheduler);
+
   /** Receive and process a SETTINGS frame with the ACK flag set.
    *
    * This function will process any settings updates that have now been
@@ -276,10 +281,15 @@ private:
   //   is CLOSED.
   //   If given Stream Identifier is not found in stream_list and it is greater
   //   than latest_streamid_in, the state of Stream is IDLE.
-  Queue<Http2Stream> stream_list;
-  Http2StreamId      latest_streamid_in  = 0;
-  Http2StreamId      latest_streamid_out = 0;
-  std::atomic<int>   stream_requests     = 0;
+  //   'stream_table' has the same streams once they have an id, for find_stream().
+  Queue<Http2Stream>            stream_list;
+  Http2StreamTable<Http2Stream> stream_table;
+  Http2StreamId                 latest_streamid_in  = 0;
+  Http2StreamId                 latest_streamid_out = 0;
+  std::atomic<int>              stream_requests     = 0;
+
+  // [RFC 9218] 7.1. PRIORITY_UPDATE frames received for client streams that are still idle
+  ExtensiblePriority::PendingUpdates _pending_priority_updates;
 
   // Counter for current active streams which are started by the client.
   std::atomic<uint32_t> peer_streams_count_in = 0;
@@ -390,6 +400,8 @@ private:
 
   static constexpr const int DATA_EVENT_BACKOFF_START = 10;
   static constexpr const int DATA_EVENT_BACKOFF_MAX   = 1000;
+  // DATA bytes sent in one pass over the priority tree before yielding the thread.
+  static constexpr const size_t PRIORITY_PASS_BYTES = 256 * 1024;
 
   // NOTE: Id of stream which MUST receive CONTINUATION frame.
   //   - [RFC 7540] 6.2 HEADERS
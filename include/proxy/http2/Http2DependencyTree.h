@@ -579,4 +579,27 @@ Tree<T>::size() const
 {
   return _node_count;
 }
+
+/*
+ * Send from the top node of the scheduler, a Tree or an ExtensiblePriority::Scheduler, until budget bytes are sent, no
+ * node is active or send returns false. send(node, len) sets len to the bytes it sent and accounts for them with
+ * update() or deactivate() of the scheduler, so the next top node is picked by the weights. Returns the bytes sent.
+ */
+template <typename Scheduler, typename Send>
+uint32_t
+pass(Scheduler &scheduler, uint32_t budget, Send &&send)
+{
+  uint32_t sent = 0;
+
+  for (auto node = scheduler.top(); sent < budget && node != nullptr; node = scheduler.top()) {
+    uint32_t len  = 0;
+    bool     more = send(node, len);
+    sent         += len;
+    if (!more) {
+      break;
+    }
+  }
+
+  return sent;
+}
 } // namespace Http2DependencyTree
@@ -27,6 +27,7 @@
 
 #include "proxy/http2/HTTP2.h"
 #include "proxy/ProxyTransaction.h"
+#include "proxy/ExtensiblePriority.h"
 #include "proxy/http2/Http2DebugNames.h"
 #include "proxy/http2/Http2DependencyTree.h"
 #include "tscore/History.h"
@@ -187,6 +188,7 @@ public:
   HTTPHdr                    _send_header;
   IOBufferReader            *_send_reader  = nullptr;
   Http2DependencyTree::Node *priority_node = nullptr;
+  ExtensiblePriority::Node  *urgency_node  = nullptr;
 
   Http2ConnectionState &get_connection_state();
 
@@ -0,0 +1,185 @@
+/** @file
+
+  Http2StreamTable, the active streams of a connection by stream id.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "tscore/ink_assert.h"
+
+#include "proxy/http2/HTTP2.h"
+
+/** Map from stream id to stream, for finding the stream of every received frame.
+ *
+ * Open addressing with linear probing. A slot holds the id next to the pointer, so a lookup does not
+ * touch the streams it passes over. The ids of a connection go up by two, Fibonacci hashing spreads
+ * them over the table. Erasing shifts the following entries back instead of leaving tombstones, so
+ * probe lengths do not grow as streams come and go. The table is kept at most half full and never
+ * shrinks, except that @c clear releases it altogether.
+ *
+ * Id 0 is the connection itself and marks an empty slot.
+ */
+template <typename T> class Http2StreamTable
+{
+public:
+  T       *find(Http2StreamId id) const;
+  void     insert(Http2StreamId id, T *stream);
+  bool     erase(Http2StreamId id);
+  void     clear();
+  uint32_t size() const;
+
+private:
+  struct Slot {
+    Http2StreamId id     = HTTP2_CONNECTION_CONTROL_STREAM;
+    T            *stream = nullptr;
+  };
+
+  static constexpr unsigned MIN_BITS = 4;
+
+  uint32_t _home(Http2StreamId id) const;
+  uint32_t _mask() const;
+  void     _grow();
+
+  std::unique_ptr<Slot[]> _slots;
+  unsigned                _bits  = 0;
+  uint32_t                _count = 0;
+};
+
+template <typename T>
+inline uint32_t
+Http2StreamTable<T>::_home(Http2StreamId id) const
+{
+  return (id * 0x9e3779b1u) >> (32 - _bits);
+}
+
+template <typename T>
+inline uint32_t
+Http2StreamTable<T>::_mask() const
+{
+  return (1u << _bits) - 1;
+}
+
+template <typename T>
+inline uint32_t
+Http2StreamTable<T>::size() const
+{
+  return _count;
+}
+
+template <typename T>
+inline T *
+Http2StreamTable<T>::find(Http2StreamId id) const
+{
+  if (_count == 0 || id == HTTP2_CONNECTION_CONTROL_STREAM) {
+    return nullptr;
+  }
+  for (uint32_t i = _home(id);; i = (i + 1) & _mask()) {
+    Slot const &slot = _slots[i];
+    if (slot.id == id) {
+      return slot.stream;
+    }
+    if (slot.id == HTTP2_CONNECTION_CONTROL_STREAM) {
+      return nullptr;
+    }
+  }
+}
+
+template <typename T>
+void
+Http2StreamTable<T>::insert(Http2StreamId id, T *stream)
+{
+  ink_assert(id != HTTP2_CONNECTION_CONTROL_STREAM);
+
+  if ((_count + 1) * 2 > (1u << _bits)) {
+    _grow();
+  }
+  uint32_t i = _home(id);
+  while (_slots[i].id != HTTP2_CONNECTION_CONTROL_STREAM) {
+    ink_assert(_slots[i].id != id);
+    i = (i + 1) & _mask();
+  }
+  _slots[i].id     = id;
+  _slots[i].stream = stream;
+  ++_count;
+}
+
+template <typename T>
+bool
+Http2StreamTable<T>::erase(Http2StreamId id)
+{
+  if (_count == 0 || id == HTTP2_CONNECTION_CONTROL_STREAM) {
+    return false;
+  }
+  uint32_t i = _home(id);
+  while (_slots[i].id != id) {
+    if (_slots[i].id == HTTP2_CONNECTION_CONTROL_STREAM) {
+      return false;
+    }
+    i = (i + 1) & _mask();
+  }
+
+  // Move back every following entry that may sit in the hole, i.e. whose home is not between the hole and it.
+  for (uint32_t j = (i + 1) & _mask(); _slots[j].id != HTTP2_CONNECTION_CONTROL_STREAM; j = (j + 1) & _mask()) {
+    if (((j - _home(_slots[j].id)) & _mask()) >= ((j - i) & _mask())) {
+      _slots[i] = _slots[j];
+      i         = j;
+    }
+  }
+  _slots[i] = Slot{};
+  --_count;
+  return true;
+}
+
+/** Forget every stream and release the table.
+ *
+ * The owner of a table may come from a ClassAllocator, which does not run destructors, so this must be called
+ * when the owner is destroyed.
+ */
+template <typename T>
+void
+Http2StreamTable<T>::clear()
+{
+  _slots.reset();
+  _bits  = 0;
+  _count = 0;
+}
+
+template <typename T>
+void
+Http2StreamTable<T>::_grow()
+{
+  std::unique_ptr<Slot[]> old      = std::move(_slots);
+  uint32_t                old_size = _bits ? 1u << _bits : 0;
+
+  _bits  = _bits ? _bits + 1 : MIN_BITS;
+  _slots = std::make_unique<Slot[]>(1u << _bits);
+  for (uint32_t i = 0; i < old_size; ++i) {
+    if (old[i].id != HTTP2_CONNECTION_CONTROL_STREAM) {
+      uint32_t j = _home(old[i].id);
+      while (_slots[j].id != HTTP2_CONNECTION_CONTROL_STREAM) {
+        j = (j + 1) & _mask();
+      }
+      _slots[j] = old[i];
+    }
+  }
+}
@@ -39,6 +39,7 @@
 #include "proxy/http3/QPACK.h"
 
 class Http3Session;
+class Http3PriorityUpdateHandler;
 
 /**
  * @brief A HTTP/3 application
@@ -84,9 +85,10 @@ private:
   QUICStreamVCAdapter::IOInfo &_get_stream_info(QUICStreamId stream_id);
   void                         _update_vio_cont_to_QPACK(QPACK *qpack, QUICStreamVCAdapter *adapter);
 
-  Http3FrameHandler   *_protocol_enforcer = nullptr;
-  Http3FrameHandler   *_settings_handler  = nullptr;
-  Http3FrameGenerator *_settings_framer   = nullptr;
+  Http3FrameHandler          *_protocol_enforcer       = nullptr;
+  Http3FrameHandler          *_settings_handler        = nullptr;
+  Http3PriorityUpdateHandler *_priority_update_handler = nullptr;
+  Http3FrameGenerator        *_settings_framer         = nullptr;
 
   Http3FrameDispatcher _control_stream_dispatcher;
   Http3FrameCollector  _control_stream_collector;
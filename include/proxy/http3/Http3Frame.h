@@ -29,6 +29,9 @@
 #include "iocore/net/quic/QUICApplication.h"
 #include "proxy/http3/Http3Types.h"
 
+#include <string>
+#include <string_view>
+
 class Http3Frame
 {
 public:
@@ -164,6 +167,32 @@ private:
   const char                         *_error_reason = nullptr;
 };
 
+//
+// PRIORITY_UPDATE Frame
+//
+
+class Http3PriorityUpdateFrame : public Http3Frame
+{
+public:
+  Http3PriorityUpdateFrame() : Http3Frame(Http3FrameType::PRIORITY_UPDATE) {}
+  Http3PriorityUpdateFrame(IOBufferReader &reader);
+
+  void reset(IOBufferReader &reader) override;
+
+  /// The id of the request stream the frame reprioritizes.
+  uint64_t prioritized_element_id() const;
+
+  /// The new priority, formatted as the value of the Priority header field.
+  std::string_view priority_field_value() const;
+
+protected:
+  bool _parse() override;
+
+private:
+  uint64_t    _prioritized_element_id = 0;
+  std::string _priority_field_value;
+};
+
 using Http3FrameDeleterFunc  = void (*)(Http3Frame *p);
 using Http3FrameUPtr         = std::unique_ptr<Http3Frame, Http3FrameDeleterFunc>;
 using Http3DataFrameUPtr     = std::unique_ptr<Http3DataFrame, Http3FrameDeleterFunc>;
@@ -175,10 +204,11 @@ using Http3FrameUPtr        = std::unique_ptr<Http3Frame, Http3FrameDeleterFunc>
 using Http3DataFrameUPtr    = std::unique_ptr<Http3DataFrame, Http3FrameDeleterFunc>;
 using Http3HeadersFrameUPtr = std::unique_ptr<Http3HeadersFrame, Http3FrameDeleterFunc>;
 
-extern ClassAllocator<Http3Frame>         http3FrameAllocator;
-extern ClassAllocator<Http3DataFrame>     http3DataFrameAllocator;
-extern ClassAllocator<Http3HeadersFrame>  http3HeadersFrameAllocator;
-extern ClassAllocator<Http3SettingsFrame> http3SettingsFrameAllocator;
+extern ClassAllocator<Http3Frame>               http3FrameAllocator;
+extern ClassAllocator<Http3DataFrame>           http3DataFrameAllocator;
+extern ClassAllocator<Http3HeadersFrame>        http3HeadersFrameAllocator;
+extern ClassAllocator<Http3SettingsFrame>       http3SettingsFrameAllocator;
+extern ClassAllocator<Http3PriorityUpdateFrame> http3PriorityUpdateFrameAllocator;
 
 class Http3FrameDeleter
 {
@@ -216,6 +246,13 @@ public:
     frame->~Http3Frame();
     http3SettingsFrameAllocator.free(static_cast<Http3SettingsFrame *>(frame));
   }
+
+  static void
+  delete_priority_update_frame(Http3Frame *frame)
+  {
+    frame->~Http3Frame();
+    http3PriorityUpdateFrameAllocator.free(static_cast<Http3PriorityUpdateFrame *>(frame));
+  }
 };
 
 //
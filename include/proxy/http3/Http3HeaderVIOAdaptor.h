@@ -26,6 +26,7 @@
 #include "proxy/http3/QPACK.h"
 #include "proxy/hdrs/VersionConverter.h"
 #include "proxy/http3/Http3FrameHandler.h"
+#include "proxy/ExtensiblePriority.h"
 
 class Http3HeaderVIOAdaptor : public Continuation, public Http3FrameHandler
 {
@@ -40,14 +41,18 @@ public:
   bool is_complete();
   int  event_handler(int event, Event *data);
 
+  /// The priority asked for by the Priority field of a request, valid once the header is complete.
+  const ExtensiblePriority::Priority &get_priority() const;
+
 private:
   VIO     *_sink_vio    = nullptr;
   QPACK   *_qpack       = nullptr;
   uint64_t _stream_id   = 0;
   bool     _is_complete = false;
 
-  HTTPHdr          _header; ///< HTTP header buffer for decoding
-  VersionConverter _hvc;
+  HTTPHdr                      _header; ///< HTTP header buffer for decoding
+  VersionConverter             _hvc;
+  ExtensiblePriority::Priority _priority;
 
   int _on_qpack_decode_complete();
 };
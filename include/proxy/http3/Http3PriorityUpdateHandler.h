@@ -0,0 +1,59 @@
+/** @file
+ *
+ *  PRIORITY_UPDATE Frame Handler for Http3
+ *
+ *  @section license License
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include "iocore/net/quic/QUICStream.h"
+#include "proxy/ExtensiblePriority.h"
+#include "proxy/http3/Http3FrameHandler.h"
+
+#include <functional>
+
+/**
+ * Reprioritizes request streams by the PRIORITY_UPDATE frames received on the control stream ([RFC 9218] 7.2).
+ *
+ * An update for a stream that has not opened yet is kept until it opens, for up to as many streams as the client may
+ * open at once, and takes precedence over the Priority header field of the request.
+ */
+class Http3PriorityUpdateHandler : public Http3FrameHandler
+{
+public:
+  /// Returns the open request stream of an id, or @c nullptr.
+  using StreamLookup = std::function<QUICStream *(QUICStreamId)>;
+
+  Http3PriorityUpdateHandler(StreamLookup find_stream, size_t max_pending)
+    : _find_stream(std::move(find_stream)), _max_pending(max_pending){};
+
+  // Http3FrameHandler
+  std::vector<Http3FrameType> interests() override;
+  Http3ErrorUPtr handle_frame(std::shared_ptr<const Http3Frame> frame, Http3StreamType s_type = Http3StreamType::UNKNOWN) override;
+
+  /// Give the request @a stream, which has just opened, the priority of an update received before.
+  void on_stream_open(QUICStream &stream);
+
+private:
+  StreamLookup                       _find_stream;
+  size_t                             _max_pending = 0;
+  ExtensiblePriority::PendingUpdates _pending;
+  int64_t                            _latest_stream_id = -1; ///< Of the request streams opened so far.
+};
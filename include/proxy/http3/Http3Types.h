@@ -63,8 +63,14 @@ enum class Http3FrameType : uint64_t {
   MAX_PUSH_ID   = 0x0D,
   X_MAX_DEFINED = 0x0D,
   UNKNOWN       = 0x0E,
+
+  // [RFC 9218] 7.2. PRIORITY_UPDATE for a request stream. Its type code is far above the others, a frame read
+  // with HTTP3_PRIORITY_UPDATE_FRAME_TYPE has this type instead. Only ever received, never sent.
+  PRIORITY_UPDATE = 0x0F,
 };
 
+constexpr uint64_t HTTP3_PRIORITY_UPDATE_FRAME_TYPE = 0xF0700;
+
 enum class Http3ErrorClass {
   UNDEFINED,
   CONNECTION,
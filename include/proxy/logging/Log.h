@@ -92,6 +92,7 @@ public:
       break;
     case LOG_FILE_ASCII:
     case LOG_FILE_PIPE:
+    case LOG_FILE_COLUMNAR:
       ats_free(m_data);
       break;
     case N_LOGFILE_TYPES:
@@ -0,0 +1,101 @@
+/** @file
+
+  Columnar, block compressed encoding of LogBuffers.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct LogBufferHeader;
+class LogFieldList;
+
+/** The columnar log file format.
+
+    A columnar log file is a sequence of blocks, one for each LogBuffer. A block starts with a
+    @c BlockHeader, followed by the schema and the payload.
+
+    The schema is the LogBufferHeader of the buffer with its strings (format name, field list,
+    printf string, host and file name), exactly as they are in the buffer. It is not compressed so
+    that the tools can read it without decoding the payload.
+
+    The payload holds the entries, split into one column per field of the format:
+
+    - the timestamp of each entry, as a zigzag varint delta from the previous entry, and the
+      microseconds as a varint.
+    - for each entry the varint length of each column.
+    - the data of the first column for all of the entries, then the second column, and so on.
+
+    The columns of similar values compress much better than whole entries do. The payload is
+    compressed with zstd if it is available and it helps, otherwise it is stored as is.
+
+    Decoding restores the original LogBuffer byte for byte, so everything that reads binary log
+    buffers can read the decoded block.
+*/
+namespace LogColumnar
+{
+static constexpr uint32_t COOKIE  = 0xc01face;
+static constexpr uint32_t VERSION = 1;
+
+enum Codec : uint32_t {
+  CODEC_NONE = 0,
+  CODEC_ZSTD,
+};
+
+struct BlockHeader {
+  uint32_t cookie;       ///< @c COOKIE, so the block can be found on disk.
+  uint32_t version;      ///< @c VERSION
+  uint32_t codec;        ///< How the payload is stored.
+  uint32_t schema_bytes; ///< Size of the schema, the LogBufferHeader with its strings.
+  uint32_t raw_bytes;    ///< Size of the payload before compression.
+  uint32_t stored_bytes; ///< Size of the payload in the block.
+  uint32_t entry_count;  ///< Number of entries in the block.
+  uint32_t column_count; ///< Number of columns each entry is split into.
+};
+
+/** Encode a LogBuffer as a block.
+
+    @param header The buffer to encode.
+    @param fields The fields the buffer was marshaled with, or @c nullptr to store each entry as one
+    column.
+    @param len Set to the size of the block.
+    @return The block, which must be freed with @c ats_free, or @c nullptr if the buffer is invalid.
+*/
+char *encode(LogBufferHeader *header, LogFieldList *fields, int *len);
+
+/** Decode a block back into the LogBuffer it was encoded from.
+
+    @param block The block header.
+    @param body The schema and payload following @a block, @c schema_bytes + @c stored_bytes long.
+    @param buffer Set to the LogBuffer, starting with its LogBufferHeader.
+    @return @c true if the block was decoded, @c false if it is corrupt.
+*/
+bool decode(const BlockHeader &block, const char *body, std::vector<char> &buffer);
+
+/// @return The size of the block body following @a block.
+inline uint64_t
+body_bytes(const BlockHeader &block)
+{
+  return static_cast<uint64_t>(block.schema_bytes) + block.stored_bytes;
+}
+
+} // namespace LogColumnar
@@ -45,9 +45,10 @@
   consist of a list of LogObjects.
   -------------------------------------------------------------------------*/
 
-#define LOG_FILE_ASCII_OBJECT_FILENAME_EXTENSION  ".log"
-#define LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION ".blog"
-#define LOG_FILE_PIPE_OBJECT_FILENAME_EXTENSION   ".pipe"
+#define LOG_FILE_ASCII_OBJECT_FILENAME_EXTENSION    ".log"
+#define LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION   ".blog"
+#define LOG_FILE_PIPE_OBJECT_FILENAME_EXTENSION     ".pipe"
+#define LOG_FILE_COLUMNAR_OBJECT_FILENAME_EXTENSION ".clog"
 
 #define FLUSH_ARRAY_SIZE (512 * 4)
 
@@ -88,10 +89,12 @@ public:
     BINARY                   = 1,
     WRITES_TO_PIPE           = 4,
     LOG_OBJECT_FMT_TIMESTAMP = 8, // always format a timestamp into each log line (for raw text logs)
+    COLUMNAR                 = 16,
   };
 
   // BINARY: log is written in binary format (rather than ascii)
   // WRITES_TO_PIPE: object writes to a named pipe rather than to a file
+  // COLUMNAR: log is written in the columnar binary format
 
   LogObject(LogConfig *cfg, const LogFormat *format, const char *log_dir, const char *basename, LogFileFormat file_format,
             const char *header, Log::RollingEnabledValues rolling_enabled, int flush_threads, int rolling_interval_sec = 0,
@@ -239,7 +242,12 @@ public:
     _checkout_write(nullptr, 0);
   }
 
-  void flush_buffer(LogBuffer *);
+  /** Hand a batch of full thread local buffers to a preproc thread.
+   *
+   * @param buffers The buffers, which are removed from the list in order.
+   * @param preproc_idx Selects the preproc thread, the buffers of a thread always use the same one.
+   */
+  void flush_buffers(LogBufferList &buffers, unsigned preproc_idx);
 
   bool operator==(LogObject &rhs);
 
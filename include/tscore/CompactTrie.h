@@ -0,0 +1,283 @@
+/** @file
+
+    A read only prefix trie stored in contiguous arrays.
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "tscore/ink_assert.h"
+#include "tscore/Diags.h"
+
+class CompactTrieImpl
+{
+protected:
+  inline static DbgCtl dbg_ctl_freeze{"CompactTrie::Freeze"};
+};
+
+/** A prefix trie with the same search semantics as @c Trie, built once and then only searched.
+
+    Keys are collected by @c Insert and compiled by @c Freeze into a radix tree, where each node holds
+    the run of characters leading to it. The nodes are stored breadth first in one array, so the
+    children of a node are adjacent and sorted, and the node labels are packed into one string.
+    Every node caches the lowest ranked value on the path to it, so a search is a single walk down
+    the tree.
+
+    The trie owns the values and deletes them on @c Clear.
+*/
+template <typename T> class CompactTrie : private CompactTrieImpl
+{
+public:
+  CompactTrie() = default;
+  ~CompactTrie() { Clear(); }
+
+  CompactTrie(const CompactTrie &)            = delete;
+  CompactTrie &operator=(const CompactTrie &) = delete;
+
+  // will return false for duplicates or after Freeze; key should be nullptr-terminated
+  // if key_len is defaulted to -1
+  bool Insert(const char *key, T *value, int rank, int key_len = -1);
+
+  // compile the inserted keys, must be called before Search
+  void Freeze();
+
+  // will return the lowest ranked value whose key is a prefix of key, or nullptr
+  T   *Search(const char *key, int key_len = -1) const;
+  void Clear();
+  void Print() const;
+
+  bool
+  Empty() const
+  {
+    return _values.empty();
+  }
+
+  bool
+  Frozen() const
+  {
+    return !_nodes.empty();
+  }
+
+  /// @return The number of nodes in the compiled tree.
+  size_t
+  NodeCount() const
+  {
+    return _nodes.size();
+  }
+
+  /// Iterate over the values in insertion order.
+  using const_iterator = typename std::vector<T *>::const_iterator;
+  const_iterator
+  begin() const
+  {
+    return _values.begin();
+  }
+  const_iterator
+  end() const
+  {
+    return _values.end();
+  }
+
+private:
+  struct Node {
+    uint32_t      label       = 0;  ///< Offset of the characters leading to this node in @c _labels.
+    uint32_t      label_len   = 0;  ///< Number of characters leading to this node.
+    uint32_t      first_child = 0;  ///< Index of the first child in @c _nodes.
+    uint32_t      n_children  = 0;  ///< Number of children.
+    int32_t       best        = -1; ///< Index in @c _values of the lowest ranked value on the path here.
+    unsigned char first       = 0;  ///< First character of the label, to select a child.
+  };
+
+  std::vector<Node>                         _nodes;
+  std::string                               _labels;
+  std::vector<T *>                          _values;
+  std::vector<int>                          _ranks;
+  std::unordered_map<std::string, uint32_t> _pending; ///< Inserted keys until Freeze.
+
+  static void
+  _CheckArgs(const char *key, int &key_len)
+  {
+    if (!key) {
+      key_len = 0;
+    } else if (key_len == -1) {
+      key_len = strlen(key);
+    }
+  }
+};
+
+template <typename T>
+bool
+CompactTrie<T>::Insert(const char *key, T *value, int rank, int key_len /* = -1 */)
+{
+  _CheckArgs(key, key_len);
+
+  if (Frozen()) {
+    ink_assert(!"insert into a frozen trie");
+    return false;
+  }
+  if (!_pending.emplace(std::string(key, key_len), static_cast<uint32_t>(_values.size())).second) {
+    return false;
+  }
+  _values.push_back(value);
+  _ranks.push_back(rank);
+  return true;
+}
+
+template <typename T>
+void
+CompactTrie<T>::Freeze()
+{
+  if (Frozen()) {
+    return;
+  }
+
+  std::vector<std::pair<std::string, uint32_t>> keys;
+  keys.reserve(_pending.size());
+  for (auto const &[key, value] : _pending) {
+    keys.emplace_back(key, value);
+  }
+  decltype(_pending)().swap(_pending);
+  std::sort(keys.begin(), keys.end());
+
+  // A node covers a range of the sorted keys that share the path to it. The first key in the range
+  // ends at the node if it is no longer than the path, the others are split by their next character.
+  struct Range {
+    uint32_t node;
+    size_t   lo;
+    size_t   hi;
+    size_t   depth;
+    int32_t  best;
+  };
+  std::deque<Range> queue;
+
+  _nodes.emplace_back();
+  queue.push_back({0, 0, keys.size(), 0, -1});
+  while (!queue.empty()) {
+    Range r = queue.front();
+    queue.pop_front();
+
+    int32_t best = r.best;
+    if (r.lo < r.hi && keys[r.lo].first.size() == r.depth) {
+      int32_t own = keys[r.lo].second;
+      // the deeper value wins a tie, as in Trie
+      if (best < 0 || _ranks[own] <= _ranks[best]) {
+        best = own;
+      }
+      ++r.lo;
+    }
+    _nodes[r.node].best        = best;
+    _nodes[r.node].first_child = _nodes.size();
+
+    for (size_t lo = r.lo; lo < r.hi;) {
+      unsigned char c  = keys[lo].first[r.depth];
+      size_t        hi = lo + 1;
+      while (hi < r.hi && static_cast<unsigned char>(keys[hi].first[r.depth]) == c) {
+        ++hi;
+      }
+      // the keys are sorted, so the prefix shared by the group is the one shared by its ends
+      std::string const &low  = keys[lo].first;
+      std::string const &high = keys[hi - 1].first;
+      size_t             end  = r.depth + 1;
+      while (end < low.size() && end < high.size() && low[end] == high[end]) {
+        ++end;
+      }
+
+      Node child;
+      child.label     = _labels.size();
+      child.label_len = end - r.depth;
+      child.first     = c;
+      _labels.append(low, r.depth, end - r.depth);
+      queue.push_back({static_cast<uint32_t>(_nodes.size()), lo, hi, end, best});
+      _nodes.push_back(child);
+      ++_nodes[r.node].n_children;
+      lo = hi;
+    }
+  }
+
+  _nodes.shrink_to_fit();
+  _labels.shrink_to_fit();
+  Dbg(dbg_ctl_freeze, "compiled %zu keys into %zu nodes, %zu label bytes", keys.size(), _nodes.size(), _labels.size());
+}
+
+template <typename T>
+T *
+CompactTrie<T>::Search(const char *key, int key_len /* = -1 */) const
+{
+  _CheckArgs(key, key_len);
+  ink_assert(Frozen());
+  if (!Frozen()) {
+    return nullptr;
+  }
+
+  Node const *node = &_nodes[0];
+  int32_t     best = node->best;
+  int         i    = 0;
+
+  while (i < key_len && node->n_children > 0) {
+    unsigned char c     = key[i];
+    Node const   *first = &_nodes[node->first_child];
+    Node const   *last  = first + node->n_children;
+    Node const   *child = std::lower_bound(first, last, c, [](Node const &n, unsigned char v) { return n.first < v; });
+
+    if (child == last || child->first != c || static_cast<uint32_t>(key_len - i) < child->label_len ||
+        memcmp(key + i, _labels.data() + child->label, child->label_len) != 0) {
+      break;
+    }
+    i    += child->label_len;
+    node  = child;
+    best  = node->best;
+  }
+
+  return best < 0 ? nullptr : _values[best];
+}
+
+template <typename T>
+void
+CompactTrie<T>::Clear()
+{
+  for (T *value : _values) {
+    delete value;
+  }
+  _values.clear();
+  _ranks.clear();
+  _pending.clear();
+  _nodes.clear();
+  _labels.clear();
+}
+
+template <typename T>
+void
+CompactTrie<T>::Print() const
+{
+  // The class we contain must provide a ::Print() method.
+  for (T *value : _values) {
+    value->Print();
+  }
+}
@@ -0,0 +1,74 @@
+/** @file
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/ConsistentHash.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/*
+  Position of a lookup in an ATSMaglevHash table, kept by the caller so that
+  the hosts after the selected one can be tried when it fails.
+ */
+
+struct ATSMaglevHashIter {
+  uint32_t slot{0};
+  uint32_t stride{1};
+  uint32_t steps{0};
+};
+
+/*
+  Maglev consistent hash (Eisenbud et al., NSDI 2016).
+
+  Every node fills the slots of a fixed size table in the order of its own
+  permutation of the slots, taking turns in proportion to its weight, until the
+  table is full. A lookup is a single table access. The alternates for a key are
+  found by stepping through the table from its slot with a stride taken from the
+  key, which spreads the keys of a failed node evenly over the others and leaves
+  the keys of the other nodes in place.
+
+  The table size does not depend on the number of nodes unless there are more
+  than min_size / 100 of them, so that adding or removing a node moves few of
+  the keys of the others. Nodes are added with insert() and the table is filled
+  by build(), after which it is read only. Caller is responsible for freeing
+  node memory.
+ */
+
+struct ATSMaglevHash {
+  ATSMaglevHash(uint32_t min_size = 16381);
+  void                   insert(ATSConsistentHashNode *node, float weight = 1.0);
+  void                   build(ATSHash64 *h);
+  ATSConsistentHashNode *lookup_by_hashval(uint64_t hashval, ATSMaglevHashIter *i, bool *w) const;
+  ATSConsistentHashNode *lookup_next(ATSMaglevHashIter *i, bool *w) const;
+
+  uint32_t
+  table_size() const
+  {
+    return table.size();
+  }
+
+private:
+  uint32_t                                               min_size;
+  std::vector<std::pair<ATSConsistentHashNode *, float>> nodes;
+  std::vector<uint32_t>                                  table; // index into nodes for each slot
+};
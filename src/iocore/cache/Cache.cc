@@ -58,6 +58,7 @@ int64_t cache_config_ram_cache_size                = AUTO_SIZE_RAM_CACHE;
 int     cache_config_ram_cache_algorithm           = 1;
 int     cache_config_ram_cache_compress            = 0;
 int     cache_config_ram_cache_compress_percent    = 90;
+int64_t cache_config_ram_cache_compress_budget     = 0;
 int     cache_config_ram_cache_use_seen_filter     = 1;
 int     cache_config_http_max_alts                 = 3;
 int     cache_config_log_alternate_eviction        = 0;
@@ -112,9 +113,10 @@ DbgCtl dbg_ctl_cache_update{"cache_update"};
 } // end anonymous namespace
 
 // Global list of the volumes created
-Queue<CacheVol> cp_list;
-int             cp_list_len = 0;
-ConfigVolumes   config_volumes;
+Queue<CacheVol>   cp_list;
+int               cp_list_len = 0;
+std::atomic<bool> cp_list_open{false}; // cp_list is final, set when the cache opens its stripes.
+ConfigVolumes     config_volumes;
 
 #if TS_HAS_TESTS
 void
@@ -260,10 +262,12 @@ Cache::open(bool clear, bool /* fix ATS_UNUSED */)
   RecEstablishStaticConfigInt32(cache_config_min_average_object_size, "proxy.config.cache.min_average_object_size");
   Dbg(dbg_ctl_cache_init, "Cache::open - proxy.config.cache.min_average_object_size = %d", cache_config_min_average_object_size);
 
+  cp_list_open.store(true, std::memory_order_release);
+
   CacheVol *cp = cp_list.head;
   for (; cp; cp = cp->link.next) {
     if (cp->scheme == scheme) {
-      cp->stripes = static_cast<StripeSM **>(ats_malloc(cp->num_vols * sizeof(StripeSM *)));
+      cp->stripes = static_cast<StripeSM **>(ats_calloc(cp->num_vols, sizeof(StripeSM *)));
       int vol_no  = 0;
       for (i = 0; i < gndisks; i++) {
         if (cp->disk_stripes[i] && !DISK_BAD(cp->disk_stripes[i]->disk)) {
@@ -274,6 +278,7 @@ Cache::open(bool clear, bool /* fix ATS_UNUSED */)
             cp->stripes[vol_no]            = new StripeSM(d, blocks, q->b->offset, cp->avg_obj_size, cp->fragment_size);
             cp->stripes[vol_no]->cache     = this;
             cp->stripes[vol_no]->cache_vol = cp;
+            cp->stripes_open.store(vol_no + 1, std::memory_order_release);
 
             bool vol_clear = clear || d->cleared || q->new_block;
             cp->stripes[vol_no]->init(vol_clear);
@@ -805,6 +810,7 @@ ink_cache_init(ts::ModuleVersion v)
   RecEstablishStaticConfigInt32(cache_config_ram_cache_algorithm, "proxy.config.cache.ram_cache.algorithm");
   RecEstablishStaticConfigInt32(cache_config_ram_cache_compress, "proxy.config.cache.ram_cache.compress");
   RecEstablishStaticConfigInt32(cache_config_ram_cache_compress_percent, "proxy.config.cache.ram_cache.compress_percent");
+  RecEstablishStaticConfigInt(cache_config_ram_cache_compress_budget, "proxy.config.cache.ram_cache.compress_budget");
   cache_config_ram_cache_use_seen_filter = RecGetRecordInt("proxy.config.cache.ram_cache.use_seen_filter").value_or(0);
 
   RecEstablishStaticConfigInt32(cache_config_http_max_alts, "proxy.config.cache.limits.http.max_alts");
@@ -311,9 +311,9 @@ unlink_from_freelist(Dir *e, int s, Stripe *stripe)
 inline Dir *
 dir_delete_entry(Dir *e, Dir *p, int s, Stripe *stripe)
 {
-  Dir *seg                        = stripe->directory.get_segment(s);
-  int  no                         = dir_next(e);
-  stripe->directory.header->dirty = 1;
+  Dir *seg = stripe->directory.get_segment(s);
+  int  no  = dir_next(e);
+  stripe->directory.mark_dirty(s);
   if (p) {
     unsigned int fo = stripe->directory.header->freelist[s];
     unsigned int eo = dir_to_offset(e, seg);
@@ -390,12 +390,17 @@ dir_clean_vol(Stripe *stripe)
   CHECK_DIR(d);
 }
 
+// delete the entries pointing into [start, end), a range with start past end
+// wraps around the end of the stripe and is cleared in the same pass
 void
 dir_clear_range(off_t start, off_t end, Stripe *stripe)
 {
+  bool wrapped = start > end;
   for (off_t i = 0; i < stripe->directory.entries(); i++) {
-    Dir *e = dir_index(stripe, i);
-    if (dir_offset(e) >= static_cast<int64_t>(start) && dir_offset(e) < static_cast<int64_t>(end)) {
+    Dir    *e = dir_index(stripe, i);
+    int64_t o = dir_offset(e);
+    if (wrapped ? (o >= static_cast<int64_t>(start) || (o >= 1 && o < static_cast<int64_t>(end)))
+                : (o >= static_cast<int64_t>(start) && o < static_cast<int64_t>(end))) {
       ts::Metrics::Gauge::decrement(cache_rsb.direntries_used);
       ts::Metrics::Gauge::decrement(stripe->cache_vol->vol_rsb.direntries_used);
       dir_set_offset(e, 0); // delete
@@ -474,6 +479,7 @@ dir_free_entry(Dir *e, int s, Stripe *stripe)
     dir_set_prev(dir_from_offset(fo, seg), eo);
   }
   stripe->directory.header->freelist[s] = eo;
+  stripe->directory.mark_dirty(s);
 }
 
 int
@@ -484,16 +490,21 @@ dir_probe(const CacheKey *key, StripeSM *stripe, Dir *result, Dir **last_collisi
   int  b   = key->slice32(1) % stripe->directory.buckets;
   Dir *seg = stripe->directory.get_segment(s);
   Dir *e = nullptr, *p = nullptr, *collision = *last_collision;
+  Dir *bucket = dir_bucket(b, seg);
   CHECK_DIR(d);
 #ifdef LOOP_CHECK_MODE
   if (dir_bucket_loop_fix(dir_bucket(b, seg), s, vol))
     return 0;
 #endif
 Lagain:
-  e = dir_bucket(b, seg);
+  e = bucket;
   if (dir_offset(e)) {
+    // The rows of the bucket are matched together, only entries chained in from the freelist are compared one by one.
+    uint32_t tag   = DIR_MASK_TAG(key->slice32(2));
+    unsigned match = dir_bucket_tag_match(bucket, tag);
     do {
-      if (dir_compare_tag(e, key)) {
+      size_t row = e - bucket;
+      if (row < DIR_DEPTH ? (match >> row) & 1 : dir_compare_tag(e, key)) {
         ink_assert(dir_offset(e));
         // Bug: 51680. Need to check collision before checking
         // dir_valid(). In case of a collision, if !dir_valid(), we
@@ -522,7 +533,8 @@ Lagain:
         } else { // delete the invalid entry
           ts::Metrics::Gauge::decrement(cache_rsb.direntries_used);
           ts::Metrics::Gauge::decrement(stripe->cache_vol->vol_rsb.direntries_used);
-          e = dir_delete_entry(e, p, s, stripe);
+          e     = dir_delete_entry(e, p, s, stripe);
+          match = dir_bucket_tag_match(bucket, tag);
           continue;
         }
       } else {
@@ -606,7 +618,7 @@ Lfill:
   DDbg(dbg_ctl_dir_insert, "insert %p %X into vol %d bucket %d at %p tag %X %X boffset %" PRId64 "", e, key->slice32(0), stripe->fd,
        bi, e, key->slice32(1), dir_tag(e), dir_offset(e));
   CHECK_DIR(d);
-  stripe->directory.header->dirty = 1;
+  stripe->directory.mark_dirty(s);
   ts::Metrics::Gauge::increment(cache_rsb.direntries_used);
   ts::Metrics::Gauge::increment(stripe->cache_vol->vol_rsb.direntries_used);
 
@@ -697,7 +709,7 @@ Lfill:
   DDbg(dbg_ctl_dir_overwrite, "overwrite %p %X into vol %d bucket %d at %p tag %X %X boffset %" PRId64 "", e, key->slice32(0),
        stripe->fd, bi, e, t, dir_tag(e), dir_offset(e));
   CHECK_DIR(d);
-  stripe->directory.header->dirty = 1;
+  stripe->directory.mark_dirty(s);
   return res;
 }
 
@@ -952,8 +964,10 @@ Lrestart:
     // AIO Thread
     if (!io.ok()) {
       Warning("vol write error during directory sync '%s'", gstripes[stripe_index]->hash_text.get());
-      event = EVENT_NONE;
-      goto Ldone;
+      // The dirty segments are reset under the stripe lock, which this thread does not hold.
+      write_failed = true;
+      trigger      = eventProcessor.schedule_imm(this);
+      return EVENT_CONT;
     }
     ts::Metrics::Counter::increment(cache_rsb.directory_sync_bytes, io.aio_result);
     ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.directory_sync_bytes, io.aio_result);
@@ -967,6 +981,13 @@ Lrestart:
       return EVENT_CONT;
     }
 
+    if (write_failed) {
+      // The copy being written is now partial, the next sync to it has to write all of it.
+      stripe->directory.dirty_segments.assign(stripe->directory.segments, Directory::DIRTY_ALL_COPIES);
+      write_failed = false;
+      goto Ldone;
+    }
+
     if (!stripe->dir_sync_in_progress) {
       start_time = ink_get_hrtime();
     }
@@ -985,7 +1006,8 @@ Lrestart:
       /* Don't sync the directory to disk if its not dirty. Syncing the
          clean directory to disk is also the cause of INKqa07151. Increasing
          the serial number causes the cache to recover more data than necessary.
-         The dirty bit it set in dir_insert, dir_overwrite and dir_delete_entry
+         The dirty bit it set by Directory::mark_dirty, along with the dirty bits
+         of the changed segment.
        */
       if (!stripe->directory.header->dirty) {
         Dbg(dbg_ctl_cache_dir_sync, "Dir %s not dirty", stripe->hash_text.get());
@@ -1024,7 +1046,48 @@ Lrestart:
       stripe->directory.header->sync_serial++;
       stripe->directory.footer->sync_serial = stripe->directory.header->sync_serial;
       CHECK_DIR(d);
-      memcpy(buf, stripe->directory.raw_dir, dirlen);
+
+      /* Only the segments changed since the last sync to this copy of the
+         directory are written, the others are already on disk. The header,
+         with the segment freelists, and the footer are always written. A
+         crash mid sync leaves the serial numbers of header and footer
+         different, and recovery falls back to the other copy as before.
+       */
+      int   copy       = stripe->directory.header->sync_serial & 1;
+      off_t seglen     = stripe->directory.buckets * DIR_DEPTH * SIZEOF_DIR;
+      off_t footer_pos = dirlen - headerlen;
+      off_t dir_pos    = stripe->headerlen();
+      ranges.clear();
+      range_index = 0;
+      if (dir_pos > headerlen) {
+        ranges.emplace_back(headerlen, dir_pos);
+      }
+      for (int s = 0; s < stripe->directory.segments; s++) {
+        if (!(stripe->directory.dirty_segments[s] & (1 << copy))) {
+          continue;
+        }
+        stripe->directory.dirty_segments[s] &= ~(1 << copy);
+        // Writes are in whole store blocks, which may take in parts of the neighboring segments.
+        off_t lo = dir_pos + s * seglen;
+        off_t hi = std::min(ROUND_TO_STORE_BLOCK(lo + seglen), footer_pos);
+        lo       = lo - lo % STORE_BLOCK_SIZE;
+        if (!ranges.empty() && lo <= ranges.back().second) {
+          ranges.back().second = std::max(ranges.back().second, hi);
+        } else {
+          ranges.emplace_back(lo, hi);
+        }
+      }
+      memcpy(buf, stripe->directory.raw_dir, headerlen);
+      memcpy(buf + footer_pos, stripe->directory.raw_dir + footer_pos, headerlen);
+      off_t synclen = 2 * headerlen;
+      for (auto const &[lo, hi] : ranges) {
+        memcpy(buf + lo, stripe->directory.raw_dir + lo, hi - lo);
+        synclen += hi - lo;
+      }
+      Dbg(dbg_ctl_cache_dir_sync, "Dir %s: writing %" PRId64 " of %zu bytes to copy %c", stripe->hash_text.get(),
+          static_cast<int64_t>(synclen), dirlen, copy ? 'B' : 'A');
+      ts::Metrics::Counter::increment(cache_rsb.directory_sync_saved, dirlen - synclen);
+      ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.directory_sync_saved, dirlen - synclen);
       stripe->dir_sync_in_progress = true;
     }
     size_t B     = stripe->directory.header->sync_serial & 1;
@@ -1034,17 +1097,22 @@ Lrestart:
       // write header
       aio_write(stripe->fd, buf + writepos, headerlen, start + writepos);
       writepos += headerlen;
-    } else if (writepos < static_cast<off_t>(dirlen) - headerlen) {
-      // write part of body
-      int l = cache_config_dir_sync_max_write;
-      if (writepos + l > static_cast<off_t>(dirlen) - headerlen) {
-        l = dirlen - headerlen - writepos;
+    } else if (range_index < ranges.size()) {
+      // write part of the dirty segments
+      auto const &[lo, hi] = ranges[range_index];
+      writepos             = std::max(writepos, lo);
+      int l                = cache_config_dir_sync_max_write;
+      if (writepos + l > hi) {
+        l = hi - writepos;
       }
       aio_write(stripe->fd, buf + writepos, l, start + writepos);
       writepos += l;
+      if (writepos == hi) {
+        ++range_index;
+      }
     } else if (writepos < static_cast<off_t>(dirlen)) {
-      ink_assert(writepos == (off_t)dirlen - headerlen);
       // write footer
+      writepos = dirlen - headerlen;
       aio_write(stripe->fd, buf + writepos, headerlen, start + writepos);
       writepos += headerlen;
     } else {
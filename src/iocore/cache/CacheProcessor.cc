@@ -49,6 +49,7 @@
 #include "tsutil/Metrics.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cinttypes>
 #include <cstdlib>
 #include <cstring>
@@ -108,9 +109,10 @@ DbgCtl dbg_ctl_ram_cache{"ram_cache"};
 } // end anonymous namespace
 
 // Global list of the volumes created
-extern Queue<CacheVol> cp_list;
-extern int             cp_list_len;
-extern ConfigVolumes   config_volumes;
+extern Queue<CacheVol>   cp_list;
+extern int               cp_list_len;
+extern std::atomic<bool> cp_list_open;
+extern ConfigVolumes     config_volumes;
 
 static const int DEFAULT_CACHE_OPTIONS = (O_RDWR);
 
@@ -685,6 +687,28 @@ CacheProcessor::find_by_path(std::string_view path)
   return nullptr;
 }
 
+std::vector<CacheProcessor::StripeStatus>
+CacheProcessor::stripe_status() const
+{
+  std::vector<StripeStatus> status;
+
+  // This runs on an RPC thread while the stripes are created and recovered. Only the stripes published by Cache::open are
+  // read, their other fields do not change after construction and the recovery state is atomic.
+  if (!cp_list_open.load(std::memory_order_acquire)) {
+    return status;
+  }
+  for (CacheVol *cp = cp_list.head; cp; cp = cp->link.next) {
+    int const n = cp->stripes_open.load(std::memory_order_acquire);
+    for (int i = 0; i < n; i++) {
+      StripeSM const *stripe = cp->stripes[i];
+      status.push_back({stripe->disk->path, stripe->hash_text.get(), stripe->init_state_name(), cp->vol_number,
+                        static_cast<int64_t>(stripe->len), static_cast<int64_t>(stripe->dirlen()), stripe->recovered_bytes});
+    }
+  }
+
+  return status;
+}
+
 bool
 CacheProcessor::has_online_storage() const
 {
@@ -1125,6 +1149,10 @@ register_cache_stats(CacheStatsBlock *rsb, const std::string &prefix)
   rsb->ram_cache_bytes       = ts::Metrics::Gauge::createPtr(prefix + ".ram_cache.bytes_used");
   rsb->ram_cache_hits        = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.hits");
   rsb->ram_cache_misses      = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.misses");
+  rsb->ram_compress_in       = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.compress.bytes_in");
+  rsb->ram_compress_out      = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.compress.bytes_out");
+  rsb->ram_compress_time     = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.compress.time");
+  rsb->ram_decompress_time   = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.decompress.time");
   rsb->pread_count           = ts::Metrics::Counter::createPtr(prefix + ".pread_count");
   rsb->percent_full          = ts::Metrics::Gauge::createPtr(prefix + ".percent_full");
   rsb->read_seek_fail        = ts::Metrics::Counter::createPtr(prefix + ".read.seek.failure");
@@ -1145,6 +1173,7 @@ register_cache_stats(CacheStatsBlock *rsb, const std::string &prefix)
   rsb->directory_sync_count  = ts::Metrics::Counter::createPtr(prefix + ".sync.count");
   rsb->directory_sync_bytes  = ts::Metrics::Counter::createPtr(prefix + ".sync.bytes");
   rsb->directory_sync_time   = ts::Metrics::Counter::createPtr(prefix + ".sync.time");
+  rsb->directory_sync_saved  = ts::Metrics::Counter::createPtr(prefix + ".sync.bytes_saved");
   rsb->span_errors_read      = ts::Metrics::Counter::createPtr(prefix + ".span.errors.read");
   rsb->span_errors_write     = ts::Metrics::Counter::createPtr(prefix + ".span.errors.write");
   rsb->span_failing          = ts::Metrics::Gauge::createPtr(prefix + ".span.failing");
@@ -1435,6 +1464,9 @@ CacheProcessor::cacheInitialized()
         case RAM_CACHE_ALGORITHM_LRU:
           gstripes[i]->ram_cache = new_RamCacheLRU();
           break;
+        case RAM_CACHE_ALGORITHM_TINYLFU:
+          gstripes[i]->ram_cache = new_RamCacheTinyLFU();
+          break;
         }
       }
 
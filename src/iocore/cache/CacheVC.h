@@ -97,6 +97,23 @@ struct CacheVC : public CacheVConnection {
     return -1;
   }
 
+  IOBufferBlock *
+  get_single_data_block() override
+  {
+    // only before the first do_io_read, while buf is the opened fragment and doc_pos its first byte of data
+    if (vio.op != VIO::READ || !buf || !f.single_fragment || write_vc || vio.ndone || seek_to) {
+      return nullptr;
+    }
+    Doc    *doc   = reinterpret_cast<Doc *>(buf->data());
+    int64_t bytes = doc->len - doc_pos;
+    if (doc->magic != DOC_MAGIC || bytes != static_cast<int64_t>(doc_len) || doc->total_len != doc_len) {
+      return nullptr;
+    }
+    IOBufferBlock *b = new_IOBufferBlock(buf, bytes, doc_pos);
+    b->_buf_end      = b->_end;
+    return b;
+  }
+
   int
   get_volume_number() const override
   {
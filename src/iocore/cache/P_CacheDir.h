@@ -31,6 +31,11 @@
 
 #include <cstdint>
 #include <ctime>
+#include <utility>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 class Stripe;
 class StripeSM;
@@ -249,6 +254,12 @@ struct CacheSync : public Continuation {
   int         mainEvent(int event, Event *e);
   void        aio_write(int fd, char *b, int n, off_t o);
 
+  /// Byte ranges of the directory written by the current sync, after the header block and before the footer.
+  std::vector<std::pair<off_t, off_t>> ranges;
+  size_t                               range_index = 0;
+  /// A write of the current sync failed, its copy has to be written whole by the next sync to it.
+  bool write_failed = false;
+
   CacheSync() : Continuation(new_ProxyMutex()) { SET_HANDLER(&CacheSync::mainEvent); }
 };
 
@@ -278,6 +289,13 @@ struct Directory {
   int                  segments{};
   off_t                buckets{};
 
+  /* Per segment, the copies of the directory on disk the segment changed
+     since it was written to: bit 0 for copy A and bit 1 for copy B.
+   */
+  std::vector<uint8_t> dirty_segments;
+
+  static constexpr uint8_t DIRTY_ALL_COPIES = 3;
+
   /* Total number of dir entries.
    */
   int entries() const;
@@ -285,6 +303,10 @@ struct Directory {
   /* Returns the first dir in segment @a s.
    */
   Dir *get_segment(int s) const;
+
+  /* Record a change to segment @a s for the next directory syncs.
+   */
+  void mark_dirty(int s);
 };
 
 inline int
@@ -299,6 +321,13 @@ Directory::get_segment(int s) const
   return reinterpret_cast<Dir *>((reinterpret_cast<char *>(this->dir)) + (s * this->buckets) * DIR_DEPTH * SIZEOF_DIR);
 }
 
+inline void
+Directory::mark_dirty(int s)
+{
+  this->header->dirty     = 1;
+  this->dirty_segments[s] = DIRTY_ALL_COPIES;
+}
+
 // Global Functions
 
 int      dir_probe(const CacheKey *, StripeSM *, Dir *, Dir **);
@@ -376,3 +405,36 @@ dir_bucket_row(Dir *b, int64_t i)
 {
   return dir_in_seg(b, i);
 }
+
+/** Bitmask of the rows of bucket @a b whose tag is @a tag, bit @c i for row @c i.
+
+    The rows of a bucket are adjacent, so their tags are compared together as soon as the bucket is loaded instead of
+    one at a time while following the chain. Rows that are not in the bucket's chain can match as well (a free entry
+    keeps its freelist link in the tag word), so a set bit still needs the chain walk, a clear bit rules the row out.
+ */
+inline unsigned
+dir_bucket_tag_match(const Dir *b, uint32_t tag)
+{
+  static_assert(DIR_DEPTH == 4 && SIZEOF_DIR == 10, "bucket tag compare assumes 4 rows of 5 words");
+#if defined(__SSE2__)
+  // The tags are words 2, 7, 12 and 17 of the 40 byte bucket. Load exactly that much, the last bucket of the directory
+  // ends the allocation.
+  const char *p    = reinterpret_cast<const char *>(b);
+  __m128i     lo   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  __m128i     mid  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16));
+  __m128i     hi   = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p + 32));
+  __m128i     mask = _mm_set1_epi16((1 << DIR_TAG_WIDTH) - 1);
+  __m128i     t    = _mm_set1_epi16(static_cast<int16_t>(tag));
+  unsigned    m_lo = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(lo, mask), t));
+  unsigned    m_mi = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(mid, mask), t));
+  unsigned    m_hi = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(hi, mask), t));
+  // Word w of a register is bits 2w and 2w + 1 of its movemask.
+  return ((m_lo >> 4) & 1) | ((m_lo >> 13) & 2) | ((m_mi >> 6) & 4) | ((m_hi << 1) & 8);
+#else
+  unsigned m = 0;
+  for (int i = 0; i < DIR_DEPTH; ++i) {
+    m |= static_cast<unsigned>(dir_tag(b + i) == tag) << i;
+  }
+  return m;
+#endif
+}
@@ -46,6 +46,10 @@ struct CacheStatsBlock {
   ts::Metrics::Gauge::AtomicType   *direntries_used       = nullptr;
   ts::Metrics::Counter::AtomicType *ram_cache_hits        = nullptr;
   ts::Metrics::Counter::AtomicType *ram_cache_misses      = nullptr;
+  ts::Metrics::Counter::AtomicType *ram_compress_in       = nullptr;
+  ts::Metrics::Counter::AtomicType *ram_compress_out      = nullptr;
+  ts::Metrics::Counter::AtomicType *ram_compress_time     = nullptr;
+  ts::Metrics::Counter::AtomicType *ram_decompress_time   = nullptr;
   ts::Metrics::Counter::AtomicType *pread_count           = nullptr;
   ts::Metrics::Gauge::AtomicType   *percent_full          = nullptr;
   ts::Metrics::Counter::AtomicType *read_seek_fail        = nullptr;
@@ -64,6 +68,7 @@ struct CacheStatsBlock {
   ts::Metrics::Counter::AtomicType *directory_sync_count  = nullptr;
   ts::Metrics::Counter::AtomicType *directory_sync_time   = nullptr;
   ts::Metrics::Counter::AtomicType *directory_sync_bytes  = nullptr;
+  ts::Metrics::Counter::AtomicType *directory_sync_saved  = nullptr;
   ts::Metrics::Counter::AtomicType *span_errors_read      = nullptr;
   ts::Metrics::Counter::AtomicType *span_errors_write     = nullptr;
   ts::Metrics::Gauge::AtomicType   *span_offline          = nullptr;
@@ -35,12 +35,19 @@
 #ifdef HAVE_LZMA_H
 #include <lzma.h>
 #endif
+#ifdef HAVE_ZSTD_H
+#include <zstd.h>
+#endif
+#ifdef HAVE_LZ4_H
+#include <lz4.h>
+#endif
 
 #define REQUIRED_COMPRESSION 0.9 // must get to this size or declared incompressible
 #define REQUIRED_SHRINK      0.8 // must get to this size or keep original buffer (with padding)
 #define HISTORY_HYSTERIA     10  // extra temporary history
 #define ENTRY_OVERHEAD       256 // per-entry overhead to consider when computing cache value/size
 #define LZMA_BASE_MEMLIMIT   (64 * 1024 * 1024)
+#define ZSTD_LEVEL           1 // entries are compressed again after every put, favor speed
 // #define CHECK_ACOUNTING 1 // very expensive double checking of all sizes
 
 #define REQUEUE_HITS(_h)              ((_h) ? ((_h) - 1) : 0)
@@ -50,6 +57,8 @@
 #define AVERAGE_VALUE_OVER 100
 #define REQUEUE_LIMIT      100
 
+extern int64_t cache_config_ram_cache_compress_budget;
+
 #ifdef DEBUG
 
 namespace
@@ -164,6 +173,16 @@ RamCacheCLFUSCompressor::mainEvent(int /* event ATS_UNUSED */, Event *e)
   case CACHE_COMPRESSION_LIBLZMA:
 #ifndef HAVE_LZMA_H
     Warning("lzma not available for RAM cache compression");
+#endif
+    break;
+  case CACHE_COMPRESSION_ZSTD:
+#ifndef HAVE_ZSTD_H
+    Warning("zstd not available for RAM cache compression");
+#endif
+    break;
+  case CACHE_COMPRESSION_LZ4:
+#ifndef HAVE_LZ4_H
+    Warning("lz4 not available for RAM cache compression");
 #endif
     break;
   }
@@ -266,7 +285,8 @@ RamCacheCLFUS::get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint64_t auxkey
         e->hits++;
         uint32_t ram_hit_state = RAM_HIT_COMPRESS_NONE;
         if (e->flag_bits.compressed) {
-          b = static_cast<char *>(ats_malloc(e->len));
+          b                = static_cast<char *>(ats_malloc(e->len));
+          ink_hrtime start = ink_get_hrtime();
           switch (e->flag_bits.compressed) {
           default:
             goto Lfailed;
@@ -299,7 +319,29 @@ RamCacheCLFUS::get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint64_t auxkey
             break;
           }
 #endif
+#ifdef HAVE_ZSTD_H
+          case CACHE_COMPRESSION_ZSTD: {
+            size_t l = ZSTD_decompress(b, e->len, e->data->data(), e->compressed_len);
+            if (ZSTD_isError(l) || l != e->len) {
+              goto Lfailed;
+            }
+            ram_hit_state = RAM_HIT_COMPRESS_ZSTD;
+            break;
+          }
+#endif
+#ifdef HAVE_LZ4_H
+          case CACHE_COMPRESSION_LZ4: {
+            if (LZ4_decompress_safe(e->data->data(), b, e->compressed_len, e->len) != static_cast<int>(e->len)) {
+              goto Lfailed;
+            }
+            ram_hit_state = RAM_HIT_COMPRESS_LZ4;
+            break;
           }
+#endif
+          }
+          ink_hrtime elapsed = ink_get_hrtime() - start;
+          ts::Metrics::Counter::increment(cache_rsb.ram_decompress_time, elapsed);
+          ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.ram_decompress_time, elapsed);
           IOBufferData *data = new_xmalloc_IOBufferData(b, e->len);
           data->_mem_type    = DEFAULT_ALLOC;
           if (!e->flag_bits.copy) { // don't bother if we have to copy anyway
@@ -439,13 +481,15 @@ RamCacheCLFUS::compress_entries(EThread *thread, int do_at_most)
   float target = (cache_config_ram_cache_compress_percent / 100.0) * this->_objects;
   int   n      = 0;
   char *b = nullptr, *bb = nullptr;
+  // bytes this stripe may still compress in this pass
+  int64_t budget = cache_config_ram_cache_compress_budget > 0 ? cache_config_ram_cache_compress_budget : INT64_MAX;
   while (this->_compressed && target > this->_ncompressed) {
     RamCacheCLFUSEntry *e = this->_compressed;
     if (e->flag_bits.incompressible || e->flag_bits.compressed) {
       goto Lcontinue;
     }
     n++;
-    if (do_at_most < n) {
+    if (do_at_most < n || budget <= 0) {
       break;
     }
     {
@@ -465,6 +509,16 @@ RamCacheCLFUS::compress_entries(EThread *thread, int do_at_most)
       case CACHE_COMPRESSION_LIBLZMA:
         l = e->len;
         break;
+#endif
+#ifdef HAVE_ZSTD_H
+      case CACHE_COMPRESSION_ZSTD:
+        l = static_cast<uint32_t>(ZSTD_compressBound(e->len));
+        break;
+#endif
+#ifdef HAVE_LZ4_H
+      case CACHE_COMPRESSION_LZ4:
+        l = static_cast<uint32_t>(LZ4_compressBound(e->len));
+        break;
 #endif
       }
       // store transient data for lock release
@@ -472,8 +526,9 @@ RamCacheCLFUS::compress_entries(EThread *thread, int do_at_most)
       uint32_t          elen  = e->len;
       CryptoHash        key   = e->key;
       MUTEX_UNTAKE_LOCK(stripe->mutex, thread);
-      b           = static_cast<char *>(ats_malloc(l));
-      bool failed = false;
+      b                = static_cast<char *>(ats_malloc(l));
+      bool       failed = false;
+      ink_hrtime start  = ink_get_hrtime();
       switch (ctype) {
       default:
         goto Lfailed;
@@ -504,8 +559,32 @@ RamCacheCLFUS::compress_entries(EThread *thread, int do_at_most)
         l = static_cast<int>(pos);
         break;
       }
+#endif
+#ifdef HAVE_ZSTD_H
+      case CACHE_COMPRESSION_ZSTD: {
+        size_t ll = ZSTD_compress(b, l, edata->data(), elen, ZSTD_LEVEL);
+        if (ZSTD_isError(ll)) {
+          failed = true;
+        }
+        l = static_cast<uint32_t>(ll);
+        break;
+      }
+#endif
+#ifdef HAVE_LZ4_H
+      case CACHE_COMPRESSION_LZ4: {
+        int ll = LZ4_compress_default(edata->data(), b, elen, l);
+        if (ll <= 0) {
+          failed = true;
+        }
+        l = static_cast<uint32_t>(ll);
+        break;
+      }
 #endif
       }
+      ink_hrtime elapsed = ink_get_hrtime() - start;
+      ts::Metrics::Counter::increment(cache_rsb.ram_compress_time, elapsed);
+      ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.ram_compress_time, elapsed);
+      budget -= elen;
       MUTEX_TAKE_LOCK(stripe->mutex, thread);
       // see if the entry is till around
       {
@@ -533,6 +612,10 @@ RamCacheCLFUS::compress_entries(EThread *thread, int do_at_most)
         goto Lfailed;
       }
       if (l < e->len) {
+        ts::Metrics::Counter::increment(cache_rsb.ram_compress_in, e->len);
+        ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.ram_compress_in, e->len);
+        ts::Metrics::Counter::increment(cache_rsb.ram_compress_out, l);
+        ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.ram_compress_out, l);
         e->flag_bits.compressed = cache_config_ram_cache_compress;
         bb                      = static_cast<char *>(ats_malloc(l));
         memcpy(bb, b, l);
@@ -0,0 +1,350 @@
+/** @file
+
+  RAM cache with CLOCK eviction and TinyLFU admission
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+// Like the other RAM caches this one is only called under the stripe mutex and takes no lock of its
+// own.  A hit sets the reference bit of the entry and eviction is a CLOCK sweep done on insert, so
+// hits never reorder a list.
+//
+// Inserts go through a TinyLFU admission filter.  Every lookup is counted in a count-min sketch of
+// small saturating counters which are halved periodically, and when the cache is full a new object
+// is only admitted if it has been asked for more often than the object it would evict.  One time
+// requests such as a scan never get in and so do not flush the popular objects.
+
+#include "P_RamCache.h"
+#include "P_CacheInternal.h"
+#include "StripeSM.h"
+#include "iocore/eventsystem/IOBuffer.h"
+#include "tscore/CryptoHash.h"
+#include "tscore/List.h"
+
+#include <memory>
+#include <vector>
+
+struct RamCacheTinyLFUEntry {
+  CryptoHash key;
+  uint64_t   auxkey;
+  bool       referenced = false;
+  LINK(RamCacheTinyLFUEntry, clock_link);
+  LINK(RamCacheTinyLFUEntry, hash_link);
+  Ptr<IOBufferData> data;
+};
+
+#define ENTRY_OVERHEAD 128 // per-entry overhead to consider when computing sizes
+
+// The sketch has a counter per SKETCH_OBJECT_SIZE bytes of the cache in each row and is aged after
+// SKETCH_SAMPLE_FACTOR lookups per counter.
+#define SKETCH_DEPTH         4
+#define SKETCH_COUNTER_MAX   15
+#define SKETCH_OBJECT_SIZE   8192
+#define SKETCH_SAMPLE_FACTOR 10
+
+namespace
+{
+
+#ifdef DEBUG
+DbgCtl dbg_ctl_ram_cache{"ram_cache"};
+#endif
+
+inline uint64_t
+mix64(uint64_t x)
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+} // end anonymous namespace
+
+struct RamCacheTinyLFU : public RamCache {
+  using Bucket = DList(RamCacheTinyLFUEntry, hash_link);
+
+  int64_t max_bytes = 0;
+  int64_t bytes     = 0;
+  int64_t objects   = 0;
+
+  // returns 1 on found/stored, 0 on not found/stored, if provided auxkey must match
+  int     get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint64_t auxkey = 0) override;
+  int     put(CryptoHash *key, IOBufferData *data, uint32_t len, bool copy = false, uint64_t auxkey = 0) override;
+  int     fixup(const CryptoHash *key, uint64_t old_auxkey, uint64_t new_auxkey) override;
+  int64_t size() const override;
+
+  void init(int64_t max_bytes, StripeSM *stripe) override;
+
+  // private
+  std::vector<Bucket> bucket;
+  Que(RamCacheTinyLFUEntry, clock_link) clock;
+  StripeSM *stripe = nullptr;
+
+  // count-min sketch, SKETCH_DEPTH rows of sketch_width counters
+  std::unique_ptr<uint8_t[]> sketch;
+  uint64_t                   sketch_mask = 0;
+  uint32_t                   sample_size = 0;
+  uint32_t                   additions   = 0;
+
+  void     record(const CryptoHash *key);
+  int      frequency(const CryptoHash *key) const;
+  void     age();
+  uint32_t
+  bucket_of(const CryptoHash *key) const
+  {
+    return key->slice32(3) & (bucket.size() - 1);
+  }
+  void                  resize_hashtable();
+  RamCacheTinyLFUEntry *victim();
+  void                  remove(RamCacheTinyLFUEntry *e);
+};
+
+ClassAllocator<RamCacheTinyLFUEntry> ramCacheTinyLFUEntryAllocator("RamCacheTinyLFUEntry");
+
+void
+RamCacheTinyLFU::record(const CryptoHash *key)
+{
+  uint64_t h = key->u64[0];
+  for (int i = 0; i < SKETCH_DEPTH; i++) {
+    uint8_t &c = sketch[i * (sketch_mask + 1) + (mix64(h + i) & sketch_mask)];
+    if (c < SKETCH_COUNTER_MAX) {
+      c++;
+    }
+  }
+  additions++;
+}
+
+int
+RamCacheTinyLFU::frequency(const CryptoHash *key) const
+{
+  uint64_t h = key->u64[0];
+  int      f = SKETCH_COUNTER_MAX;
+  for (int i = 0; i < SKETCH_DEPTH; i++) {
+    int v = sketch[i * (sketch_mask + 1) + (mix64(h + i) & sketch_mask)];
+    if (v < f) {
+      f = v;
+    }
+  }
+  return f;
+}
+
+// halve the counters so that the sketch follows changes in popularity
+void
+RamCacheTinyLFU::age()
+{
+  for (uint64_t i = 0; i < SKETCH_DEPTH * (sketch_mask + 1); i++) {
+    sketch[i] >>= 1;
+  }
+  additions = 0;
+}
+
+void
+RamCacheTinyLFU::resize_hashtable()
+{
+  std::vector<Bucket> new_bucket(bucket.size() * 2);
+  DDbg(dbg_ctl_ram_cache, "resize hashtable %zu", new_bucket.size());
+  for (auto &b : bucket) {
+    RamCacheTinyLFUEntry *e = nullptr;
+    while ((e = b.pop())) {
+      new_bucket[e->key.slice32(3) & (new_bucket.size() - 1)].push(e);
+    }
+  }
+  bucket.swap(new_bucket);
+}
+
+// CLOCK sweep: referenced entries get a second chance, the first unreferenced entry is left at the head
+RamCacheTinyLFUEntry *
+RamCacheTinyLFU::victim()
+{
+  RamCacheTinyLFUEntry *e = nullptr;
+  while ((e = clock.head) && e->referenced) {
+    e->referenced = false;
+    clock.remove(e);
+    clock.enqueue(e);
+  }
+  return e;
+}
+
+int64_t
+RamCacheTinyLFU::size() const
+{
+  int64_t s = 0;
+  forl_LL(RamCacheTinyLFUEntry, e, clock)
+  {
+    s += sizeof(*e);
+    s += sizeof(*e->data);
+    s += e->data->block_size();
+  }
+  return s;
+}
+
+void
+RamCacheTinyLFU::init(int64_t abytes, StripeSM *astripe)
+{
+  stripe    = astripe;
+  max_bytes = abytes;
+  DDbg(dbg_ctl_ram_cache, "initializing ram_cache %" PRId64 " bytes", abytes);
+  if (!max_bytes) {
+    return;
+  }
+
+  uint64_t width = 1024;
+  while (width < static_cast<uint64_t>(max_bytes / SKETCH_OBJECT_SIZE)) {
+    width <<= 1;
+  }
+  sketch      = std::make_unique<uint8_t[]>(SKETCH_DEPTH * width);
+  sketch_mask = width - 1;
+  sample_size = width * SKETCH_SAMPLE_FACTOR;
+
+  bucket.resize(1024);
+}
+
+int
+RamCacheTinyLFU::get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint64_t auxkey)
+{
+  if (!max_bytes) {
+    return 0;
+  }
+  record(key);
+  RamCacheTinyLFUEntry *e = bucket[bucket_of(key)].head;
+  while (e) {
+    if (e->key == *key && e->auxkey == auxkey) {
+      e->referenced = true;
+      (*ret_data) = e->data;
+      DDbg(dbg_ctl_ram_cache, "get %X %" PRIu64 " HIT", key->slice32(3), auxkey);
+      ts::Metrics::Counter::increment(cache_rsb.ram_cache_hits);
+      ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.ram_cache_hits);
+
+      return 1;
+    }
+    e = e->hash_link.next;
+  }
+  DDbg(dbg_ctl_ram_cache, "get %X %" PRIu64 " MISS", key->slice32(3), auxkey);
+  ts::Metrics::Counter::increment(cache_rsb.ram_cache_misses);
+  ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.ram_cache_misses);
+
+  return 0;
+}
+
+void
+RamCacheTinyLFU::remove(RamCacheTinyLFUEntry *e)
+{
+  bucket[bucket_of(&e->key)].remove(e);
+  clock.remove(e);
+  bytes -= ENTRY_OVERHEAD + e->data->block_size();
+  ts::Metrics::Gauge::decrement(cache_rsb.ram_cache_bytes, ENTRY_OVERHEAD + e->data->block_size());
+  ts::Metrics::Gauge::decrement(stripe->cache_vol->vol_rsb.ram_cache_bytes, ENTRY_OVERHEAD + e->data->block_size());
+
+  DDbg(dbg_ctl_ram_cache, "put %X %" PRIu64 " FREED", e->key.slice32(3), e->auxkey);
+  e->data       = nullptr;
+  e->referenced = false;
+  THREAD_FREE(e, ramCacheTinyLFUEntryAllocator, this_ethread());
+  objects--;
+}
+
+// ignore 'copy' since we don't touch the data
+int
+RamCacheTinyLFU::put(CryptoHash *key, IOBufferData *data, [[maybe_unused]] uint32_t len, bool, uint64_t auxkey)
+{
+  if (!max_bytes) {
+    return 0;
+  }
+  int64_t entry_size = ENTRY_OVERHEAD + data->block_size();
+  if (entry_size > max_bytes) {
+    return 0;
+  }
+  if (additions >= sample_size) {
+    age();
+  }
+
+  RamCacheTinyLFUEntry *e = bucket[bucket_of(key)].head;
+  while (e) {
+    RamCacheTinyLFUEntry *next = e->hash_link.next;
+    if (e->key == *key) {
+      if (e->auxkey == auxkey) {
+        e->referenced = true;
+        return 1;
+      } else { // discard when aux keys conflict
+        remove(e);
+      }
+    }
+    e = next;
+  }
+
+  if (bytes + entry_size > max_bytes) {
+    RamCacheTinyLFUEntry *v = victim();
+    if (v && frequency(key) <= frequency(&v->key)) {
+      DDbg(dbg_ctl_ram_cache, "put %X %" PRIu64 " len %d NOT ADMITTED", key->slice32(3), auxkey, len);
+      return 0;
+    }
+  }
+
+  e         = THREAD_ALLOC(ramCacheTinyLFUEntryAllocator, this_ethread());
+  e->key    = *key;
+  e->auxkey = auxkey;
+  e->data   = data;
+  bucket[bucket_of(key)].push(e);
+  clock.enqueue(e);
+  bytes += entry_size;
+  objects++;
+  ts::Metrics::Gauge::increment(cache_rsb.ram_cache_bytes, entry_size);
+  ts::Metrics::Gauge::increment(stripe->cache_vol->vol_rsb.ram_cache_bytes, entry_size);
+  while (bytes > max_bytes) {
+    RamCacheTinyLFUEntry *v = victim();
+    if (v == e) { // only the new entry is left to evict, drop the others first
+      clock.remove(e);
+      clock.enqueue(e);
+      v = victim();
+    }
+    if (!v || v == e) {
+      break;
+    }
+    remove(v);
+  }
+  DDbg(dbg_ctl_ram_cache, "put %X %" PRIu64 " INSERTED", key->slice32(3), auxkey);
+  if (objects > static_cast<int64_t>(bucket.size() * 0.75)) { // Resize when 75% "full"
+    resize_hashtable();
+  }
+  return 1;
+}
+
+int
+RamCacheTinyLFU::fixup(const CryptoHash *key, uint64_t old_auxkey, uint64_t new_auxkey)
+{
+  if (!max_bytes) {
+    return 0;
+  }
+  RamCacheTinyLFUEntry *e = bucket[bucket_of(key)].head;
+  while (e) {
+    if (e->key == *key && e->auxkey == old_auxkey) {
+      e->auxkey = new_auxkey;
+      return 1;
+    }
+    e = e->hash_link.next;
+  }
+  return 0;
+}
+
+RamCache *
+new_RamCacheTinyLFU()
+{
+  return new RamCacheTinyLFU;
+}
@@ -162,6 +162,8 @@ Stripe::_init_directory(std::size_t directory_size, int header_size, int footer_
   this->directory.header = reinterpret_cast<StripteHeaderFooter *>(this->directory.raw_dir);
   std::size_t const footer_offset{directory_size - static_cast<std::size_t>(footer_size)};
   this->directory.footer = reinterpret_cast<StripteHeaderFooter *>(this->directory.raw_dir + footer_offset);
+  // Nothing is known about the copies on disk yet, the first sync to each writes all of it.
+  this->directory.dirty_segments.assign(this->directory.segments, Directory::DIRTY_ALL_COPIES);
 }
 
 int
@@ -337,6 +339,8 @@ Stripe::_clear_init(std::uint32_t hw_sector_size)
   this->directory.header->dirty                                                        = 0;
   this->sector_size = this->directory.header->sector_size = hw_sector_size;
   *this->directory.footer                                 = *this->directory.header;
+  // All of the directory changed, neither copy on disk matches it.
+  this->directory.dirty_segments.assign(this->directory.segments, Directory::DIRTY_ALL_COPIES);
 }
 
 void
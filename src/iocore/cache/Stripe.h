@@ -33,6 +33,7 @@
 #include "tscore/ink_align.h"
 #include "tscore/ink_memory.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 
@@ -60,6 +61,8 @@ struct CacheVol {
   bool         ramcache_enabled = true;
   StripeSM   **stripes          = nullptr;
   DiskStripe **disk_stripes     = nullptr;
+  /// Number of @a stripes constructed so far, published for readers on other threads while the cache opens.
+  std::atomic<int> stripes_open{0};
   LINK(CacheVol, link);
   // per volume stats
   CacheStatsBlock vol_rsb;
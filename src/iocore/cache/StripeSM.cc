@@ -42,6 +42,7 @@
 #include "iocore/eventsystem/Event.h"
 #include "iocore/eventsystem/EventProcessor.h"
 #include "iocore/eventsystem/IOBuffer.h"
+#include "iocore/eventsystem/Tasks.h"
 
 #include "tsutil/DbgCtl.h"
 #include "tsutil/Metrics.h"
@@ -263,6 +264,7 @@ StripeSM::handle_dir_read(int event, void *data)
   CHECK_DIR(this);
 
   sector_size = directory.header->sector_size;
+  init_state  = InitState::RECOVER;
 
   return this->recover_data();
 }
@@ -278,6 +280,7 @@ StripeSM::clear_dir_aio()
 
   SET_HANDLER(&StripeSM::handle_dir_clear);
 
+  init_state          = InitState::CLEAR_DIRECTORY;
   io.aiocb.aio_fildes = fd;
   io.aiocb.aio_buf    = directory.raw_dir;
   io.aiocb.aio_nbytes = dir_len;
@@ -290,11 +293,17 @@ StripeSM::clear_dir_aio()
   return 0;
 }
 
+/* The recovery scan walks the stripe content, which can take a long time
+   on a large stripe. Run it on a task thread so it does not hold up a net
+   thread. A stripe does not hold its thread while it waits for a read, so
+   the reads of all the stripes overlap, but the scans of what they read
+   share the proxy.config.task_threads task threads. */
 int
 StripeSM::recover_data()
 {
   SET_HANDLER(&StripeSM::handle_recover_from_data);
-  return handle_recover_from_data(EVENT_IMMEDIATE, nullptr);
+  eventProcessor.schedule_imm(this, ET_TASK);
+  return EVENT_DONE;
 }
 
 /*
@@ -358,12 +367,16 @@ StripeSM::handle_recover_from_data(int event, void * /* data ATS_UNUSED */)
     if (static_cast<off_t>(recover_pos + io.aiocb.aio_nbytes) > static_cast<off_t>(skip + len)) {
       io.aiocb.aio_nbytes = (skip + len) - recover_pos;
     }
+    Dbg(dbg_ctl_cache_init, "recovering '%s' from %" PRIu64, hash_text.get(), recover_pos);
+    // keep the rest of the scan on this task thread
+    io.thread = this_ethread();
   } else if (event == AIO_EVENT_DONE) {
     if (!io.ok()) {
       Warning("disk read error on recover '%s', clearing", hash_text.get());
       disk->incrErrors(&io);
       goto Lclear;
     }
+    recovered_bytes += io.aiocb.aio_nbytes;
     if (io.aiocb.aio_offset == directory.header->last_write_pos) {
       /* check that we haven't wrapped around without syncing
          the directory. Start from last_write_serial (write pos the documents
@@ -547,12 +560,7 @@ Ldone: {
   // clear effected portion of the cache
   off_t clear_start = this->offset_to_vol_offset(directory.header->write_pos);
   off_t clear_end   = this->offset_to_vol_offset(recover_pos);
-  if (clear_start <= clear_end) {
-    dir_clear_range(clear_start, clear_end, this);
-  } else {
-    dir_clear_range(clear_start, DIR_OFFSET_MAX, this);
-    dir_clear_range(1, clear_end, this);
-  }
+  dir_clear_range(clear_start, clear_end, this);
 
   Note("recovery clearing offsets of Stripe %s : [%" PRIu64 ", %" PRIu64 "] sync_serial %d next %d\n", hash_text.get(),
        directory.header->write_pos, recover_pos, directory.header->sync_serial, next_sync_serial);
@@ -581,6 +589,7 @@ Ldone: {
   init_info->vol_aio[2].aiocb.aio_nbytes = footerlen;
   init_info->vol_aio[2].aiocb.aio_offset = ss + dirlen - footerlen;
 
+  init_state = InitState::WRITE_DIRECTORY;
   SET_HANDLER(&StripeSM::handle_recover_write_dir);
   ink_assert(ink_aio_write(init_info->vol_aio));
   return EVENT_CONT;
@@ -600,6 +609,7 @@ StripeSM::handle_recover_write_dir(int /* event ATS_UNUSED */, void * /* data AT
   if (io.aiocb.aio_buf) {
     free(static_cast<char *>(io.aiocb.aio_buf));
   }
+  io.thread = AIO_CALLBACK_THREAD_ANY;
   delete init_info;
   init_info = nullptr;
   set_io_not_in_progress();
@@ -644,6 +654,7 @@ StripeSM::handle_header_read(int event, void *data)
       op = op->then;
     }
 
+    init_state          = InitState::READ_DIRECTORY;
     io.aiocb.aio_fildes = fd;
     io.aiocb.aio_nbytes = this->dirlen();
     io.aiocb.aio_buf    = directory.raw_dir;
@@ -683,6 +694,28 @@ StripeSM::handle_header_read(int event, void *data)
   return EVENT_DONE;
 }
 
+const char *
+StripeSM::init_state_name() const
+{
+  switch (init_state.load()) {
+  case InitState::READ_HEADER:
+    return "reading header";
+  case InitState::READ_DIRECTORY:
+    return "reading directory";
+  case InitState::RECOVER:
+    return "recovering";
+  case InitState::WRITE_DIRECTORY:
+    return "writing directory";
+  case InitState::CLEAR_DIRECTORY:
+    return "clearing directory";
+  case InitState::READY:
+    return "ready";
+  case InitState::FAILED:
+    return "failed";
+  }
+  return "unknown";
+}
+
 int
 StripeSM::dir_init_done(int /* event ATS_UNUSED */, void * /* data ATS_UNUSED */)
 {
@@ -693,6 +726,7 @@ StripeSM::dir_init_done(int /* event ATS_UNUSED */, void * /* data ATS_UNUSED */
     int i = gnstripes++;
     ink_assert(!gstripes[i]);
     gstripes[i] = this;
+    init_state  = fd != -1 ? InitState::READY : InitState::FAILED;
     SET_HANDLER(&StripeSM::aggWrite);
     cache->vol_initialized(fd != -1);
     return EVENT_DONE;
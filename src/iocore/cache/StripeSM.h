@@ -83,7 +83,14 @@ public:
   DLL<EvacuationBlock> lookaside[LOOKASIDE_SIZE];
   CacheEvacuateDocVC  *doc_evacuator = nullptr;
 
-  StripeInitInfo *init_info = nullptr;
+  /// Progress of the stripe through initialization, read concurrently for status reporting.
+  enum class InitState : uint8_t { READ_HEADER, READ_DIRECTORY, RECOVER, WRITE_DIRECTORY, CLEAR_DIRECTORY, READY, FAILED };
+
+  StripeInitInfo        *init_info = nullptr;
+  std::atomic<InitState> init_state{InitState::READ_HEADER};
+  std::atomic<int64_t>   recovered_bytes{0}; ///< Stripe content scanned by directory recovery so far.
+
+  const char *init_state_name() const;
 
   Cache   *cache                = nullptr;
   uint32_t last_sync_serial     = 0;
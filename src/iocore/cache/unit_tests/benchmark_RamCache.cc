@@ -0,0 +1,179 @@
+/** @file
+
+  Micro benchmark for the RAM cache algorithms
+
+  Replays a Zipfian key trace and a trace where a third of the requests are a scan of keys that are
+  never asked for again against each RAM cache, and reports the hit ratio and request rate of each.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "main.h"
+
+#include "../P_CacheInternal.h"
+#include "../P_RamCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Required by main.h
+int  cache_vols           = 1;
+bool reuse_existing_cache = false;
+
+namespace
+{
+constexpr int     N_OBJECTS   = 1 << 16;
+constexpr int     TRACE_SIZE  = 1 << 18;
+constexpr double  ZIPF_ALPHA  = 0.9;
+constexpr int64_t CACHE_BYTES = 64 * 1024 * 1024;
+constexpr int     OBJECT_SIZE = 1 << 14;
+
+using Trace = std::vector<uint64_t>;
+
+Trace
+zipf_trace(std::mt19937_64 &rng)
+{
+  std::vector<double> cdf(N_OBJECTS);
+  double              sum = 0;
+  for (int i = 0; i < N_OBJECTS; ++i) {
+    sum    += 1.0 / std::pow(i + 1, ZIPF_ALPHA);
+    cdf[i]  = sum;
+  }
+
+  std::uniform_real_distribution<double> uniform(0, sum);
+  Trace                                  trace(TRACE_SIZE);
+  for (auto &key : trace) {
+    key = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin();
+  }
+  return trace;
+}
+
+// Every third request is the next key of a scan which never repeats.
+Trace
+scan_trace(std::mt19937_64 &rng)
+{
+  Trace    trace = zipf_trace(rng);
+  uint64_t scan  = N_OBJECTS;
+  for (size_t i = 2; i < trace.size(); i += 3) {
+    trace[i] = scan++;
+  }
+  return trace;
+}
+
+void
+init_disk(CacheDisk &disk)
+{
+  disk.path                = static_cast<char *>(ats_malloc(1));
+  disk.path[0]             = '\0';
+  disk.disk_stripes        = static_cast<DiskStripe **>(ats_malloc(sizeof(DiskStripe *)));
+  disk.disk_stripes[0]     = nullptr;
+  disk.header              = static_cast<DiskHeader *>(ats_malloc(sizeof(DiskHeader)));
+  disk.header->num_volumes = 0;
+}
+
+void
+init_stats(CacheVol &cache_vol)
+{
+  cache_rsb.ram_cache_hits           = ts::Metrics::Counter::createPtr("benchmark.ram_cache.hits");
+  cache_rsb.ram_cache_misses         = ts::Metrics::Counter::createPtr("benchmark.ram_cache.misses");
+  cache_rsb.ram_cache_bytes          = ts::Metrics::Gauge::createPtr("benchmark.ram_cache.bytes");
+  cache_vol.vol_rsb.ram_cache_hits   = ts::Metrics::Counter::createPtr("benchmark.vol.ram_cache.hits");
+  cache_vol.vol_rsb.ram_cache_misses = ts::Metrics::Counter::createPtr("benchmark.vol.ram_cache.misses");
+  cache_vol.vol_rsb.ram_cache_bytes  = ts::Metrics::Gauge::createPtr("benchmark.vol.ram_cache.bytes");
+}
+
+// Look up each key of the trace and insert it on a miss, as the cache read path does. Returns the number of hits.
+int
+replay(RamCache &cache, Trace const &trace, IOBufferData *data)
+{
+  int hits = 0;
+  for (uint64_t k : trace) {
+    CryptoHash        key;
+    Ptr<IOBufferData> ret;
+    key.u64[0] = k * 0x9e3779b97f4a7c15ULL;
+    key.u64[1] = k;
+    if (cache.get(&key, &ret)) {
+      ++hits;
+    } else {
+      cache.put(&key, data, OBJECT_SIZE);
+    }
+  }
+  return hits;
+}
+
+using Factory = RamCache *(*)();
+
+struct Algorithm {
+  const char *name;
+  Factory     create;
+};
+
+const Algorithm algorithms[] = {
+  {"LRU",     new_RamCacheLRU    },
+  {"CLFUS",   new_RamCacheCLFUS  },
+  {"TinyLFU", new_RamCacheTinyLFU},
+};
+
+} // end anonymous namespace
+
+TEST_CASE("RamCache")
+{
+  CacheDisk disk;
+  init_disk(disk);
+  StripeSM stripe{&disk, 10, 0};
+  CacheVol cache_vol;
+  stripe.cache_vol = &cache_vol;
+  init_stats(cache_vol);
+
+  std::mt19937_64 rng{13};
+  Trace const     zipf = zipf_trace(rng);
+  Trace const     scan = scan_trace(rng);
+
+  Ptr<IOBufferData> data = make_ptr(new_IOBufferData(iobuffer_size_to_index(OBJECT_SIZE, MAX_BUFFER_SIZE_INDEX)));
+
+  for (auto const &algorithm : algorithms) {
+    for (auto const &[trace_name, trace] : {std::pair{"zipf", &zipf}, std::pair{"scan", &scan}}) {
+      std::unique_ptr<RamCache> cache{algorithm.create()};
+      cache->init(CACHE_BYTES, &stripe);
+
+      // warm up on the first half of the trace, measure on the second
+      Trace const warm{trace->begin(), trace->begin() + trace->size() / 2};
+      Trace const measure{trace->begin() + trace->size() / 2, trace->end()};
+      replay(*cache, warm, data.get());
+
+      auto start = std::chrono::steady_clock::now();
+      int  hits  = replay(*cache, measure, data.get());
+      auto us    = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+      std::printf("%-8s %-5s hit ratio %.4f, %.0f ops/sec\n", algorithm.name, trace_name,
+                  static_cast<double>(hits) / measure.size(), measure.size() * 1e6 / std::max<int64_t>(us, 1));
+
+      BENCHMARK(std::string(algorithm.name) + " " + trace_name)
+      {
+        return replay(*cache, measure, data.get());
+      };
+    }
+  }
+}
@@ -0,0 +1,162 @@
+/** @file
+
+  Directory probe rate with a nearly full directory.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "iocore/eventsystem/Event.h"
+#include "main.h"
+
+#include "../P_CacheDir.h"
+#include "../P_CacheInternal.h"
+
+// Required by main.h
+int  cache_vols           = 1;
+bool reuse_existing_cache = false;
+
+namespace
+{
+DbgCtl dbg_ctl_cache_dir_test{"cache_dir_test"};
+
+// Fraction of the directory entries in use while probing.
+constexpr double FILL = 0.9;
+
+unsigned int regress_rand_seed = 0;
+
+void
+regress_rand_CacheKey(CacheKey *key)
+{
+  unsigned int *x = reinterpret_cast<unsigned int *>(key);
+  for (int i = 0; i < 4; i++) {
+    x[i] = next_rand(&regress_rand_seed);
+  }
+}
+
+void
+report(const char *what, int n, ink_hrtime elapsed)
+{
+  uint64_t us = elapsed / HRTIME_USECOND;
+  if (us) {
+    Dbg(dbg_ctl_cache_dir_test, "%s probe rate = %" PRIu64 " / second", what, (n * static_cast<uint64_t>(1000000)) / us);
+  }
+}
+
+} // end anonymous namespace
+
+class CacheDirProbeTest : public CacheInit
+{
+public:
+  int
+  cache_init_success_callback(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */) override
+  {
+    REQUIRE(CacheProcessor::IsCacheEnabled() == CacheInitState::INITIALIZED);
+    REQUIRE(gnstripes >= 1);
+
+    StripeSM *stripe = gstripes[0];
+    EThread  *thread = this_ethread();
+    MUTEX_TRY_LOCK(lock, stripe->mutex, thread);
+    if (!lock.is_locked()) {
+      CONT_SCHED_LOCK_RETRY(this);
+      return EVENT_DONE;
+    }
+
+    stripe->clear_dir();
+
+    Dir dir;
+    dir_clear(&dir);
+    dir_set_phase(&dir, 0);
+    dir_set_head(&dir, true);
+    dir_set_offset(&dir, 1);
+
+    stripe->directory.header->agg_pos = stripe->directory.header->write_pos += 1024;
+
+    CacheKey key;
+    int      n        = static_cast<int>(stripe->directory.entries() * FILL);
+    int      inserted = 0;
+
+    regress_rand_seed = 17;
+    for (int i = 0; i < n; i++) {
+      regress_rand_CacheKey(&key);
+      inserted += dir_insert(&key, stripe, &dir);
+    }
+    CHECK(inserted == n);
+    // A segment whose freelist runs dry purges some of its entries, so not every key makes it.
+    int used = static_cast<int>(dir_entries_used(stripe));
+    Dbg(dbg_ctl_cache_dir_test, "%d of %d directory entries used", used, stripe->directory.entries());
+
+    // The bucket compare has to agree with the row by row one.
+    for (int s = 0; s < stripe->directory.segments; s++) {
+      Dir *seg = stripe->directory.get_segment(s);
+      for (int b = 0; b < stripe->directory.buckets; b++) {
+        Dir     *bucket = dir_bucket(b, seg);
+        uint32_t tag    = dir_tag(dir_bucket_row(bucket, b % DIR_DEPTH));
+        unsigned match  = 0;
+        for (int i = 0; i < DIR_DEPTH; i++) {
+          match |= static_cast<unsigned>(dir_tag(dir_bucket_row(bucket, i)) == tag) << i;
+        }
+        CHECK(dir_bucket_tag_match(bucket, tag) == match);
+      }
+    }
+
+    // Every key still in the directory is found.
+    regress_rand_seed = 17;
+    int        hits   = 0;
+    ink_hrtime ttime  = ink_get_hrtime();
+    for (int i = 0; i < n; i++) {
+      Dir *last_collision = nullptr;
+      regress_rand_CacheKey(&key);
+      hits += dir_probe(&key, stripe, &dir, &last_collision);
+    }
+    report("hit", n, ink_get_hrtime() - ttime);
+    CHECK(hits >= used);
+
+    // Keys never inserted only match by the odd tag collision.
+    regress_rand_seed = 23;
+    hits              = 0;
+    ttime             = ink_get_hrtime();
+    for (int i = 0; i < n; i++) {
+      Dir *last_collision = nullptr;
+      regress_rand_CacheKey(&key);
+      hits += dir_probe(&key, stripe, &dir, &last_collision);
+    }
+    report("miss", n, ink_get_hrtime() - ttime);
+    CHECK(hits < n / 100);
+
+    stripe->clear_dir();
+
+    // Teardown
+    test_done();
+    delete this;
+
+    return EVENT_DONE;
+  }
+};
+
+TEST_CASE("CacheDirProbe")
+{
+  init_cache(0);
+
+  CacheDirProbeTest *init = new CacheDirProbeTest;
+
+  this_ethread()->schedule_imm(init);
+  this_thread()->execute();
+
+  return;
+}
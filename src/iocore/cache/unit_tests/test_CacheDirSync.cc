@@ -0,0 +1,261 @@
+/** @file
+
+  Unit test for syncing only the changed segments of the cache directory.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "iocore/eventsystem/Event.h"
+#include "main.h"
+
+#include "../P_CacheDir.h"
+#include "../P_CacheInternal.h"
+
+#include <unistd.h>
+
+#include <cstring>
+#include <vector>
+
+// Required by main.h
+int  cache_vols           = 1;
+bool reuse_existing_cache = false;
+
+namespace
+{
+DbgCtl dbg_ctl_cache_dir_test{"cache_dir_test"};
+
+constexpr int KEYS         = 4000;
+constexpr int SEGMENT_KEYS = 200;
+
+/// A directory entry, at an offset of its own so that another key with the same tag cannot be taken for it.
+struct Entry {
+  CacheKey key;
+  int      offset;
+};
+
+bool
+dir_contains(StripeSM *stripe, Entry const &entry)
+{
+  Dir  result;
+  Dir *last_collision = nullptr;
+  while (dir_probe(&entry.key, stripe, &result, &last_collision)) {
+    if (static_cast<int>(dir_offset(&result)) == entry.offset) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+class CacheDirSyncTest : public CacheInit
+{
+public:
+  int
+  cache_init_success_callback(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */) override
+  {
+    REQUIRE(CacheProcessor::IsCacheEnabled() == CacheInitState::INITIALIZED);
+    REQUIRE(gnstripes >= 1);
+
+    // The stripe with the most segments, only some of which are changed between syncs.
+    stripe = gstripes[0];
+    for (int i = 1; i < gnstripes; i++) {
+      if (gstripes[i]->directory.segments > stripe->directory.segments) {
+        stripe = gstripes[i];
+      }
+    }
+    REQUIRE(stripe->directory.segments >= 3);
+
+    MUTEX_TRY_LOCK(lock, stripe->mutex, this_ethread());
+    if (!lock.is_locked()) {
+      CONT_SCHED_LOCK_RETRY(this);
+      return EVENT_DONE;
+    }
+
+    clear();
+    for (int i = 0; i < KEYS; i++) {
+      insert(-1);
+    }
+
+    cache_config_dir_sync_frequency = 1;
+    cache_config_dir_sync_delay     = 1;
+    sync                            = new CacheSync;
+    sync->trigger                   = eventProcessor.schedule_imm(sync);
+
+    SET_HANDLER(&CacheDirSyncTest::wait_for_sync);
+    this_ethread()->schedule_in(this, HRTIME_MSECONDS(10));
+    return EVENT_DONE;
+  }
+
+  int
+  wait_for_sync(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    MUTEX_TRY_LOCK(lock, stripe->mutex, this_ethread());
+    if (!lock.is_locked() || stripe->directory.header->dirty || stripe->dir_sync_in_progress) {
+      this_ethread()->schedule_in(this, HRTIME_MSECONDS(10));
+      return EVENT_DONE;
+    }
+
+    int last = stripe->directory.segments - 1;
+    Dbg(dbg_ctl_cache_dir_test, "sync %d done, serial %u", syncs + 1, stripe->directory.header->sync_serial);
+    switch (++syncs) {
+    case 1:
+      // The other copy has not been written since the start, the next sync writes all of it.
+      change_segment(0);
+      break;
+    case 2:
+      // The next sync writes the segment changed before the last sync, which that copy misses, and this one.
+      saved = ts::Metrics::Counter::load(cache_rsb.directory_sync_saved);
+      change_segment(last);
+      break;
+    case 3:
+      CHECK(ts::Metrics::Counter::load(cache_rsb.directory_sync_saved) > saved);
+      check_reload();
+
+      // After the directory is cleared all of it differs from the copy the next sync writes.
+      deleted.insert(deleted.end(), live.begin(), live.end());
+      live.clear();
+      clear();
+      for (int i = 0; i < SEGMENT_KEYS; i++) {
+        insert(0);
+      }
+      break;
+    default:
+      check_reload();
+
+      stripe->clear_dir();
+      test_done();
+      delete this;
+      return EVENT_DONE;
+    }
+
+    this_ethread()->schedule_in(this, HRTIME_MSECONDS(10));
+    return EVENT_DONE;
+  }
+
+private:
+  void
+  clear()
+  {
+    stripe->clear_dir();
+    // Every offset inserted is valid.
+    stripe->directory.header->agg_pos = stripe->directory.header->write_pos =
+      stripe->start + static_cast<off_t>(KEYS + 4 * SEGMENT_KEYS) * CACHE_BLOCK_SIZE;
+  }
+
+  /// Insert a new key, into segment @a s unless it is negative.
+  void
+  insert(int s)
+  {
+    Entry entry;
+    do {
+      rand_CacheKey(&entry.key);
+    } while (s >= 0 && static_cast<int>(entry.key.slice32(0) % stripe->directory.segments) != s);
+    entry.offset = ++next_offset;
+
+    Dir dir;
+    dir_clear(&dir);
+    dir_set_phase(&dir, stripe->directory.header->phase);
+    dir_set_head(&dir, true);
+    dir_set_offset(&dir, entry.offset);
+    REQUIRE(dir_insert(&entry.key, stripe, &dir));
+    live.push_back(entry);
+  }
+
+  /// Insert keys into segment @a s and delete some of those it has.
+  void
+  change_segment(int s)
+  {
+    for (int i = 0; i < SEGMENT_KEYS; i++) {
+      insert(s);
+    }
+    int n = 0;
+    for (auto it = live.begin(); it != live.end() && n < SEGMENT_KEYS / 2;) {
+      if (static_cast<int>(it->key.slice32(0) % stripe->directory.segments) != s) {
+        ++it;
+        continue;
+      }
+      Dir dir;
+      dir_clear(&dir);
+      dir_set_offset(&dir, it->offset);
+      REQUIRE(dir_delete(&it->key, stripe, &dir));
+      deleted.push_back(*it);
+      it = live.erase(it);
+      ++n;
+    }
+  }
+
+  /// Read the directory back from disk, as the cache does when it starts, and look up every entry.
+  void
+  check_reload()
+  {
+    size_t dirlen    = stripe->dirlen();
+    off_t  footerpos = dirlen - ROUND_TO_STORE_BLOCK(sizeof(StripteHeaderFooter));
+    char  *disk      = static_cast<char *>(ats_memalign(ats_pagesize(), 2 * dirlen));
+    REQUIRE(pread(stripe->fd, disk, 2 * dirlen, stripe->skip) == static_cast<ssize_t>(2 * dirlen));
+
+    // Choose between the two copies like StripeSM::handle_header_read.
+    auto serial = [&](int copy, off_t pos) {
+      return reinterpret_cast<StripteHeaderFooter *>(disk + copy * dirlen + pos)->sync_serial;
+    };
+    bool a_valid = serial(0, 0) == serial(0, footerpos);
+    bool b_valid = serial(1, 0) == serial(1, footerpos);
+    int  copy    = a_valid && (serial(0, 0) >= serial(1, 0) || !b_valid) ? 0 : 1;
+    REQUIRE(serial(copy, 0) == serial(copy, footerpos));
+    CHECK(serial(copy, 0) == stripe->directory.header->sync_serial);
+    CHECK(memcmp(disk + copy * dirlen, stripe->directory.raw_dir, dirlen) == 0);
+
+    memcpy(stripe->directory.raw_dir, disk + copy * dirlen, dirlen);
+    ats_free(disk);
+
+    CHECK(check_dir(stripe));
+    int missing = 0;
+    for (auto const &entry : live) {
+      missing += !dir_contains(stripe, entry);
+    }
+    CHECK(missing == 0);
+    int found = 0;
+    for (auto const &entry : deleted) {
+      found += dir_contains(stripe, entry);
+    }
+    CHECK(found == 0);
+  }
+
+  StripeSM          *stripe      = nullptr;
+  CacheSync         *sync        = nullptr;
+  int                syncs       = 0;
+  int                next_offset = 0;
+  int64_t            saved       = 0;
+  std::vector<Entry> live;
+  std::vector<Entry> deleted;
+};
+
+TEST_CASE("CacheDirSync")
+{
+  // Small objects, for a directory of several segments.
+  RecSetRecordInt("proxy.config.cache.min_average_object_size", 512, REC_SOURCE_EXPLICIT);
+  init_cache(0);
+
+  CacheDirSyncTest *init = new CacheDirSyncTest;
+
+  this_ethread()->schedule_imm(init);
+  this_thread()->execute();
+
+  return;
+}
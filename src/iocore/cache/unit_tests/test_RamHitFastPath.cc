@@ -0,0 +1,109 @@
+/** @file
+
+  Test serving the body of a RAM cache hit without a cache read
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define LARGE_FILE 10 * 1024 * 1024
+#define SMALL_FILE 10 * 1024
+
+#include "main.h"
+
+#include "../P_CacheInternal.h"
+
+int  cache_vols           = 1;
+bool reuse_existing_cache = false;
+
+// Open the object again and take its body from the open VC instead of reading it.
+class CacheSingleDataBlock : public CacheTestHandler
+{
+public:
+  CacheSingleDataBlock(size_t size, const char *url) : CacheTestHandler(), _size(size)
+  {
+    this->_rt        = new CacheReadTest(size, this, url);
+    this->_rt->mutex = this->mutex;
+
+    SET_HANDLER(&CacheSingleDataBlock::start_test);
+  }
+
+  int
+  start_test(int event, void * /* e ATS_UNUSED */)
+  {
+    REQUIRE(event == EVENT_IMMEDIATE);
+    this_ethread()->schedule_imm(this->_rt);
+    return 0;
+  }
+
+  void
+  handle_cache_event(int event, CacheTestBase *base) override
+  {
+    REQUIRE(event == CACHE_EVENT_OPEN_READ);
+
+    Ptr<IOBufferBlock> block = make_ptr(base->vc->get_single_data_block());
+    if (this->_size > static_cast<size_t>(cache_config_target_fragment_size)) {
+      // more than one fragment, only a cache read can deliver it
+      CHECK(block.get() == nullptr);
+    } else {
+      REQUIRE(block.get() != nullptr);
+      REQUIRE(block->read_avail() == static_cast<int64_t>(this->_size));
+      CHECK(memcmp(block->start(), GLOBAL_DATA, this->_size) == 0);
+      // the block must not be written to, it is the cache's copy
+      CHECK(block->write_avail() == 0);
+    }
+
+    base->close();
+    delete this;
+  }
+
+private:
+  size_t _size = 0;
+};
+
+class CacheRamHitInit : public CacheInit
+{
+public:
+  CacheRamHitInit() {}
+  int
+  cache_init_success_callback(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */) override
+  {
+    CacheTestHandler     *small     = new CacheTestHandler(SMALL_FILE, "http://www.scw11.com");
+    CacheSingleDataBlock *small_hit = new CacheSingleDataBlock(SMALL_FILE, "http://www.scw11.com");
+    CacheTestHandler     *large     = new CacheTestHandler(LARGE_FILE, "http://www.scw22.com");
+    CacheSingleDataBlock *large_hit = new CacheSingleDataBlock(LARGE_FILE, "http://www.scw22.com");
+    TerminalTest         *tt        = new TerminalTest;
+
+    small->add(small_hit);
+    small->add(large);
+    small->add(large_hit);
+    small->add(tt);
+    this_ethread()->schedule_imm(small);
+    delete this;
+    return 0;
+  }
+};
+
+TEST_CASE("ram cache hit -> single data block", "cache")
+{
+  init_cache(256 * 1024 * 1024);
+  CacheRamHitInit *init = new CacheRamHitInit;
+
+  this_ethread()->schedule_imm(init);
+  this_thread()->execute();
+}
@@ -58,14 +58,13 @@ int           dns_failover_try_period         = DEFAULT_FAILOVER_TRY_PERIOD;
 int           dns_max_dns_in_flight           = MAX_DNS_IN_FLIGHT;
 int           dns_max_tcp_continuous_failures = MAX_DNS_TCP_CONTINUOUS_FAILURES;
 int           dns_validate_qname              = 0;
-unsigned int  dns_handler_initialized         = 0;
 int           dns_ns_rr                       = 0;
-int           dns_ns_rr_init_down             = 1;
 char         *dns_ns_list                     = nullptr;
 char         *dns_resolv_conf                 = nullptr;
 char         *dns_local_ipv6                  = nullptr;
 char         *dns_local_ipv4                  = nullptr;
 int           dns_thread                      = 0;
+int           dns_handler_shards              = 1;
 int           dns_prefer_ipv6                 = 0;
 DNS_CONN_MODE dns_conn_mode                   = DNS_CONN_MODE::UDP_ONLY;
 
@@ -105,12 +104,43 @@ static DNSEntry *get_dns(DNSHandler *h, uint16_t id);
 static void dns_result(DNSHandler *h, DNSEntry *e, HostEnt *ent, bool retry, bool tcp_retry = false);
 static void write_dns(DNSHandler *h, bool tcp_retry = false);
 static bool write_dns_event(DNSHandler *h, DNSEntry *e, bool over_tcp = false);
-// "reliable" name to try. need to build up first.
-static int try_servers         = 0;
-static int local_num_entries   = 1;
-static int attempt_num_entries = 1;
-char       try_server_names[DEFAULT_NUM_TRY_SERVER][MAXDNAME];
 
+/** UDP requests built by write_dns(), sent with one sendmmsg(2) per name server when the batch is full or done.
+
+  With tens of thousands of queries in flight this saves a system call per query.
+*/
+class DNSQueryBatch
+{
+public:
+  static constexpr int MAX_QUERIES = 32;
+
+  void add(DNSHandler *h, DNSEntry *e, int ns);
+  /// @return false if a send failed, the rest of the batch is not sent then.
+  bool flush(DNSHandler *h);
+
+  int
+  size() const
+  {
+    return _size;
+  }
+
+  bool
+  full() const
+  {
+    return _size == MAX_QUERIES;
+  }
+
+private:
+  struct Query {
+    DNSEntry     *e;
+    int           ns;
+    int           len;
+    unsigned char buffer[MAX_DNS_REQUEST_LEN];
+  };
+
+  Query _queries[MAX_QUERIES];
+  int   _size = 0;
+};
 static inline char *
 strnchr(char *s, char c, int len)
 {
@@ -248,6 +278,7 @@ DNSProcessor::start(int, size_t stacksize)
     dns_resolv_conf = ats_stringdup(rec_str);
   }
   RecEstablishStaticConfigInt32(dns_thread, "proxy.config.dns.dedicated_thread");
+  RecEstablishStaticConfigInt32(dns_handler_shards, "proxy.config.dns.handler_shards");
   int dns_conn_mode_i = 0;
   RecEstablishStaticConfigInt32(dns_conn_mode_i, "proxy.config.dns.connection_mode");
   dns_conn_mode = static_cast<DNS_CONN_MODE>(dns_conn_mode_i);
@@ -256,12 +287,13 @@ DNSProcessor::start(int, size_t stacksize)
     // TODO: Hmmm, should we just get a single thread some other way?
     ET_DNS = eventProcessor.register_event_type("ET_DNS");
     eventProcessor.schedule_spawn(&initialize_thread_for_net, ET_DNS);
-    eventProcessor.spawn_event_threads(ET_DNS, 1, stacksize);
+    eventProcessor.spawn_event_threads(ET_DNS, std::max(dns_handler_shards, 1), stacksize);
   } else {
     // Initialize the first event thread for DNS.
     ET_DNS = ET_CALL;
   }
-  thread = eventProcessor.thread_group[ET_DNS]._thread[0];
+  auto &group = eventProcessor.thread_group[ET_DNS];
+  thread      = group._thread[0];
 
   dns_failover_try_period = dns_timeout + 1; // Modify the "default" accordingly
 
@@ -272,19 +304,27 @@ DNSProcessor::start(int, size_t stacksize)
   }
 
   // Setup the default DNSHandler, it's used both by normal DNS, and SplitDNS (for PTR lookups etc.)
+  // Further shards are spread over the threads of the group, 0 is one on each of them.
   dns_init();
-  open();
+  int n_shards = dns_handler_shards > 0 ? dns_handler_shards : group._count;
+  for (int i = 0; i < n_shards; ++i) {
+    shards.push_back(open(group._thread[i % group._count]));
+  }
+  Dbg(dbg_ctl_dns, "%d DNS handler shards on %d threads", n_shards, std::min(n_shards, group._count));
 
   return 0;
 }
 
-void
-DNSProcessor::open(sockaddr const *target)
+DNSHandler *
+DNSProcessor::open(EThread *t, sockaddr const *target)
 {
   DNSHandler *h = new DNSHandler;
 
-  h->mutex = thread->mutex;
-  h->m_res = &l_res;
+  h->thread = t;
+  h->mutex  = t->mutex;
+  // Queries take their ids from the resolver state, so every shard after the first gets a copy of its own.
+  // The search list of a copy still points into l_res, which does not change once dns_init is done.
+  h->m_res = handler ? new ts_imp_res_state(l_res) : &l_res;
   ats_ip_copy(&h->local_ipv4.sa, &local_ipv4.sa);
   ats_ip_copy(&h->local_ipv6.sa, &local_ipv6.sa);
 
@@ -294,12 +334,22 @@ DNSProcessor::open(sockaddr const *target)
     ats_ip_invalidate(&h->ip); // marked to use default.
   }
 
-  if (!dns_handler_initialized) {
+  if (!handler) {
     handler = h;
   }
 
   SET_CONTINUATION_HANDLER(h, &DNSHandler::startEvent);
-  thread->schedule_imm(h);
+  t->schedule_imm(h);
+  return h;
+}
+
+DNSHandler *
+DNSProcessor::shard_for(std::string_view name, int qtype) const
+{
+  if (shards.size() <= 1) {
+    return handler;
+  }
+  return shards[DNSEntry::NameLinkage::hash_of(DNSEntry::NameKey{name, qtype}) % shards.size()];
 }
 
 //
@@ -308,8 +358,9 @@ DNSProcessor::open(sockaddr const *target)
 void
 DNSProcessor::dns_init()
 {
-  gethostname(try_server_names[0], 255);
-  Dbg(dbg_ctl_dns, "localhost=%s", try_server_names[0]);
+  char localhost[MAXDNAME];
+  gethostname(localhost, sizeof(localhost));
+  Dbg(dbg_ctl_dns, "localhost=%s", localhost);
   Dbg(dbg_ctl_dns, "Round-robin nameservers = %d", dns_ns_rr);
 
   IpEndpoint nameserver[MAX_NAMED];
@@ -439,16 +490,6 @@ DNSEntry::init(DNSQueryData target, int qtype_arg, Continuation *acont, DNSProce
   action        = acont;
   submit_thread = acont->mutex->thread_holding;
 
-  if (SplitDNSConfig::gsplit_dns_enabled) {
-    dnsH = opt.handler ? opt.handler : dnsProcessor.handler;
-  } else {
-    dnsH = dnsProcessor.handler;
-  }
-
-  dnsH->txn_lookup_timeout = opt.timeout;
-
-  mutex = dnsH->mutex;
-
   if (is_addr_query(qtype) || qtype == T_SRV) {
     auto name = target.name.substr(0, MAXDNAME); // be sure of safe copy into @a qname
     memcpy(qname, name);
@@ -465,6 +506,16 @@ DNSEntry::init(DNSQueryData target, int qtype_arg, Continuation *acont, DNSProce
     }
   }
 
+  if (SplitDNSConfig::gsplit_dns_enabled && opt.handler) {
+    dnsH = opt.handler;
+  } else {
+    dnsH = dnsProcessor.shard_for(std::string_view{qname, static_cast<size_t>(qname_len)}, qtype);
+  }
+
+  dnsH->txn_lookup_timeout = opt.timeout;
+
+  mutex = dnsH->mutex;
+
   SET_HANDLER(&DNSEntry::mainEvent);
 }
 
@@ -512,7 +563,7 @@ bool
 DNSHandler::open_con(sockaddr const *target, bool failed, int icon, bool over_tcp)
 {
   ip_port_text_buffer ip_text;
-  PollDescriptor     *pd  = get_PollDescriptor(dnsProcessor.thread);
+  PollDescriptor     *pd  = get_PollDescriptor(thread);
   bool                ret = false;
 
   ink_assert(target != &ip.sa);
@@ -586,62 +637,56 @@ DNSHandler::startEvent(int /* event ATS_UNUSED */, Event *e)
 
   this->validate_ip();
 
-  if (!dns_handler_initialized) {
-    //
-    // If we are THE handler, open connection and configure for
-    // periodic execution.
-    //
-    dns_handler_initialized = 1;
-    SET_HANDLER(&DNSHandler::mainEvent);
-    if (dns_ns_rr) {
-      /* Round Robin mode:
-       *   Establish a connection to each DNS server to make it a connection pool.
-       *   For each DNS Request, a connection is picked up from the pool by round robin method.
-       *
-       *   The first DNS server is assigned to DNSHandler::ip within open_con() function.
-       */
-      int max_nscount = m_res->nscount;
-      if (max_nscount > MAX_NAMED) {
-        max_nscount = MAX_NAMED;
-      }
-      n_con = 0;
-      for (int i = 0; i < max_nscount; i++) {
-        ip_port_text_buffer buff;
-        sockaddr           *sa = &m_res->nsaddr_list[i].sa;
-        if (ats_is_ip(sa)) {
-          open_cons(sa, false, n_con);
-          ++n_con;
-          Dbg(dbg_ctl_dns_pas, "opened connection to %s, n_con = %d", ats_ip_nptop(sa, buff, sizeof(buff)), n_con);
-        }
+  //
+  // Every shard opens its own connections and is configured for
+  // periodic execution.
+  //
+  SET_HANDLER(&DNSHandler::mainEvent);
+  if (dns_ns_rr) {
+    /* Round Robin mode:
+     *   Establish a connection to each DNS server to make it a connection pool.
+     *   For each DNS Request, a connection is picked up from the pool by round robin method.
+     *
+     *   The first DNS server is assigned to DNSHandler::ip within open_con() function.
+     */
+    int max_nscount = m_res->nscount;
+    if (max_nscount > MAX_NAMED) {
+      max_nscount = MAX_NAMED;
+    }
+    n_con = 0;
+    for (int i = 0; i < max_nscount; i++) {
+      ip_port_text_buffer buff;
+      sockaddr           *sa = &m_res->nsaddr_list[i].sa;
+      if (ats_is_ip(sa)) {
+        open_cons(sa, false, n_con);
+        ++n_con;
+        Dbg(dbg_ctl_dns_pas, "opened connection to %s, n_con = %d", ats_ip_nptop(sa, buff, sizeof(buff)), n_con);
       }
-      dns_ns_rr_init_down = 0;
-    } else {
-      /* Primary - Secondary mode:
-       *   Establish a connection to the Primary DNS server.
-       *   It always send DNS requests to the Primary DNS server.
-       *   If the Primary DNS server dies,
-       *     - it will attempt to send DNS requests to the secondary DNS server until the Primary DNS server is back.
-       *     - and keep to detect the health of the Primary DNS server.
-       *   If DNSHandler::recv_dns() got a valid DNS response from the Primary DNS server,
-       *     - it means that the Primary DNS server returns.
-       *     - it send all DNS requests to the Primary DNS server.
-       *
-       *   The first DNS server is the Primary DNS server, and it is assigned to DNSHandler::ip within validate_ip() function.
-       */
-      open_cons(nullptr); // use current target address.
-      n_con = 1;
     }
-
-    // Retrying the name servers is something done periodically over the
-    // lifetime of the handler. This ensures that we don't miss retrying if it
-    // is necessary.
-    this->_dns_retry_event = this_ethread()->schedule_every(this, DNS_PRIMARY_RETRY_PERIOD);
-
-    return EVENT_CONT;
+    ns_rr_init_down = false;
   } else {
-    ink_assert(false); // I.e. this should never really happen
-    return EVENT_DONE;
+    /* Primary - Secondary mode:
+     *   Establish a connection to the Primary DNS server.
+     *   It always send DNS requests to the Primary DNS server.
+     *   If the Primary DNS server dies,
+     *     - it will attempt to send DNS requests to the secondary DNS server until the Primary DNS server is back.
+     *     - and keep to detect the health of the Primary DNS server.
+     *   If DNSHandler::recv_dns() got a valid DNS response from the Primary DNS server,
+     *     - it means that the Primary DNS server returns.
+     *     - it send all DNS requests to the Primary DNS server.
+     *
+     *   The first DNS server is the Primary DNS server, and it is assigned to DNSHandler::ip within validate_ip() function.
+     */
+    open_cons(nullptr); // use current target address.
+    n_con = 1;
   }
+
+  // Retrying the name servers is something done periodically over the
+  // lifetime of the handler. This ensures that we don't miss retrying if it
+  // is necessary.
+  this->_dns_retry_event = this_ethread()->schedule_every(this, DNS_PRIMARY_RETRY_PERIOD);
+
+  return EVENT_CONT;
 }
 
 /**
@@ -657,6 +702,8 @@ DNSHandler::startEvent_sdns(int /* event ATS_UNUSED */, Event *e)
   SET_HANDLER(&DNSHandler::mainEvent);
   open_cons(nullptr, false, 0);
   n_con = 1;
+  // SplitDNS handlers start up connected, like a round robin handler once its connections are open.
+  ns_rr_init_down = false;
 
   return EVENT_CONT;
 }
@@ -833,7 +880,7 @@ DNSHandler::rr_failure(int ndx)
     }
   }
 
-  if (all_down && !dns_ns_rr_init_down) {
+  if (all_down && !ns_rr_init_down) {
     Warning("connection to all DNS servers lost, retrying");
     // actual retries will be done in retry_named called from mainEvent
     // mark any outstanding requests as not sent for later retry
@@ -1061,35 +1108,18 @@ DNSHandler::mainEvent(int event, Event *e)
 inline static DNSEntry *
 get_dns(DNSHandler *h, uint16_t id)
 {
-  for (DNSEntry *e = h->entries.head; e; e = static_cast<DNSEntry *>(e->link.next)) {
-    if (e->once_written_flag) {
-      for (int j : e->id) {
-        if (j == id) {
-          return e;
-        } else if (j < 0) {
-          goto Lnext;
-        }
-      }
-    }
-  Lnext:;
+  if (auto spot = h->entries_by_id.find(id); spot != h->entries_by_id.end() && spot->second->once_written_flag) {
+    return spot->second;
   }
   return nullptr;
 }
 
 /** Find a DNSEntry by query name and type. */
 inline static DNSEntry *
-get_entry(DNSHandler *h, char *qname, int qtype)
+get_entry(DNSHandler *h, std::string_view qname, int qtype)
 {
-  for (DNSEntry *e = h->entries.head; e; e = static_cast<DNSEntry *>(e->link.next)) {
-    if (e->qtype == qtype) {
-      if (is_addr_query(qtype)) {
-        if (!strcmp(qname, e->qname)) {
-          return e;
-        }
-      } else if (0 == memcmp(qname, e->qname, e->qname_len)) {
-        return e;
-      }
-    }
+  if (auto spot = h->entries_by_name.find(DNSEntry::NameKey{qname, qtype}); spot != h->entries_by_name.end()) {
+    return &*spot;
   }
   return nullptr;
 }
@@ -1117,7 +1147,8 @@ write_dns(DNSHandler *h, bool tcp_retry)
   h->in_write_dns = true;
   bool over_tcp   = (dns_conn_mode == DNS_CONN_MODE::TCP_ONLY) || ((dns_conn_mode == DNS_CONN_MODE::TCP_RETRY) && tcp_retry);
   if (h->in_flight < dns_max_dns_in_flight) {
-    DNSEntry *e = h->entries.head;
+    DNSQueryBatch batch;
+    DNSEntry     *e = h->entries.head;
     while (e) {
       DNSEntry *n = static_cast<DNSEntry *>(e->link.next);
       if (!e->written_flag) {
@@ -1127,15 +1158,26 @@ write_dns(DNSHandler *h, bool tcp_retry)
             h->name_server = (h->name_server + 1) % max_nscount;
           } while (h->ns_down[h->name_server] && h->name_server != ns_start);
         }
-        if (h->ns_down[h->name_server] || !write_dns_event(h, e, over_tcp)) {
+        if (h->ns_down[h->name_server]) {
           break;
         }
+        if (over_tcp) {
+          if (!write_dns_event(h, e, over_tcp)) {
+            break;
+          }
+        } else {
+          batch.add(h, e, h->name_server);
+          if (batch.full() && !batch.flush(h)) {
+            break;
+          }
+        }
       }
-      if (h->in_flight >= dns_max_dns_in_flight) {
+      if (h->in_flight + batch.size() >= dns_max_dns_in_flight) {
         break;
       }
       e = n;
     }
+    batch.flush(h);
   }
   h->in_write_dns = false;
 }
@@ -1174,23 +1216,22 @@ DNSHandler::get_query_id()
 }
 
 /**
-  Construct and Write the request for a single entry (using send(3N)).
+  Construct the request for a single entry and give it a new query id.
 
-  @return true = keep going, false = give up for now.
+  @return The length of the request, 0 if it could not be built in which case the entry is done.
 
 */
-static bool
-write_dns_event(DNSHandler *h, DNSEntry *e, bool over_tcp)
+static int
+make_dns_query(DNSHandler *h, DNSEntry *e, unsigned char *buffer, bool over_tcp)
 {
-  unsigned char buffer[MAX_DNS_REQUEST_LEN];
-  int           offset = over_tcp ? tcp_data_length_offset : 0;
-  HEADER       *header = reinterpret_cast<HEADER *>(buffer + offset);
-  int           r      = 0;
+  int     offset = over_tcp ? tcp_data_length_offset : 0;
+  HEADER *header = reinterpret_cast<HEADER *>(buffer + offset);
+  int     r      = 0;
 
   if ((r = _ink_res_mkquery(h->m_res, e->qname, e->qtype, buffer, over_tcp)) <= 0) {
     Dbg(dbg_ctl_dns, "cannot build query: %s", e->qname);
     dns_result(h, e, nullptr, false);
-    return true;
+    return 0;
   }
 
   uint16_t i = h->get_query_id();
@@ -1200,40 +1241,23 @@ write_dns_event(DNSHandler *h, DNSEntry *e, bool over_tcp)
     h->release_query_id(e->id[dns_retries - e->retries]);
   }
   e->id[dns_retries - e->retries] = i;
-  UnixSocket con_sock             = over_tcp ? h->tcpcon[h->name_server].sock : h->udpcon[h->name_server].sock;
-  Dbg(dbg_ctl_dns, "send query (qtype=%d) for %s to fd %d", e->qtype, e->qname, con_sock.get_fd());
-
-  int s = con_sock.send(buffer, r, 0);
-  if (s != r) {
-    Dbg(dbg_ctl_dns, "send() failed: qname = %s, %d != %d, nameserver= %d", e->qname, s, r, h->name_server);
-
-    if (over_tcp) {
-      // add the counter for tcp connection failed
-      Dbg(dbg_ctl_dns, "tcp query failed: name_server = %d, tcp_continuous_failures = %d", h->name_server,
-          h->tcp_continuous_failures[h->name_server]);
-      ++h->tcp_continuous_failures[h->name_server];
-    }
-
-    // changed if condition from 'r < 0' to 's < 0' - 8/2001 pas
-    if (s < 0) {
-      if (dns_ns_rr) {
-        h->rr_failure(h->name_server);
-      } else {
-        h->failover();
-      }
-    }
-    return false;
-  }
+  h->entries_by_id[i]             = e;
+  return r;
+}
 
-  if (over_tcp && h->tcp_continuous_failures[h->name_server] > 0) {
+/** The request of @a e was sent to name server @a ns. */
+static void
+dns_query_sent(DNSHandler *h, DNSEntry *e, int ns, bool over_tcp)
+{
+  if (over_tcp && h->tcp_continuous_failures[ns] > 0) {
     // reset the counter for any tcp connection succeed
-    Dbg(dbg_ctl_dns, "reset tcp_continuous_failures: name_server = %d, tcp_continuous_failures = %d", h->name_server,
-        h->tcp_continuous_failures[h->name_server]);
-    h->tcp_continuous_failures[h->name_server] = 0;
+    Dbg(dbg_ctl_dns, "reset tcp_continuous_failures: name_server = %d, tcp_continuous_failures = %d", ns,
+        h->tcp_continuous_failures[ns]);
+    h->tcp_continuous_failures[ns] = 0;
   }
 
   e->written_flag      = true;
-  e->which_ns          = h->name_server;
+  e->which_ns          = ns;
   e->once_written_flag = true;
   ++h->in_flight;
   Metrics::Gauge::increment(dns_rsb.in_flight);
@@ -1250,11 +1274,131 @@ write_dns_event(DNSHandler *h, DNSEntry *e, bool over_tcp)
     e->timeout = h->mutex->thread_holding->schedule_in(e, HRTIME_SECONDS(dns_timeout));
   }
 
-  Dbg(dbg_ctl_dns, "sent qname = %s, id = %u, nameserver = %d", e->qname, e->id[dns_retries - e->retries], h->name_server);
-  h->sent_one();
+  Dbg(dbg_ctl_dns, "sent qname = %s, id = %u, nameserver = %d", e->qname, e->id[dns_retries - e->retries], ns);
+  h->sent_one(ns);
+}
+
+/** Sending the @a r bytes of the request of @a e to name server @a ns returned @a s. */
+static void
+dns_query_send_failed(DNSHandler *h, DNSEntry *e, int ns, int s, int r, bool over_tcp)
+{
+  Dbg(dbg_ctl_dns, "send() failed: qname = %s, %d != %d, nameserver= %d", e->qname, s, r, ns);
+
+  if (over_tcp) {
+    // add the counter for tcp connection failed
+    Dbg(dbg_ctl_dns, "tcp query failed: name_server = %d, tcp_continuous_failures = %d", ns, h->tcp_continuous_failures[ns]);
+    ++h->tcp_continuous_failures[ns];
+  }
+
+  // changed if condition from 'r < 0' to 's < 0' - 8/2001 pas
+  if (s < 0) {
+    if (dns_ns_rr) {
+      h->rr_failure(ns);
+    } else {
+      h->failover();
+    }
+  }
+}
+
+/**
+  Construct and Write the request for a single entry (using send(3N)).
+
+  @return true = keep going, false = give up for now.
+
+*/
+static bool
+write_dns_event(DNSHandler *h, DNSEntry *e, bool over_tcp)
+{
+  unsigned char buffer[MAX_DNS_REQUEST_LEN];
+  int           r = make_dns_query(h, e, buffer, over_tcp);
+  if (r == 0) {
+    return true;
+  }
+
+  UnixSocket con_sock = over_tcp ? h->tcpcon[h->name_server].sock : h->udpcon[h->name_server].sock;
+  Dbg(dbg_ctl_dns, "send query (qtype=%d) for %s to fd %d", e->qtype, e->qname, con_sock.get_fd());
+
+  int s = con_sock.send(buffer, r, 0);
+  if (s != r) {
+    dns_query_send_failed(h, e, h->name_server, s, r, over_tcp);
+    return false;
+  }
+
+  dns_query_sent(h, e, h->name_server, over_tcp);
   return true;
 }
 
+void
+DNSQueryBatch::add(DNSHandler *h, DNSEntry *e, int ns)
+{
+  Query &q = _queries[_size];
+  if ((q.len = make_dns_query(h, e, q.buffer, false)) == 0) {
+    return;
+  }
+  q.e  = e;
+  q.ns = ns;
+  ++_size;
+  Dbg(dbg_ctl_dns, "send query (qtype=%d) for %s to fd %d", e->qtype, e->qname, h->udpcon[ns].sock.get_fd());
+}
+
+bool
+DNSQueryBatch::flush(DNSHandler *h)
+{
+  bool ok                = true;
+  bool done[MAX_QUERIES] = {};
+  int  group[MAX_QUERIES];
+#ifdef HAVE_SENDMMSG
+  struct mmsghdr msgs[MAX_QUERIES];
+  struct iovec   iovs[MAX_QUERIES];
+#endif
+
+  // The requests are grouped by name server, which has a socket of its own.
+  for (int i = 0; ok && i < _size; ++i) {
+    if (done[i]) {
+      continue;
+    }
+    int ns    = _queries[i].ns;
+    int count = 0;
+    for (int j = i; j < _size; ++j) {
+      if (!done[j] && _queries[j].ns == ns) {
+        done[j] = true;
+#ifdef HAVE_SENDMMSG
+        iovs[count]                    = {_queries[j].buffer, static_cast<size_t>(_queries[j].len)};
+        msgs[count]                    = {};
+        msgs[count].msg_hdr.msg_iov    = &iovs[count];
+        msgs[count].msg_hdr.msg_iovlen = 1;
+#endif
+        group[count++] = j;
+      }
+    }
+
+    UnixSocket sock = h->udpcon[ns].sock;
+    for (int sent = 0; sent < count;) {
+#ifdef HAVE_SENDMMSG
+      int s = sock.sendmmsg(msgs + sent, count - sent, 0);
+#else
+      Query const &q = _queries[group[sent]];
+      int          s = sock.send(q.buffer, q.len, 0);
+      s              = s == q.len ? 1 : std::min(s, 0);
+#endif
+      if (s <= 0) {
+        Query const &q = _queries[group[sent]];
+        dns_query_send_failed(h, q.e, ns, s, q.len, false);
+        ok = false;
+        break;
+      }
+      for (int k = sent; k < sent + s; ++k) {
+        dns_query_sent(h, _queries[group[k]].e, ns, false);
+      }
+      sent += s;
+    }
+  }
+
+  // Requests left over when a send failed keep their ids and are written again later, like any unwritten entry.
+  _size = 0;
+  return ok;
+}
+
 int
 DNSEntry::delayEvent(int event, Event *e)
 {
@@ -1277,7 +1421,7 @@ DNSEntry::mainEvent(int event, Event *e)
     return EVENT_DONE;
   case EVENT_IMMEDIATE: {
     if (!dnsH) {
-      dnsH = dnsProcessor.handler;
+      dnsH = dnsProcessor.shard_for(std::string_view{qname, static_cast<size_t>(qname_len)}, qtype);
     }
     if (!dnsH) {
       Dbg(dbg_ctl_dns, "handler not found, retrying...");
@@ -1299,14 +1443,15 @@ DNSEntry::mainEvent(int event, Event *e)
       domains = nullptr;
     }
     Dbg(dbg_ctl_dns, "enqueuing query %s", qname);
-    DNSEntry *dup = get_entry(dnsH, qname, qtype);
+    DNSEntry *dup = get_entry(dnsH, std::string_view{qname, static_cast<size_t>(qname_len)}, qtype);
     if (dup) {
       Dbg(dbg_ctl_dns, "collapsing NS request");
       dup->dups.enqueue(this);
     } else {
       Dbg(dbg_ctl_dns, "adding first to collapsing queue");
       dnsH->entries.enqueue(this);
-      dnsProcessor.thread->schedule_imm(dnsH);
+      dnsH->entries_by_name.insert(this);
+      dnsH->thread->schedule_imm(dnsH);
     }
     return EVENT_DONE;
   }
@@ -1346,7 +1491,7 @@ DNSProcessor::getby(DNSQueryData x, int type, Continuation *cont, Options const
   e->init(x, type, cont, opt);
   MUTEX_TRY_LOCK(lock, e->mutex, this_ethread());
   if (!lock.is_locked()) {
-    thread->schedule_imm(e);
+    e->dnsH->thread->schedule_imm(e);
   } else {
     e->handleEvent(EVENT_IMMEDIATE, nullptr);
   }
@@ -1381,9 +1526,12 @@ dns_result(DNSHandler *h, DNSEntry *e, HostEnt *ent, bool retry, bool tcp_retry)
         if (e->orig_qname_len + strlen(*e->domains) + 2 > MAXDNAME) {
           Dbg(dbg_ctl_dns, "domain too large %.*s + %s", e->orig_qname_len, e->qname, *e->domains);
         } else {
+          // The name is the key of the entry, it is indexed again once changed.
+          h->entries_by_name.erase(e);
           e->qname[e->orig_qname_len] = '.';
           e->qname_len =
             e->orig_qname_len + 1 + ink_strlcpy(e->qname + e->orig_qname_len + 1, *e->domains, MAXDNAME - (e->orig_qname_len + 1));
+          h->entries_by_name.insert(e);
           ++(e->domains);
           e->retries = dns_retries;
           Dbg(dbg_ctl_dns, "new name = %s retries = %d", e->qname, e->retries);
@@ -1427,6 +1575,7 @@ dns_result(DNSHandler *h, DNSEntry *e, HostEnt *ent, bool retry, bool tcp_retry)
 
   // Remove head node from DNSHandler::entries queue
   h->entries.remove(e);
+  h->entries_by_name.erase(e);
   // Release Query ID from DNSHandler
   for (int i : e->id) {
     if (i < 0) {
@@ -1702,17 +1851,17 @@ dns_process(DNSHandler *handler, HostEnt *buf, int len)
     // Once it's full, a new entry get inputted into try_server_names round-
     // robin style every 50 success dns response.
 
-    if (local_num_entries >= DEFAULT_NUM_TRY_SERVER) {
-      if ((attempt_num_entries % 50) == 0) {
-        try_servers = (try_servers + 1) % countof(try_server_names);
-        ink_strlcpy(try_server_names[try_servers], e->qname, MAXDNAME);
-        attempt_num_entries = 0;
+    if (handler->local_num_entries >= DEFAULT_NUM_TRY_SERVER) {
+      if ((handler->attempt_num_entries % 50) == 0) {
+        handler->try_servers = (handler->try_servers + 1) % countof(handler->try_server_names);
+        ink_strlcpy(handler->try_server_names[handler->try_servers], e->qname, MAXDNAME);
+        handler->attempt_num_entries = 0;
       }
-      ++attempt_num_entries;
+      ++handler->attempt_num_entries;
     } else {
       // fill up try_server_names for try_primary_named
-      try_servers = local_num_entries++;
-      ink_strlcpy(try_server_names[try_servers], e->qname, MAXDNAME);
+      handler->try_servers = handler->local_num_entries++;
+      ink_strlcpy(handler->try_server_names[handler->try_servers], e->qname, MAXDNAME);
     }
 
     /* added for SRV support [ebalsa]
@@ -25,6 +25,8 @@
 
 #include <cstdint>
 #include <cstring>
+#include <string_view>
+#include <unordered_map>
 
 #include "iocore/dns/DNSProcessor.h"
 #include "P_DNSConnection.h"
@@ -45,6 +47,8 @@
 
 #include "tsutil/DbgCtl.h"
 
+#include <swoc/HashFNV.h>
+#include <swoc/IntrusiveHashMap.h>
 #include <swoc/IPEndpoint.h>
 
 #include "tsutil/Metrics.h"
@@ -148,6 +152,24 @@ struct DNSEntry : public Continuation {
   LINK(DNSEntry, dup_link);
   Que(DNSEntry, dup_link) dups;
 
+  /// What duplicate queries are collapsed by, the name as it is currently sent and the query type.
+  struct NameKey {
+    std::string_view name;
+    int              qtype;
+  };
+
+  /// Hash map descriptor class for the entries of a handler by name.
+  struct NameLinkage {
+    DNSEntry *_next = nullptr;
+    DNSEntry *_prev = nullptr;
+
+    static DNSEntry *&next_ptr(DNSEntry *e);
+    static DNSEntry *&prev_ptr(DNSEntry *e);
+    static uint64_t   hash_of(NameKey const &key);
+    static NameKey    key_of(DNSEntry const *e);
+    static bool       equal(NameKey const &lhs, NameKey const &rhs);
+  } _name_link;
+
   int  mainEvent(int event, Event *e);
   int  delayEvent(int event, Event *e);
   int  postAllEvent(int event, Event *e);
@@ -166,6 +188,36 @@ struct DNSEntry : public Continuation {
 
 using DNSEntryHandler = int (DNSEntry::*)(int, void *);
 
+inline DNSEntry *&
+DNSEntry::NameLinkage::next_ptr(DNSEntry *e)
+{
+  return e->_name_link._next;
+}
+
+inline DNSEntry *&
+DNSEntry::NameLinkage::prev_ptr(DNSEntry *e)
+{
+  return e->_name_link._prev;
+}
+
+inline uint64_t
+DNSEntry::NameLinkage::hash_of(NameKey const &key)
+{
+  return swoc::Hash64FNV1a().hash_immediate(key.name) + key.qtype;
+}
+
+inline DNSEntry::NameKey
+DNSEntry::NameLinkage::key_of(DNSEntry const *e)
+{
+  return {std::string_view{e->qname, static_cast<size_t>(e->qname_len)}, e->qtype};
+}
+
+inline bool
+DNSEntry::NameLinkage::equal(NameKey const &lhs, NameKey const &rhs)
+{
+  return lhs.qtype == rhs.qtype && lhs.name == rhs.name;
+}
+
 struct DNSEntry;
 
 /**
@@ -174,6 +226,8 @@ struct DNSEntry;
 
 */
 struct DNSHandler : public Continuation {
+  /// The thread the handler runs on, its connections are polled there.
+  EThread *thread = nullptr;
   /// This is used as the target if round robin isn't set.
   IpEndpoint           ip;
   IpEndpoint           local_ipv6; ///< Local V6 address if set.
@@ -184,6 +238,12 @@ struct DNSHandler : public Continuation {
   DNSConnection        udpcon[MAX_NAMED];
   Queue<DNSEntry>      entries;
   Queue<DNSConnection> triggered;
+
+  /// The entries queued on this handler by name, to collapse duplicate queries.
+  swoc::IntrusiveHashMap<DNSEntry::NameLinkage> entries_by_name;
+  /// The entry of every query id in use, replies are matched by it.
+  std::unordered_map<uint16_t, DNSEntry *> entries_by_id;
+
   int                  in_flight    = 0;
   int                  name_server  = 0;
   int                  in_write_dns = 0;
@@ -201,6 +261,15 @@ struct DNSHandler : public Continuation {
   ink_res_state m_res              = nullptr;
   int           txn_lookup_timeout = 0;
 
+  /// In round robin mode, whether all name servers are down because the connections are not open yet.
+  bool ns_rr_init_down = true;
+
+  // "reliable" names to try when probing a name server that is down, built up from the names resolved.
+  int  try_servers         = 0;
+  int  local_num_entries   = 1;
+  int  attempt_num_entries = 1;
+  char try_server_names[DEFAULT_NUM_TRY_SERVER][MAXDNAME];
+
   InkRand generator;
   // bitmap of query ids in use
   uint64_t qid_in_flight[(USHRT_MAX + 1) / 64];
@@ -212,12 +281,12 @@ struct DNSHandler : public Continuation {
   }
 
   void
-  sent_one()
+  sent_one(int i)
   {
-    ++failover_number[name_server];
-    Dbg(_dbg_ctl_dns, "sent_one: failover_number for resolver %d is %d", name_server, failover_number[name_server]);
-    if (failover_number[name_server] >= dns_failover_number && !crossed_failover_number[name_server]) {
-      crossed_failover_number[name_server] = ink_get_hrtime();
+    ++failover_number[i];
+    Dbg(_dbg_ctl_dns, "sent_one: failover_number for resolver %d is %d", i, failover_number[i]);
+    if (failover_number[i] >= dns_failover_number && !crossed_failover_number[i]) {
+      crossed_failover_number[i] = ink_get_hrtime();
     }
   }
 
@@ -260,6 +329,7 @@ struct DNSHandler : public Continuation {
   release_query_id(uint16_t qid)
   {
     qid_in_flight[qid >> 6] &= static_cast<uint64_t>(~(0x1ULL << (qid & 0x3F)));
+    entries_by_id.erase(qid);
   };
 
   void
@@ -333,6 +403,8 @@ DNSHandler::DNSHandler()
     udpcon[i].handler          = this;
   }
   memset(&qid_in_flight, 0, sizeof(qid_in_flight));
+  memset(try_server_names, 0, sizeof(try_server_names));
+  gethostname(try_server_names[0], sizeof(try_server_names[0]));
   SET_HANDLER(&DNSHandler::startEvent);
   Dbg(_dbg_ctl_net_epoll, "inline DNSHandler::DNSHandler()");
 }
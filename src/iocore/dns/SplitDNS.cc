@@ -487,14 +487,15 @@ SplitDNSRecord::Init(matcher_line *line_info)
                            ats_ip_ntop(&m_servers.x_server_ip[0].sa, ab, sizeof ab));
   }
 
-  dnsH->m_res = res;
-  dnsH->mutex = SplitDNSConfig::dnsHandler_mutex;
+  dnsH->m_res  = res;
+  dnsH->mutex  = SplitDNSConfig::dnsHandler_mutex;
+  dnsH->thread = eventProcessor.thread_group[ET_DNS]._thread[0];
   ats_ip_invalidate(&dnsH->ip.sa); // Mark to use default DNS.
 
   m_servers.x_dnsH = dnsH;
 
   SET_CONTINUATION_HANDLER(dnsH, &DNSHandler::startEvent_sdns);
-  eventProcessor.thread_group[ET_DNS]._thread[0]->schedule_imm(dnsH);
+  dnsH->thread->schedule_imm(dnsH);
 
   /* -----------------------------------------------------
      Process any modifiers to the directive, if they exist
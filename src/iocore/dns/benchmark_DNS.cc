@@ -0,0 +1,352 @@
+/** @file
+
+  Benchmark the DNS processor against a local stub resolver serving canned responses.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "iocore/dns/DNSProcessor.h"
+#include "iocore/eventsystem/Continuation.h"
+#include "iocore/eventsystem/EventProcessor.h"
+#include "iocore/eventsystem/EventSystem.h"
+#include "iocore/eventsystem/Lock.h"
+#include "iocore/eventsystem/RecProcess.h"
+#include "iocore/hostdb/HostDB.h"
+#include "iocore/hostdb/HostDBProcessor.h"
+#include "iocore/net/Net.h"
+#include "iocore/net/NetProcessor.h"
+#include "records/RecCore.h"
+#include "records/RecordsConfig.h"
+#include "swoc/swoc_file.h"
+#include "tscore/DiagsTypes.h"
+#include "tscore/Layout.h"
+
+#include <arpa/inet.h>
+#include <arpa/nameser.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if __has_include(<latch>)
+#include <latch>
+using latch = std::latch;
+#else
+struct latch {
+  int                     count;
+  std::mutex              m;
+  std::condition_variable cv;
+
+  latch(int count) : count(count) {}
+
+  void
+  wait()
+  {
+    std::unique_lock lock{m};
+    cv.wait(lock, [this] { return count == 0; });
+  }
+
+  void
+  count_down()
+  {
+    std::unique_lock lock{m};
+    if (0 == --count) {
+      cv.notify_all();
+    }
+  }
+};
+#endif
+
+namespace
+{
+/** A name server on the loopback interface that answers every A query with 127.0.0.1.
+ *
+ * It runs on threads of its own, each with a socket bound to the same port, so the time spent in the DNS
+ * processor is what the benchmark measures. The kernel spreads the sockets of the DNS handlers over them.
+ */
+class StubResolver
+{
+public:
+  explicit StubResolver(int n_threads)
+  {
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    for (int i = 0; i < n_threads; ++i) {
+      int       fd  = socket(AF_INET, SOCK_DGRAM, 0);
+      int       on  = 1;
+      socklen_t len = sizeof(addr);
+      if (fd < 0 || setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) < 0 ||
+          bind(fd, reinterpret_cast<sockaddr *>(&addr), len) < 0 ||
+          getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len) < 0) {
+        perror("stub resolver");
+        exit(1);
+      }
+      int rcvbuf = 8 * 1024 * 1024;
+      setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+      _fds.push_back(fd);
+    }
+    _port = ntohs(addr.sin_port);
+
+    for (int fd : _fds) {
+      _threads.emplace_back([this, fd] { serve(fd); });
+    }
+  }
+
+  ~StubResolver()
+  {
+    _stop = true;
+    for (auto &t : _threads) {
+      t.join();
+    }
+    for (int fd : _fds) {
+      close(fd);
+    }
+  }
+
+  int
+  port() const
+  {
+    return _port;
+  }
+
+  uint64_t
+  answered() const
+  {
+    return _answered;
+  }
+
+private:
+  void
+  serve(int fd)
+  {
+    unsigned char buffer[MAX_DNS_RESPONSE_LEN];
+    pollfd        pfd{fd, POLLIN, 0};
+
+    while (!_stop) {
+      if (poll(&pfd, 1, 100) <= 0) {
+        continue;
+      }
+      sockaddr_in from;
+      socklen_t   from_len = sizeof(from);
+      ssize_t     n        = recvfrom(fd, buffer, sizeof(buffer), 0, reinterpret_cast<sockaddr *>(&from), &from_len);
+      if (n < HFIXEDSZ) {
+        continue;
+      }
+      int len = answer(buffer, n);
+      if (len > 0) {
+        sendto(fd, buffer, len, 0, reinterpret_cast<sockaddr *>(&from), from_len);
+        ++_answered;
+      }
+    }
+  }
+
+  /// Turn the query in @a buffer into its canned response, @return the length of the response.
+  static int
+  answer(unsigned char *buffer, ssize_t n)
+  {
+    // Step over the question name, then its type and class.
+    ssize_t offset = HFIXEDSZ;
+    while (offset < n && buffer[offset] != 0) {
+      offset += buffer[offset] + 1;
+    }
+    offset += 1 + QFIXEDSZ;
+    if (offset > n) {
+      return 0;
+    }
+
+    static constexpr unsigned char record[] = {
+      0xc0, 0x0c,             // name, pointer to the question
+      0x00, 0x01, 0x00, 0x01, // A, IN
+      0x00, 0x00, 0x0e, 0x10, // TTL
+      0x00, 0x04, 127,  0,    0, 1,
+    };
+    buffer[2] |= 0x80; // QR
+    buffer[3]  = 0x80; // RA, NOERROR
+    buffer[6]  = 0;
+    buffer[7]  = 1; // ANCOUNT
+    memset(buffer + 8, 0, 4);
+    memcpy(buffer + offset, record, sizeof(record));
+    return offset + sizeof(record);
+  }
+
+  std::vector<int>         _fds;
+  int                      _port = 0;
+  std::atomic<bool>        _stop{false};
+  std::atomic<uint64_t>    _answered{0};
+  std::vector<std::thread> _threads;
+};
+
+/// Looks up @a total names, keeping @a concurrency of them in flight.
+struct Lookups : Continuation {
+  int    client;
+  int    total;
+  int    concurrency;
+  int    distinct;
+  int    started  = 0;
+  int    finished = 0;
+  int    failed   = 0;
+  latch &done;
+
+  Lookups(int client, int total, int concurrency, int distinct, latch &done)
+    : Continuation(new_ProxyMutex()), client(client), total(total), concurrency(concurrency), distinct(distinct), done(done)
+  {
+    SET_HANDLER(&Lookups::handle_event);
+  }
+
+  void
+  start_one()
+  {
+    char name[64];
+    int  n = snprintf(name, sizeof(name), "host-%d-%d.bench.test", client, started++ % distinct);
+    dnsProcessor.gethostbyname(this, std::string_view{name, static_cast<size_t>(n)}, DNSProcessor::Options{});
+  }
+
+  int
+  handle_event(int event, void *data)
+  {
+    if (event == DNS_EVENT_LOOKUP) {
+      if (data == nullptr) {
+        ++failed;
+      }
+      if (++finished == total) {
+        done.count_down();
+        return EVENT_DONE;
+      }
+      if (started < total) {
+        start_one();
+      }
+      return EVENT_DONE;
+    }
+
+    while (started < total && started < concurrency) {
+      start_one();
+    }
+    return EVENT_DONE;
+  }
+};
+
+constexpr int CLIENT_THREADS = 4;
+
+std::string
+temp_prefix()
+{
+  char            buffer[PATH_MAX];
+  std::error_code err;
+  const char     *tmpdir = getenv("TMPDIR");
+  if (tmpdir == nullptr) {
+    tmpdir = "/tmp";
+  }
+  snprintf(buffer, sizeof(buffer), "%s/dnsbench.XXXXXX", tmpdir);
+  auto prefix = swoc::file::path(mkdtemp(buffer));
+  swoc::file::create_directories(prefix / "var" / "trafficserver", err, 0755);
+  return prefix.string();
+}
+
+void
+init_ts(int port, int shards, int in_flight)
+{
+  DiagsPtr::set(new Diags("dns_benchmark", "", "", new BaseLogFile("stderr")));
+  swoc::file::path prefix = temp_prefix();
+
+  Layout::create(prefix.view());
+  RecProcessInit(diags());
+  LibRecordsConfigInit();
+
+  std::string nameserver = "127.0.0.1:" + std::to_string(port);
+  RecSetRecordString("proxy.config.dns.nameservers", nameserver.data(), REC_SOURCE_EXPLICIT);
+  RecSetRecordInt("proxy.config.dns.search_default_domains", 0, REC_SOURCE_EXPLICIT);
+  RecSetRecordInt("proxy.config.dns.max_dns_in_flight", in_flight, REC_SOURCE_EXPLICIT);
+  RecSetRecordInt("proxy.config.dns.dedicated_thread", 1, REC_SOURCE_EXPLICIT);
+  RecSetRecordInt("proxy.config.dns.handler_shards", shards, REC_SOURCE_EXPLICIT);
+
+  ink_event_system_init(ts::ModuleVersion(1, 0, ts::ModuleVersion::PRIVATE));
+  ink_net_init(ts::ModuleVersion(1, 0, ts::ModuleVersion::PRIVATE));
+  ink_dns_init(HOSTDB_MODULE_PUBLIC_VERSION);
+
+  netProcessor.init();
+  eventProcessor.start(CLIENT_THREADS);
+  dnsProcessor.start(0, 1024 * 1024);
+
+  EThread *thread = new EThread();
+  thread->set_specific();
+  init_buffer_allocators(0);
+}
+
+} // end anonymous namespace
+
+/** benchmark_DNS [lookups [concurrency [shards [distinct names]]]]
+ *
+ * Every shard gets a dedicated DNS thread. The lookups are made from the event threads, by one client on each,
+ * and each client looks up names of its own. With fewer distinct names than lookups, queries for the same name
+ * are collapsed by the processor.
+ */
+int
+main(int argc, char **argv)
+{
+  int total       = argc > 1 ? atoi(argv[1]) : 400000;
+  int concurrency = argc > 2 ? atoi(argv[2]) : 20000;
+  int shards      = argc > 3 ? atoi(argv[3]) : 1;
+  int distinct    = argc > 4 ? atoi(argv[4]) : total;
+
+  total -= total % CLIENT_THREADS;
+
+  StubResolver stub{std::max(shards, 1)};
+  init_ts(stub.port(), shards, concurrency);
+
+  latch                                 done{CLIENT_THREADS};
+  std::vector<std::unique_ptr<Lookups>> clients;
+  for (int i = 0; i < CLIENT_THREADS; ++i) {
+    clients.push_back(std::make_unique<Lookups>(i, total / CLIENT_THREADS, concurrency / CLIENT_THREADS,
+                                                std::max(distinct / CLIENT_THREADS, 1), done));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < CLIENT_THREADS; ++i) {
+    eventProcessor.thread_group[ET_CALL]._thread[i]->schedule_imm(clients[i].get());
+  }
+  done.wait();
+  std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+
+  int failed = 0;
+  for (auto const &c : clients) {
+    failed += c->failed;
+  }
+  printf("lookups: %d concurrency: %d shards: %d distinct names: %d\n", total, concurrency, shards, distinct);
+  printf("failed: %d queries answered: %" PRIu64 "\n", failed, stub.answered());
+  printf("time: %f s, %.0f lookups/s\n", d.count(), total / d.count());
+}
+
+class HttpSessionAccept;
+HttpSessionAccept *plugin_http_accept = nullptr;
@@ -144,10 +144,14 @@ IOUringContext::get_wq_max_workers()
   return std::make_pair(args[0], args[1]);
 }
 
-void
+int
 IOUringContext::submit()
 {
-  Metrics::Counter::increment(io_uring_rsb.io_uring_submitted, io_uring_submit(&ring));
+  int count = io_uring_submit(&ring);
+  if (count > 0) {
+    Metrics::Counter::increment(io_uring_rsb.io_uring_submitted, count);
+  }
+  return count;
 }
 
 void
@@ -0,0 +1,211 @@
+/** @file
+
+  Socket reads and writes of a UnixNetVConnection submitted through io_uring.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_IOUringNetOp.h"
+#if TS_USE_LINUX_IO_URING
+#include "P_UnixNetVConnection.h"
+#include "iocore/net/NetHandler.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+DbgCtl dbg_ctl_iocore_net_uring{"iocore_net_uring"};
+
+/// Copy @a len bytes at @a src to the space of @a writer that is not filled yet, @a at bytes into that space.
+void
+copy_unfilled(MIOBuffer *writer, int64_t at, const char *src, int64_t len)
+{
+  ink_assert(writer->current_write_avail() >= at + len);
+  IOBufferBlock *b = writer->first_write_block();
+  while (at >= b->write_avail()) {
+    at -= b->write_avail();
+    b   = b->next.get();
+  }
+  char *dst = b->end() + at;
+  while (len > 0) {
+    if (dst == b->buf_end()) {
+      b   = b->next.get();
+      dst = b->end();
+    }
+    int64_t n = std::min(len, static_cast<int64_t>(b->buf_end() - dst));
+    memcpy(dst, src, n);
+    dst += n;
+    src += n;
+    len -= n;
+  }
+}
+
+} // end anonymous namespace
+
+bool
+IOUringNetOp::add(IOBufferBlock *b, char *start, int64_t len)
+{
+  ink_assert(_state == State::IDLE);
+  if (_niov >= MAX_IOV) {
+    return false;
+  }
+  _iov[_niov]    = IOVec(start, len);
+  _blocks[_niov] = b;
+  ++_niov;
+  return true;
+}
+
+bool
+IOUringNetOp::queue(int fd)
+{
+  ink_assert(_state == State::IDLE && _niov > 0);
+
+  io_uring_sqe *sqe = IOUringContext::local_context()->next_sqe(this);
+  if (sqe == nullptr) {
+    return false;
+  }
+
+  _msg            = {};
+  _msg.msg_iov    = _iov;
+  _msg.msg_iovlen = _niov;
+  if (_write) {
+    io_uring_prep_sendmsg(sqe, fd, &_msg, MSG_DONTWAIT);
+  } else {
+    io_uring_prep_recvmsg(sqe, fd, &_msg, MSG_DONTWAIT);
+  }
+  _state = State::IN_FLIGHT;
+  return true;
+}
+
+void
+IOUringNetOp::adopt(UnixNetVConnection *vc)
+{
+  ink_assert(_state != State::IN_FLIGHT);
+  _vc = vc;
+}
+
+void
+IOUringNetOp::orphan()
+{
+  _vc = nullptr;
+  if (_state != State::IN_FLIGHT) {
+    delete this;
+  }
+}
+
+void
+IOUringNetOp::handle_complete(io_uring_cqe *cqe)
+{
+  if (_vc == nullptr) {
+    delete this;
+    return;
+  }
+
+  _result = cqe->res;
+  _state  = State::COMPLETE;
+  Dbg(dbg_ctl_iocore_net_uring, "vc=%p %s complete: %" PRId64, _vc, _write ? "sendmsg" : "recvmsg", _result);
+
+  // The result is picked up by net_read_io / net_write_io, just as if epoll had flagged the socket.
+  NetHandler *nh = _vc->nh;
+  if (_write) {
+    _vc->write.triggered = 1;
+    if (_vc->write.enabled) {
+      nh->write_ready_list.in_or_enqueue(_vc);
+    }
+  } else {
+    _vc->read.triggered = 1;
+    if (_vc->read.enabled) {
+      nh->read_ready_list.in_or_enqueue(_vc);
+    }
+  }
+}
+
+int64_t
+IOUringNetOp::take(MIOBuffer *writer, int64_t max)
+{
+  ink_assert(!_write && _state == State::COMPLETE && max > 0 && max <= writer->current_write_avail());
+
+  if (_carry) {
+    int64_t n = std::min(_carry_len - _carry_off, max);
+    copy_unfilled(writer, 0, _carry.get() + _carry_off, n);
+    _carry_off += n;
+    if (_carry_off == _carry_len) {
+      reset();
+    }
+    return n;
+  }
+
+  int64_t r = _result;
+  if (r <= 0) {
+    reset();
+    return r;
+  }
+
+  // The data is already where fill() expects it, unless the read buffer was replaced while the read was in flight.
+  int64_t n        = std::min(r, max);
+  bool    in_place = writer->first_write_block()->end() == _iov[0].iov_base;
+  if (n < r) {
+    _carry     = std::make_unique<char[]>(r - n);
+    _carry_len = r - n;
+    _carry_off = 0;
+  }
+  int64_t off = 0;
+  for (int i = 0; off < r; ++i) {
+    const char *src  = static_cast<const char *>(_iov[i].iov_base);
+    int64_t     len  = std::min(r - off, static_cast<int64_t>(_iov[i].iov_len));
+    int64_t     head = std::clamp(n - off, int64_t{0}, len);
+    if (head > 0 && !in_place) {
+      copy_unfilled(writer, off, src, head);
+    }
+    if (head < len) {
+      memcpy(_carry.get() + off + head - n, src + head, len - head);
+    }
+    off += len;
+  }
+  Dbg(dbg_ctl_iocore_net_uring, "vc=%p took %" PRId64 " of %" PRId64 "%s", _vc, n, r, in_place ? "" : ", copied");
+
+  if (_carry) {
+    _release_blocks();
+  } else {
+    reset();
+  }
+  return n;
+}
+
+void
+IOUringNetOp::_release_blocks()
+{
+  for (int i = 0; i < _niov; ++i) {
+    _blocks[i] = nullptr;
+  }
+  _niov = 0;
+}
+
+void
+IOUringNetOp::reset()
+{
+  _release_blocks();
+  _carry.reset();
+  _carry_len = 0;
+  _carry_off = 0;
+  _result    = 0;
+  _state     = State::IDLE;
+}
+#endif
@@ -125,6 +125,8 @@ register_net_stats()
   net_rsb.write_bytes                      = Metrics::Counter::createPtr("proxy.process.net.write_bytes");
   net_rsb.write_bytes_count                = Metrics::Counter::createPtr("proxy.process.net.write_bytes_count");
   net_rsb.connection_tracker_table_size    = Metrics::Gauge::createPtr("proxy.process.net.connection_tracker_table_size");
+  net_rsb.zerocopy_writes                  = Metrics::Counter::createPtr("proxy.process.net.zerocopy_writes");
+  net_rsb.zerocopy_copied                  = Metrics::Counter::createPtr("proxy.process.net.zerocopy_copied");
 }
 
 void
@@ -38,6 +38,11 @@ namespace
 DbgCtl dbg_ctl_net_queue{"net_queue"};
 DbgCtl dbg_ctl_v_net_queue{"v_net_queue"};
 
+#if TS_USE_LINUX_IO_URING
+// Passes over the ready lists for the io_uring socket ops completed in one loop.
+constexpr int IO_URING_NET_PASSES = 4;
+#endif
+
 } // end anonymous namespace
 
 std::atomic<int32_t>  NetHandler::additional_accepts{0};
@@ -140,6 +145,9 @@ NetHandler::update_nethandler_config(const char *str, RecDataT, RecData data, vo
   } else if (name == "proxy.config.net.default_inactivity_timeout"sv) {
     updated_member = &NetHandler::global_config.default_inactivity_timeout;
     Dbg(dbg_ctl_net_queue, "proxy.config.net.default_inactivity_timeout updated to %" PRId64, data.rec_int);
+  } else if (name == "proxy.config.net.zerocopy_min_write_size_in"sv) {
+    updated_member = &NetHandler::global_config.zerocopy_min_write_size_in;
+    Dbg(dbg_ctl_net_queue, "proxy.config.net.zerocopy_min_write_size_in updated to %" PRId64, data.rec_int);
   } else if (name == "proxy.config.net.additional_accepts"sv) {
     NetHandler::additional_accepts.store(data.rec_int, std::memory_order_relaxed);
     Dbg(dbg_ctl_net_queue, "proxy.config.net.additional_accepts updated to %" PRId64, data.rec_int);
@@ -183,6 +191,7 @@ NetHandler::init_for_process()
   global_config.keep_alive_no_activity_timeout_in =
     RecGetRecordInt("proxy.config.net.keep_alive_no_activity_timeout_in").value_or(0);
   global_config.default_inactivity_timeout = RecGetRecordInt("proxy.config.net.default_inactivity_timeout").value_or(0);
+  global_config.zerocopy_min_write_size_in = RecGetRecordInt("proxy.config.net.zerocopy_min_write_size_in").value_or(0);
 
   // Atomic configurations.
   {
@@ -196,12 +205,17 @@ NetHandler::init_for_process()
     per_client_max_connections_in.store(val, std::memory_order_relaxed);
   }
 
+#if TS_USE_LINUX_IO_URING
+  io_uring_net_configured = RecGetRecordInt("proxy.config.io_uring.net_io").value_or(0) != 0;
+#endif
+
   RecRegisterConfigUpdateCb("proxy.config.net.max_connections_in", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.max_requests_in", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.inactive_threshold_in", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.transaction_no_activity_timeout_in", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.keep_alive_no_activity_timeout_in", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.default_inactivity_timeout", update_nethandler_config, nullptr);
+  RecRegisterConfigUpdateCb("proxy.config.net.zerocopy_min_write_size_in", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.additional_accepts", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.per_client.max_connections_in", update_nethandler_config, nullptr);
 
@@ -213,6 +227,7 @@ NetHandler::init_for_process()
   Dbg(dbg_ctl_net_queue, "proxy.config.net.keep_alive_no_activity_timeout_in updated to %d",
       global_config.keep_alive_no_activity_timeout_in);
   Dbg(dbg_ctl_net_queue, "proxy.config.net.default_inactivity_timeout updated to %d", global_config.default_inactivity_timeout);
+  Dbg(dbg_ctl_net_queue, "proxy.config.net.zerocopy_min_write_size_in updated to %d", global_config.zerocopy_min_write_size_in);
   Dbg(dbg_ctl_net_queue, "proxy.config.net.additional_accepts updated to %d", additional_accepts.load(std::memory_order_relaxed));
   Dbg(dbg_ctl_net_queue, "proxy.config.net.per_client.max_connections_in updated to %d",
       per_client_max_connections_in.load(std::memory_order_relaxed));
@@ -380,6 +395,15 @@ NetHandler::waitForActivity(ink_hrtime timeout)
   this->thread->metrics.current_slice.load(std::memory_order_acquire)->record_io_stats(poll_time, process_time);
 
 #if TS_USE_LINUX_IO_URING
+  // Hand the socket reads and writes queued by process_ready_list to the kernel in a single submit. They complete
+  // without blocking, so their VCs pick up the results in this loop rather than after another poll. That can queue
+  // more ops, which are followed for a few passes.
+  if (io_uring_net) {
+    for (int pass = 0; ur->submit() > 0 && pass < IO_URING_NET_PASSES; ++pass) {
+      ur->service();
+      process_ready_list();
+    }
+  }
   ur->service();
 #endif
 
@@ -0,0 +1,128 @@
+/** @file
+
+  Socket reads and writes of a UnixNetVConnection submitted through io_uring.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+#include "tscore/ink_config.h"
+#if TS_USE_LINUX_IO_URING
+#include "iocore/eventsystem/IOBuffer.h"
+#include "iocore/io_uring/IO_URING.h"
+#include "tscore/ink_memory.h"
+
+#include <sys/socket.h>
+
+#include <memory>
+
+class UnixNetVConnection;
+
+/** A recvmsg or sendmsg of a UnixNetVConnection submitted to the thread's @c IOUringContext.
+
+    Ops are queued by @c net_read_io and @c net_write_io while the ready lists are processed and the NetHandler submits
+    them together at the end of its loop. The socket is known to be ready and the op is flagged @c MSG_DONTWAIT, so the
+    kernel completes it during that submit instead of parking it, and the completion puts the VC back on its ready list
+    to pick up the result on the next loop.
+
+    The op holds references to the IOBuffer blocks it transfers, so a VC freed while the op is in flight can orphan it
+    and the op deletes itself when its completion arrives.
+
+    A completed read is handed to the read VIO by @c take, which may want less than was read if the VIO changed while
+    the read was in flight. The rest is copied out of the read buffer and kept by the op for the next @c take.
+ */
+class IOUringNetOp final : public IOUringCompletionHandler
+{
+public:
+  enum class State { IDLE, IN_FLIGHT, COMPLETE };
+
+  /// Maximum number of IOBuffer block segments transferred by one op.
+  static constexpr int MAX_IOV = 16;
+
+  IOUringNetOp(UnixNetVConnection *vc, bool write) : _vc(vc), _write(write) {}
+
+  /// Add @a len bytes at @a start, which is in block @a b. Returns @c false if the op has no iovec left.
+  bool add(IOBufferBlock *b, char *start, int64_t len);
+
+  /// Queue the transfer of the added segments on @a fd. Returns @c false if the ring has no room.
+  bool queue(int fd);
+
+  /// Drop the segments and the result, making the op available for the next transfer.
+  void reset();
+
+  /** Hand at most @a max bytes of a completed read to @a writer.
+
+      The bytes are placed in the space of @a writer that is not filled yet, for the caller to @c fill, so @a max must
+      not be more than that space. Returns their
+      number, or the result of the read if it failed or hit the end of the stream. The op is reset once everything it
+      read has been taken.
+   */
+  int64_t take(MIOBuffer *writer, int64_t max);
+
+  /// Give a completed op to @a vc, the connection moved to it. An op in flight cannot move.
+  void adopt(UnixNetVConnection *vc);
+
+  /// Detach the op from its VC. An idle op is deleted, one in flight deletes itself on completion.
+  void orphan();
+
+  void handle_complete(io_uring_cqe *cqe) override;
+
+  State
+  state() const
+  {
+    return _state;
+  }
+
+  /// Bytes transferred or -errno, once the op is complete.
+  int64_t
+  result() const
+  {
+    return _result;
+  }
+
+  int
+  niov() const
+  {
+    return _niov;
+  }
+
+  const IOVec &
+  iov(int i) const
+  {
+    return _iov[i];
+  }
+
+private:
+  UnixNetVConnection *_vc;
+  bool                _write;
+  State               _state  = State::IDLE;
+  int64_t             _result = 0;
+  int                 _niov   = 0;
+  msghdr              _msg{};
+  IOVec               _iov[MAX_IOV];
+  Ptr<IOBufferBlock>  _blocks[MAX_IOV];
+
+  // Read data not taken yet, kept out of the read buffer which may be written to in the meantime.
+  std::unique_ptr<char[]> _carry;
+  int64_t                 _carry_len = 0;
+  int64_t                 _carry_off = 0;
+
+  void _release_blocks();
+};
+#endif
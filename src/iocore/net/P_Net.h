@@ -78,6 +78,8 @@ struct NetStatsBlock {
   Metrics::Counter::AtomicType *tcp_accept;
   Metrics::Counter::AtomicType *write_bytes;
   Metrics::Counter::AtomicType *write_bytes_count;
+  Metrics::Counter::AtomicType *zerocopy_writes;
+  Metrics::Counter::AtomicType *zerocopy_copied;
   Metrics::Gauge::AtomicType   *connection_tracker_table_size;
 };
 
@@ -38,6 +38,7 @@
 #include "iocore/net/NetVConnection.h"
 #include "P_Connection.h"
 #include "P_NetAccept.h"
+#include "P_ZeroCopy.h"
 #include "iocore/net/NetEvent.h"
 
 #if defined(HAVE_STRUCT_MPTCP_INFO_SUBFLOWS)
@@ -47,6 +48,9 @@
 class UnixNetVConnection;
 class NetHandler;
 struct PollDescriptor;
+#if TS_USE_LINUX_IO_URING
+class IOUringNetOp;
+#endif
 
 // WARNING:  many or most of the member functions of UnixNetVConnection should only be used when it is instantiated
 // directly.  They should not be used when UnixNetVConnection is a base class.
@@ -151,6 +155,7 @@ public:
   virtual void net_read_io(NetHandler *nh) override;
   virtual void net_write_io(NetHandler *nh) override;
   virtual void free_thread(EThread *t) override;
+  void         set_error_from_socket() override;
   virtual int
   close() override
   {
@@ -253,6 +258,24 @@ private:
   // Called by make_tunnel_endpiont() when the far end of the TCP connection is the passive/server end.
   virtual void _out_context_tunnel();
 
+#if TS_USE_LINUX_IO_URING
+  // Socket reads and writes done through the thread's io_uring, see @c NetHandler::io_uring_net. These return false if
+  // the op could not be queued and the syscall should be made instead, otherwise @a r is the result or -EINPROGRESS.
+  bool _io_uring_recv(MIOBufferAccessor &buf, int64_t toread, int64_t &r);
+  bool _io_uring_send(int64_t towrite, MIOBufferAccessor &buf, int64_t &total_written, int64_t &r);
+  void _release_io_uring_ops();
+
+  IOUringNetOp *_io_uring_read_op  = nullptr;
+  IOUringNetOp *_io_uring_write_op = nullptr;
+#endif
+
+  /// Release the blocks of the MSG_ZEROCOPY writes the kernel is done with.
+  void _reap_zerocopy();
+
+  /// Blocks of MSG_ZEROCOPY writes not yet released by the kernel. Allocated by the first write large enough for zero
+  /// copy and deleted in free_thread(), the allocator of this class does not run destructors.
+  ZeroCopyTracker *_zerocopy = nullptr;
+
   inline static DbgCtl _dbg_ctl_socket{"socket"};
   inline static DbgCtl _dbg_ctl_socket_mptcp{"socket_mptcp"};
 
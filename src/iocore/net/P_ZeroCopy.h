@@ -0,0 +1,81 @@
+/** @file
+
+  MSG_ZEROCOPY socket writes.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "iocore/eventsystem/IOBuffer.h"
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+struct Connection;
+
+/** The IOBuffer blocks of the MSG_ZEROCOPY writes on a socket, held until the kernel is done with them.
+
+    The kernel numbers the successful zero copy sends on a socket from 0 and reports their completion as ranges of those
+    numbers on the socket's error queue, which raises EPOLLERR. Until then the pages are still referenced by the
+    socket's send queue and must not be reused, so the blocks are pinned here instead of being released when the reader
+    consumes them.
+ */
+class ZeroCopyTracker
+{
+public:
+  /// Blocks of a single send.
+  using Blocks = std::vector<Ptr<IOBufferBlock>>;
+
+  /// Turn on SO_ZEROCOPY for @a fd, once. Returns @c false if zero copy sends are not usable on the socket.
+  bool enable(int fd);
+
+  /// Record the blocks of the zero copy send just made on the socket.
+  void sent(Blocks &&blocks);
+
+  /// Reap completions from the error queue of @a fd and release the blocks of the sends they cover.
+  void reap(int fd);
+
+  /// Sends whose completion has not been reaped yet.
+  bool
+  pending() const
+  {
+    return !_sends.empty();
+  }
+
+  /** Keep the socket of @a con open until the pending sends of @a tracker complete, then close it and delete @a tracker.
+
+      Closing a socket does not discard its send queue, which still references the pinned pages. If the sends do not
+      complete within a few seconds, the connection is reset, which does discard it, before the blocks are released.
+   */
+  static void linger(Connection &con, ZeroCopyTracker *tracker);
+
+private:
+  struct Send {
+    uint32_t id;
+    Blocks   blocks;
+  };
+
+  enum class State : uint8_t { UNKNOWN, ENABLED, UNUSABLE };
+
+  std::deque<Send> _sends;
+  uint32_t         _next_id = 0;
+  State            _state   = State::UNKNOWN;
+};
@@ -41,6 +41,9 @@ ink_hrtime last_transient_accept_error;
 NetHandler::Config                                     NetHandler::global_config;
 std::bitset<std::numeric_limits<unsigned int>::digits> NetHandler::active_thread_types;
 const std::bitset<NetHandler::CONFIG_ITEM_COUNT>       NetHandler::config_value_affects_per_thread_value{0x3};
+#if TS_USE_LINUX_IO_URING
+bool NetHandler::io_uring_net_configured = false;
+#endif
 
 namespace
 {
@@ -186,6 +189,17 @@ initialize_thread_for_net(EThread *thread)
 
   thread->set_tail_handler(nh);
 
+#if TS_USE_LINUX_IO_URING
+  if (NetHandler::io_uring_net_configured) {
+    IOUringContext *ur = IOUringContext::local_context();
+    nh->io_uring_net   = ur->valid() && ur->supports_op(IORING_OP_RECVMSG) && ur->supports_op(IORING_OP_SENDMSG);
+    static std::atomic<bool> warned{false};
+    if (!nh->io_uring_net && !warned.exchange(true)) {
+      Warning("io_uring does not support the socket IO ops, network IO falls back to epoll");
+    }
+  }
+#endif
+
 #if HAVE_EVENTFD
 #if TS_USE_LINUX_IO_URING
   auto ep = new IOUringEventIO();
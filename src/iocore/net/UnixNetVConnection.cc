@@ -31,6 +31,11 @@
 #include "tscore/InkErrno.h"
 #include "tscore/ink_atomic.h"
 
+#if TS_USE_LINUX_IO_URING
+#include "P_IOUringNetOp.h"
+#endif
+
+#include <algorithm>
 #include <termios.h>
 #include <utility>
 
@@ -492,6 +497,9 @@ UnixNetVConnection::net_read_io(NetHandler *nh)
     this->nh->free_netevent(this);
     return;
   }
+
+  _reap_zerocopy();
+
   // if it is not enabled.
   if (!s->enabled || s->vio.op != VIO::READ || s->vio.is_disabled()) {
     read_disable(nh, this);
@@ -517,50 +525,61 @@ UnixNetVConnection::net_read_io(NetHandler *nh)
   unsigned niov = 0;
   IOVec    tiovec[NET_MAX_IOV];
   if (toread) {
-    IOBufferBlock *b = buf.writer()->first_write_block();
-    do {
-      niov       = 0;
-      rattempted = 0;
-      while (b && niov < NET_MAX_IOV) {
-        int64_t a = b->write_avail();
-        if (a > 0) {
-          tiovec[niov].iov_base = b->_end;
-          int64_t togo          = toread - total_read - rattempted;
-          if (a > togo) {
-            a = togo;
-          }
-          tiovec[niov].iov_len  = a;
-          rattempted           += a;
-          niov++;
-          if (a >= togo) {
-            break;
+#if TS_USE_LINUX_IO_URING
+    if ((nh->io_uring_net || this->_io_uring_read_op) && this->_io_uring_recv(buf, toread, r)) {
+      if (r == -EINPROGRESS) {
+        // Picked up when the read completes.
+        nh->read_ready_list.remove(this);
+        return;
+      }
+    } else
+#endif
+    {
+      IOBufferBlock *b = buf.writer()->first_write_block();
+      do {
+        niov       = 0;
+        rattempted = 0;
+        while (b && niov < NET_MAX_IOV) {
+          int64_t a = b->write_avail();
+          if (a > 0) {
+            tiovec[niov].iov_base = b->_end;
+            int64_t togo          = toread - total_read - rattempted;
+            if (a > togo) {
+              a = togo;
+            }
+            tiovec[niov].iov_len  = a;
+            rattempted           += a;
+            niov++;
+            if (a >= togo) {
+              break;
+            }
           }
+          b = b->next.get();
         }
-        b = b->next.get();
-      }
 
-      ink_assert(niov > 0);
-      ink_assert(niov <= countof(tiovec));
-      struct msghdr msg;
+        ink_assert(niov > 0);
+        ink_assert(niov <= countof(tiovec));
+        struct msghdr msg;
 
-      ink_zero(msg);
-      msg.msg_name    = const_cast<sockaddr *>(this->get_remote_addr());
-      msg.msg_namelen = ats_ip_size(this->get_remote_addr());
-      msg.msg_iov     = &tiovec[0];
-      msg.msg_iovlen  = niov;
-      r               = this->con.sock.recvmsg(&msg, 0);
+        ink_zero(msg);
+        msg.msg_name    = const_cast<sockaddr *>(this->get_remote_addr());
+        msg.msg_namelen = ats_ip_size(this->get_remote_addr());
+        msg.msg_iov     = &tiovec[0];
+        msg.msg_iovlen  = niov;
+        r               = this->con.sock.recvmsg(&msg, 0);
 
-      Metrics::Counter::increment(net_rsb.calls_to_read);
+        Metrics::Counter::increment(net_rsb.calls_to_read);
 
-      total_read += rattempted;
-    } while (rattempted && r == rattempted && total_read < toread);
+        total_read += rattempted;
+      } while (rattempted && r == rattempted && total_read < toread);
 
-    // if we have already moved some bytes successfully, summarize in r
-    if (total_read != rattempted) {
-      if (r <= 0) {
-        r = total_read - rattempted;
-      } else {
-        r = total_read - rattempted + r;
+      // if we have already moved some bytes successfully, summarize in r
+      if (total_read != rattempted) {
+        if (r <= 0) {
+          r = total_read - rattempted;
+        } else {
+          r = total_read - rattempted + r;
+        }
       }
     }
     // check for errors
@@ -628,6 +647,23 @@ UnixNetVConnection::net_read_io(NetHandler *nh)
   read_reschedule(nh, this);
 }
 
+void
+UnixNetVConnection::_reap_zerocopy()
+{
+  if (_zerocopy != nullptr && _zerocopy->pending()) {
+    _zerocopy->reap(this->con.sock.get_fd());
+  }
+}
+
+void
+UnixNetVConnection::set_error_from_socket()
+{
+  // Zero copy completions are queued on the error queue of the socket, which raises EPOLLERR without an error. They
+  // are reaped here too so an idle connection does not keep its blocks until the next write.
+  _reap_zerocopy();
+  NetEvent::set_error_from_socket();
+}
+
 //
 // Write the data for a UnixNetVConnection.
 // Rescheduling the UnixNetVConnection when necessary.
@@ -652,6 +688,9 @@ UnixNetVConnection::net_write_io(NetHandler *nh)
     return;
   }
 
+  // Zero copy completions raise EPOLLERR and have to be reaped before the socket looks writable again.
+  _reap_zerocopy();
+
   // This function will always return true unless
   // this vc is an SSLNetVConnection.
   if (!this->getSSLHandShakeComplete()) {
@@ -766,6 +805,15 @@ UnixNetVConnection::net_write_io(NetHandler *nh)
     this->netActivity();
   }
 
+#if TS_USE_LINUX_IO_URING
+  if (r == -EINPROGRESS && this->_io_uring_write_op && this->_io_uring_write_op->state() == IOUringNetOp::State::IN_FLIGHT) {
+    // Submitted, picked up when the write completes.
+    this->write.triggered = 0;
+    nh->write_ready_list.remove(this);
+    return;
+  }
+#endif
+
   // A write of 0 makes no sense since we tried to write more than 0.
   ink_assert(r != 0);
   // Either we wrote something or got an error.
@@ -851,14 +899,38 @@ UnixNetVConnection::net_write_io(NetHandler *nh)
 int64_t
 UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &buf, int64_t &total_written, int &needs)
 {
-  int64_t         r            = 0;
+  int64_t r = 0;
+
+#if TS_USE_LINUX_IO_URING
+  // The first write of a TCP Fast Open connect carries the SYN and is left to sendmsg.
+  if (this->nh->io_uring_net && (this->con.is_connected || !this->options.f_tcp_fastopen) &&
+      this->_io_uring_send(towrite, buf, total_written, r)) {
+    needs |= EVENTIO_WRITE;
+    return r;
+  }
+#endif
+
   int64_t         try_to_write = 0;
   IOBufferReader *tmp_reader   = buf.reader()->clone();
 
+  // Large sends to clients go out with MSG_ZEROCOPY, the blocks are pinned until the kernel is done with them.
+  bool     zerocopy     = false;
+  uint32_t zerocopy_min = 0;
+#if defined(MSG_ZEROCOPY)
+  zerocopy_min = nh->config.zerocopy_min_write_size_in;
+  if (zerocopy_min != 0 && get_context() == NET_VCONNECTION_IN && towrite >= zerocopy_min) {
+    if (_zerocopy == nullptr) {
+      _zerocopy = new ZeroCopyTracker;
+    }
+    zerocopy = _zerocopy->enable(con.sock.get_fd());
+  }
+#endif
+
   do {
-    IOVec    tiovec[NET_MAX_IOV];
-    unsigned niov = 0;
-    try_to_write  = 0;
+    IOVec                   tiovec[NET_MAX_IOV];
+    ZeroCopyTracker::Blocks blocks;
+    unsigned                niov = 0;
+    try_to_write                 = 0;
 
     while (niov < NET_MAX_IOV) {
       int64_t wavail = towrite - total_written - try_to_write;
@@ -882,6 +954,9 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
       tiovec[niov].iov_len  = len;
       tiovec[niov].iov_base = tmp_reader->start();
       niov++;
+      if (zerocopy && (blocks.empty() || blocks.back().get() != tmp_reader->get_current_block())) {
+        blocks.emplace_back(tmp_reader->get_current_block());
+      }
 
       try_to_write += len;
       tmp_reader->consume(len);
@@ -908,7 +983,19 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
       Metrics::Counter::increment(net_rsb.fastopen_attempts);
       flags = MSG_FASTOPEN;
     }
-    r = con.sock.sendmsg(&msg, flags);
+#if defined(MSG_ZEROCOPY)
+    // Pinning and the completion are only worth it for a large send, not for the tail of a write.
+    if (zerocopy && try_to_write >= zerocopy_min) {
+      r = con.sock.sendmsg(&msg, flags | MSG_ZEROCOPY);
+      if (r > 0) {
+        _zerocopy->sent(std::move(blocks));
+      } else if (r == -ENOBUFS) {
+        // Out of optmem for pinned pages, copy this one.
+        r = con.sock.sendmsg(&msg, flags);
+      }
+    } else
+#endif
+      r = con.sock.sendmsg(&msg, flags);
     if (!this->con.is_connected && this->options.f_tcp_fastopen) {
       if (r < 0) {
         if (r == -EINPROGRESS || r == -EWOULDBLOCK) {
@@ -935,6 +1022,118 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
   return r;
 }
 
+#if TS_USE_LINUX_IO_URING
+bool
+UnixNetVConnection::_io_uring_recv(MIOBufferAccessor &buf, int64_t toread, int64_t &r)
+{
+  IOUringNetOp *op = _io_uring_read_op;
+
+  if (op && op->state() == IOUringNetOp::State::IN_FLIGHT) {
+    r = -EINPROGRESS;
+    return true;
+  }
+
+  // The VIO may want less than was read if it changed since the read was queued, the op keeps the rest for next time.
+  if (op && op->state() == IOUringNetOp::State::COMPLETE) {
+    r = op->take(buf.writer(), toread);
+    return true;
+  }
+
+  if (!nh->io_uring_net) {
+    return false;
+  }
+  if (op == nullptr) {
+    op = _io_uring_read_op = new IOUringNetOp(this, false);
+  }
+
+  for (IOBufferBlock *b = buf.writer()->first_write_block(); b && toread > 0; b = b->next.get()) {
+    int64_t a = std::min(b->write_avail(), toread);
+    if (a > 0) {
+      if (!op->add(b, b->end(), a)) {
+        break;
+      }
+      toread -= a;
+    }
+  }
+  if (!op->queue(this->con.sock.get_fd())) {
+    op->reset();
+    return false;
+  }
+  Metrics::Counter::increment(net_rsb.calls_to_read);
+  r = -EINPROGRESS;
+  return true;
+}
+
+bool
+UnixNetVConnection::_io_uring_send(int64_t towrite, MIOBufferAccessor &buf, int64_t &total_written, int64_t &r)
+{
+  if (_io_uring_write_op == nullptr) {
+    _io_uring_write_op = new IOUringNetOp(this, true);
+  }
+  IOUringNetOp *op = _io_uring_write_op;
+
+  if (op->state() == IOUringNetOp::State::IN_FLIGHT) {
+    r = -EINPROGRESS;
+    return true;
+  }
+
+  if (op->state() == IOUringNetOp::State::COMPLETE) {
+    r                = op->result();
+    bool same_reader = buf.reader()->start() == op->iov(0).iov_base;
+    op->reset();
+    if (r <= 0) {
+      return true;
+    }
+    // If the write VIO was replaced while the write was in flight, the data sent came from the old reader and the new
+    // one still has everything to go.
+    if (same_reader) {
+      buf.reader()->consume(r);
+      total_written += r;
+      return true;
+    }
+  }
+
+  IOBufferReader *tmp_reader = buf.reader()->clone();
+  for (int64_t togo = towrite; togo > 0;) {
+    int64_t len   = std::min(tmp_reader->block_read_avail(), togo);
+    char   *start = tmp_reader->start();
+    if (len <= 0 || !op->add(tmp_reader->get_current_block(), start, len)) {
+      break;
+    }
+    togo -= len;
+    tmp_reader->consume(len);
+  }
+  tmp_reader->dealloc();
+
+  if (!op->queue(this->con.sock.get_fd())) {
+    op->reset();
+    return false;
+  }
+  Metrics::Counter::increment(net_rsb.calls_to_write);
+  r = -EINPROGRESS;
+  return true;
+}
+
+void
+UnixNetVConnection::_release_io_uring_ops()
+{
+  bool in_flight = false;
+
+  for (IOUringNetOp **op : {&_io_uring_read_op, &_io_uring_write_op}) {
+    if (*op) {
+      in_flight |= (*op)->state() == IOUringNetOp::State::IN_FLIGHT;
+      (*op)->orphan();
+      *op = nullptr;
+    }
+  }
+  // Queued ops must reach the kernel, which takes its own reference to the socket, before the descriptor is closed
+  // and possibly reused by another connection.
+  if (in_flight) {
+    IOUringContext::local_context()->submit();
+  }
+}
+#endif
+
 void
 UnixNetVConnection::readDisable(NetHandler *nh)
 {
@@ -1283,11 +1482,23 @@ UnixNetVConnection::free_thread(EThread *t)
 
   ink_release_assert(t == this_ethread());
 
+#if TS_USE_LINUX_IO_URING
+  this->_release_io_uring_ops();
+#endif
+
   // close socket fd
   if (con.sock.is_ok()) {
     release_inbound_connection_tracking();
     Metrics::Gauge::decrement(net_rsb.connections_currently_open);
   }
+  if (_zerocopy != nullptr) {
+    if (_zerocopy->pending()) {
+      ZeroCopyTracker::linger(con, _zerocopy);
+    } else {
+      delete _zerocopy;
+    }
+    _zerocopy = nullptr;
+  }
   con.close();
 
   if (is_tunnel_endpoint()) {
@@ -1358,6 +1569,16 @@ UnixNetVConnection::migrateToCurrentThread(Continuation *cont, EThread *t)
     return this;
   }
 
+#if TS_USE_LINUX_IO_URING
+  // The completion of an op in flight is delivered on the ring of this thread, the connection cannot move before it.
+  for (IOUringNetOp *op : {_io_uring_read_op, _io_uring_write_op}) {
+    if (op && op->state() == IOUringNetOp::State::IN_FLIGHT) {
+      Dbg(dbg_ctl_iocore_net, "vc=%p cannot migrate with io_uring ops in flight", this);
+      return nullptr;
+    }
+  }
+#endif
+
   Connection hold_con;
   hold_con.move(this->con);
 
@@ -1372,6 +1593,9 @@ UnixNetVConnection::migrateToCurrentThread(Continuation *cont, EThread *t)
   // Create new VC:
   UnixNetVConnection *newvc = static_cast<UnixNetVConnection *>(this->_getNetProcessor()->allocate_vc(t));
   ink_assert(newvc != nullptr);
+  // The pending zero copy sends go with the socket.
+  newvc->_zerocopy = this->_zerocopy;
+  this->_zerocopy  = nullptr;
   if (newvc->populate(hold_con, cont, arg) != EVENT_DONE) {
     newvc->do_io_close();
     newvc = nullptr;
@@ -1379,6 +1603,16 @@ UnixNetVConnection::migrateToCurrentThread(Continuation *cont, EThread *t)
   if (newvc) {
     newvc->set_context(get_context());
     newvc->options = this->options;
+#if TS_USE_LINUX_IO_URING
+    // So does data read but not taken by the read VIO yet. The socket may have nothing more to report, so the new VC
+    // is marked readable to pick it up.
+    if (_io_uring_read_op && _io_uring_read_op->state() == IOUringNetOp::State::COMPLETE) {
+      _io_uring_read_op->adopt(newvc);
+      newvc->_io_uring_read_op = _io_uring_read_op;
+      _io_uring_read_op        = nullptr;
+      newvc->read.triggered    = 1;
+    }
+#endif
   }
 
   // Do not mark this closed until the end so it does not get freed by the other thread too soon
@@ -0,0 +1,150 @@
+/** @file
+
+  MSG_ZEROCOPY socket writes.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_ZeroCopy.h"
+#include "P_Connection.h"
+#include "P_Net.h"
+#include "iocore/eventsystem/EThread.h"
+
+#include <cstring>
+#include <sys/socket.h>
+#if defined(__linux__)
+#include <linux/errqueue.h>
+#endif
+
+namespace
+{
+DbgCtl dbg_ctl_zerocopy{"zerocopy"};
+
+// How long a closed connection waits for its zero copy sends to complete.
+constexpr ink_hrtime LINGER_TIMEOUT  = HRTIME_SECONDS(5);
+constexpr ink_hrtime LINGER_INTERVAL = HRTIME_MSECONDS(10);
+
+struct ZeroCopyLinger : public Continuation {
+  Connection       con;
+  ZeroCopyTracker *tracker;
+  ink_hrtime       deadline;
+
+  ZeroCopyLinger(Connection &c, ZeroCopyTracker *t)
+    : Continuation(new_ProxyMutex()), tracker(t), deadline(ink_get_hrtime() + LINGER_TIMEOUT)
+  {
+    con.move(c);
+    SET_HANDLER(&ZeroCopyLinger::lingerEvent);
+  }
+
+  int
+  lingerEvent(int /* event ATS_UNUSED */, Event *e)
+  {
+    int fd = con.sock.get_fd();
+    tracker->reap(fd);
+    if (tracker->pending() && ink_get_hrtime() < deadline) {
+      return EVENT_CONT;
+    }
+    Dbg(dbg_ctl_zerocopy, "fd=%d closed after linger, %s", fd, tracker->pending() ? "timed out" : "complete");
+    if (tracker->pending()) {
+      // The kernel may still send from the pinned pages. A close with a zero linger resets the connection and drops
+      // the send queue, only then can the blocks be reused.
+      struct linger l = {1, 0};
+      setsockopt(fd, SOL_SOCKET, SO_LINGER, &l, sizeof(l));
+    }
+    e->cancel();
+    con.close();
+    delete tracker;
+    delete this;
+    return EVENT_DONE;
+  }
+};
+
+} // end anonymous namespace
+
+bool
+ZeroCopyTracker::enable(int fd)
+{
+  if (_state == State::UNKNOWN) {
+    _state = State::UNUSABLE;
+#if defined(SO_ZEROCOPY)
+    int one = 1;
+    if (setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) == 0) {
+      _state = State::ENABLED;
+    } else {
+      Dbg(dbg_ctl_zerocopy, "fd=%d SO_ZEROCOPY failed: %s", fd, strerror(errno));
+    }
+#endif
+  }
+  return _state == State::ENABLED;
+}
+
+void
+ZeroCopyTracker::sent(Blocks &&blocks)
+{
+  _sends.push_back({_next_id++, std::move(blocks)});
+  Metrics::Counter::increment(net_rsb.zerocopy_writes);
+}
+
+void
+ZeroCopyTracker::reap(int fd)
+{
+#if defined(SO_EE_ORIGIN_ZEROCOPY)
+  while (!_sends.empty()) {
+    char     control[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+    msghdr   msg{};
+    cmsghdr *cm;
+
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+    if (recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+      break;
+    }
+    for (cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+      auto *ee = reinterpret_cast<sock_extended_err *>(CMSG_DATA(cm));
+      if (ee->ee_errno != 0 || ee->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+        continue;
+      }
+      // Completions are in order, [ee_info, ee_data] covers the oldest sends. Compare as offsets from the oldest send
+      // so the ids can wrap.
+      while (!_sends.empty() && _sends.front().id - ee->ee_info <= ee->ee_data - ee->ee_info) {
+        _sends.pop_front();
+      }
+      if (ee->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+        // The route to the peer cannot do zero copy (e.g. loopback), the kernel copied the data after all and only the
+        // notification overhead is left.
+        Metrics::Counter::increment(net_rsb.zerocopy_copied, ee->ee_data - ee->ee_info + 1);
+        if (_state == State::ENABLED) {
+          Dbg(dbg_ctl_zerocopy, "fd=%d sends were copied, disabling zero copy", fd);
+          _state = State::UNUSABLE;
+        }
+      }
+    }
+  }
+#else
+  (void)fd;
+  _sends.clear();
+#endif
+}
+
+void
+ZeroCopyTracker::linger(Connection &con, ZeroCopyTracker *tracker)
+{
+  auto *l = new ZeroCopyLinger(con, tracker);
+  this_ethread()->schedule_every_local(l, LINGER_INTERVAL);
+}
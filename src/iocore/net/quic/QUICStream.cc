@@ -110,6 +110,33 @@ QUICStream::receive_data(quiche_conn *quiche_con)
   this->_adapter->encourge_read();
 }
 
+void
+QUICStream::set_priority(uint8_t urgency, bool incremental, bool is_update)
+{
+  if (this->_priority_updated && !is_update) {
+    return;
+  }
+  this->_priority_updated |= is_update;
+  if (urgency == this->_urgency && incremental == this->_incremental) {
+    return;
+  }
+  this->_urgency          = urgency;
+  this->_incremental      = incremental;
+  this->_priority_changed = true;
+}
+
+uint8_t
+QUICStream::urgency() const
+{
+  return this->_urgency;
+}
+
+bool
+QUICStream::is_incremental() const
+{
+  return this->_incremental;
+}
+
 void
 QUICStream::send_data(quiche_conn *quiche_con)
 {
@@ -118,6 +145,11 @@ QUICStream::send_data(quiche_conn *quiche_con)
   [[maybe_unused]] ErrorCode error_code{0}; // Only set if QUICHE_ERR_STREAM_STOPPED(-15) or QUICHE_ERR_STREAM_RESET(-16) are
                                             // returned by quiche_conn_stream_send.
 
+  if (this->_priority_changed) {
+    quiche_conn_stream_priority(quiche_con, this->_id, this->_urgency, this->_incremental);
+    this->_priority_changed = false;
+  }
+
   len = quiche_conn_stream_capacity(quiche_con, this->_id);
   if (len <= 0) {
     return;
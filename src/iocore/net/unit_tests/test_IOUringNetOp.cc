@@ -0,0 +1,181 @@
+/** @file
+
+  Unit tests for the hand off of socket reads completed through io_uring.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "catch.hpp"
+
+#include "../P_IOUringNetOp.h"
+#include "../P_UnixNetVConnection.h"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+namespace
+{
+/// Point @a op at the unfilled space of @a writer, as @c UnixNetVConnection does before queueing a read.
+void
+prepare(IOUringNetOp &op, MIOBuffer *writer)
+{
+  for (IOBufferBlock *b = writer->first_write_block(); b; b = b->next.get()) {
+    REQUIRE(op.add(b, b->end(), b->write_avail()));
+  }
+}
+
+/// Complete @a op as the kernel would, having read @a data.
+void
+complete(IOUringNetOp &op, std::string const &data)
+{
+  size_t offset = 0;
+  for (int i = 0; i < op.niov() && offset < data.size(); ++i) {
+    size_t n = std::min(data.size() - offset, op.iov(i).iov_len);
+    memcpy(op.iov(i).iov_base, data.data() + offset, n);
+    offset += n;
+  }
+  REQUIRE(offset == data.size());
+
+  io_uring_cqe cqe{};
+  cqe.res = data.size();
+  op.handle_complete(&cqe);
+  REQUIRE(op.state() == IOUringNetOp::State::COMPLETE);
+}
+
+/// Hand at most @a max bytes of @a op to @a writer, as much as fits like @c net_read_io does, @return what was taken.
+std::string
+take(IOUringNetOp &op, MIOBuffer *writer, IOBufferReader *reader, int64_t max)
+{
+  int64_t n = op.take(writer, std::min(max, writer->write_avail()));
+  REQUIRE(n > 0);
+  writer->fill(n);
+
+  std::string result(n, '\0');
+  REQUIRE(reader->read(result.data(), n) == n);
+  return result;
+}
+
+std::string
+pattern(size_t n)
+{
+  std::string s;
+  for (size_t i = 0; i < n; ++i) {
+    s += 'a' + i % 26;
+  }
+  return s;
+}
+
+} // end anonymous namespace
+
+TEST_CASE("IOUringNetOp read taken whole", "[net][io_uring]")
+{
+  UnixNetVConnection vc;
+  IOUringNetOp       op(&vc, false);
+  MIOBuffer         *buffer = new_MIOBuffer(BUFFER_SIZE_INDEX_4K);
+  IOBufferReader    *reader = buffer->alloc_reader();
+
+  prepare(op, buffer);
+  complete(op, "hello world");
+  CHECK(take(op, buffer, reader, 100) == "hello world");
+  CHECK(op.state() == IOUringNetOp::State::IDLE);
+
+  free_MIOBuffer(buffer);
+}
+
+TEST_CASE("IOUringNetOp read larger than the VIO wants", "[net][io_uring]")
+{
+  UnixNetVConnection vc;
+  IOUringNetOp       op(&vc, false);
+  MIOBuffer         *buffer = new_MIOBuffer(BUFFER_SIZE_INDEX_128);
+  IOBufferReader    *reader = buffer->alloc_reader();
+  std::string const  data   = pattern(200);
+
+  buffer->add_block();
+  prepare(op, buffer);
+  REQUIRE(op.niov() == 2);
+  complete(op, data);
+
+  // The VIO shrank while the read was in flight, the rest stays with the op.
+  CHECK(take(op, buffer, reader, 150) == data.substr(0, 150));
+  CHECK(op.state() == IOUringNetOp::State::COMPLETE);
+
+  // What the op kept does not live in the read buffer, which may be written to before the next read.
+  for (IOBufferBlock *b = buffer->first_write_block(); b; b = b->next.get()) {
+    memset(b->end(), 'x', b->write_avail());
+  }
+  CHECK(take(op, buffer, reader, 20) == data.substr(150, 20));
+  CHECK(take(op, buffer, reader, 100) == data.substr(170));
+  CHECK(op.state() == IOUringNetOp::State::IDLE);
+
+  free_MIOBuffer(buffer);
+}
+
+TEST_CASE("IOUringNetOp read moves with its connection", "[net][io_uring]")
+{
+  UnixNetVConnection vc;
+  UnixNetVConnection migrated;
+  IOUringNetOp       op(&vc, false);
+  MIOBuffer         *buffer = new_MIOBuffer(BUFFER_SIZE_INDEX_4K);
+  std::string const  data   = pattern(1000);
+
+  prepare(op, buffer);
+  complete(op, data);
+  free_MIOBuffer(buffer);
+
+  // The new connection reads into a buffer of its own, the data read on the old one is copied there.
+  op.adopt(&migrated);
+  MIOBuffer      *other  = new_MIOBuffer(BUFFER_SIZE_INDEX_128);
+  IOBufferReader *reader = other->alloc_reader();
+  std::string     taken;
+  while (op.state() == IOUringNetOp::State::COMPLETE) {
+    taken += take(op, other, reader, 600);
+  }
+  CHECK(taken == data);
+  CHECK(op.state() == IOUringNetOp::State::IDLE);
+
+  free_MIOBuffer(other);
+}
+
+TEST_CASE("IOUringNetOp read failed", "[net][io_uring]")
+{
+  UnixNetVConnection vc;
+  IOUringNetOp       op(&vc, false);
+  MIOBuffer         *buffer = new_MIOBuffer(BUFFER_SIZE_INDEX_4K);
+  io_uring_cqe       cqe{};
+
+  SECTION("end of stream")
+  {
+    prepare(op, buffer);
+    cqe.res = 0;
+    op.handle_complete(&cqe);
+    CHECK(op.take(buffer, 100) == 0);
+  }
+  SECTION("error")
+  {
+    prepare(op, buffer);
+    cqe.res = -ECONNRESET;
+    op.handle_complete(&cqe);
+    CHECK(op.take(buffer, 100) == -ECONNRESET);
+  }
+  CHECK(op.state() == IOUringNetOp::State::IDLE);
+  CHECK(buffer->max_read_avail() == 0);
+
+  free_MIOBuffer(buffer);
+}
@@ -0,0 +1,143 @@
+/** @file
+
+  Unit tests for the tracking of MSG_ZEROCOPY sends.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "catch.hpp"
+
+#include "../P_ZeroCopy.h"
+#include "iocore/net/Net.h"
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+
+namespace
+{
+/// A connected pair of TCP sockets on the loopback interface.
+struct LoopbackPair {
+  int client = -1;
+  int server = -1;
+
+  LoopbackPair()
+  {
+    sockaddr_in addr{};
+    socklen_t   len      = sizeof(addr);
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(listener >= 0);
+    REQUIRE(bind(listener, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+    REQUIRE(listen(listener, 1) == 0);
+    REQUIRE(getsockname(listener, reinterpret_cast<sockaddr *>(&addr), &len) == 0);
+
+    client = socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(connect(client, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+    server = accept(listener, nullptr, nullptr);
+    REQUIRE(server >= 0);
+    close(listener);
+  }
+
+  ~LoopbackPair()
+  {
+    close(client);
+    close(server);
+  }
+};
+
+Ptr<IOBufferBlock>
+make_block(char fill)
+{
+  Ptr<IOBufferBlock> block = make_ptr(new_IOBufferBlock());
+  block->alloc(BUFFER_SIZE_INDEX_32K);
+  memset(block->end(), fill, block->write_avail());
+  block->fill(block->write_avail());
+  return block;
+}
+
+/// Reap completions on @a fd until none are pending, or a second passes.
+void
+wait_for_completions(ZeroCopyTracker &tracker, int fd)
+{
+  for (int i = 0; i < 100 && tracker.pending(); ++i) {
+    pollfd pfd{fd, 0, 0};
+    poll(&pfd, 1, 10);
+    tracker.reap(fd);
+  }
+}
+
+} // end anonymous namespace
+
+TEST_CASE("ZeroCopyTracker", "[net][ZeroCopy]")
+{
+  ink_net_init(NET_SYSTEM_MODULE_PUBLIC_VERSION);
+
+  LoopbackPair    sockets;
+  ZeroCopyTracker tracker;
+
+  REQUIRE_FALSE(tracker.pending());
+  if (!tracker.enable(sockets.server)) {
+    WARN("SO_ZEROCOPY is not supported here");
+    return;
+  }
+  // Asking again does not set the option again.
+  REQUIRE(tracker.enable(sockets.server));
+
+#if defined(MSG_ZEROCOPY)
+  std::vector<Ptr<IOBufferBlock>> blocks;
+  int64_t                         total = 0;
+  for (char fill : {'a', 'b', 'c'}) {
+    Ptr<IOBufferBlock> block = make_block(fill);
+    REQUIRE(send(sockets.server, block->start(), block->read_avail(), MSG_ZEROCOPY) == block->read_avail());
+    total += block->read_avail();
+    blocks.push_back(block);
+    tracker.sent(ZeroCopyTracker::Blocks{block});
+  }
+
+  // The blocks are pinned by the tracker until the kernel reports the sends complete.
+  REQUIRE(tracker.pending());
+  for (auto const &block : blocks) {
+    REQUIRE(block->refcount() == 2);
+  }
+
+  // Drain the peer, the send queue only empties once the data is acknowledged.
+  char    buffer[32768];
+  int64_t received = 0;
+  while (received < total) {
+    ssize_t n = recv(sockets.client, buffer, sizeof(buffer), 0);
+    REQUIRE(n > 0);
+    received += n;
+  }
+
+  wait_for_completions(tracker, sockets.server);
+  REQUIRE_FALSE(tracker.pending());
+  for (auto const &block : blocks) {
+    REQUIRE(block->refcount() == 1);
+  }
+
+  // Loopback cannot send without copying, which the kernel reports and the tracker remembers.
+  REQUIRE_FALSE(tracker.enable(sockets.server));
+#endif
+}
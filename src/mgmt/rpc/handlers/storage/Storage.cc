@@ -33,6 +33,11 @@ namespace rpc::handlers::storage::field_names
 static constexpr auto PATH{"path"};
 static constexpr auto STATUS{"status"};
 static constexpr auto ERRORS{"error_count"};
+static constexpr auto ID{"id"};
+static constexpr auto VOLUME{"volume"};
+static constexpr auto SIZE{"size"};
+static constexpr auto DIRECTORY_BYTES{"directory_bytes"};
+static constexpr auto RECOVERED_BYTES{"recovered_bytes"};
 } // namespace rpc::handlers::storage::field_names
 
 namespace YAML
@@ -57,6 +62,23 @@ template <> struct convert<CacheDisk> {
   }
 };
 
+template <> struct convert<CacheProcessor::StripeStatus> {
+  static Node
+  encode(CacheProcessor::StripeStatus const &stripe)
+  {
+    namespace field = rpc::handlers::storage::field_names;
+    Node node;
+    node[field::PATH]            = std::string{stripe.path};
+    node[field::ID]              = std::string{stripe.id};
+    node[field::VOLUME]          = stripe.volume;
+    node[field::STATUS]          = std::string{stripe.state};
+    node[field::SIZE]            = stripe.size;
+    node[field::DIRECTORY_BYTES] = stripe.directory_bytes;
+    node[field::RECOVERED_BYTES] = stripe.recovered_bytes;
+    return node;
+  }
+};
+
 } // namespace YAML
 
 namespace rpc::handlers::storage
@@ -108,4 +130,15 @@ get_storage_status(std::string_view const & /* id ATS_UNUSED */, YAML::Node cons
   }
   return resp;
 }
+
+swoc::Rv<YAML::Node>
+get_stripe_status(std::string_view const & /* id ATS_UNUSED */, YAML::Node const & /* params ATS_UNUSED */)
+{
+  swoc::Rv<YAML::Node> resp;
+
+  for (auto const &stripe : cacheProcessor.stripe_status()) {
+    resp.result().push_back(stripe);
+  }
+  return resp;
+}
 } // namespace rpc::handlers::storage
@@ -0,0 +1,456 @@
+/** @file
+
+  Extensible Prioritization Scheme for HTTP ([RFC 9218]), shared by HTTP/2 and HTTP/3.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "proxy/ExtensiblePriority.h"
+
+#include "tscore/ink_assert.h"
+
+#include <iterator>
+
+namespace ExtensiblePriority
+{
+namespace
+{
+  // [RFC 8941] 3.3. Items, just enough of it to step over the values of parameters other than u and i.
+  class Reader
+  {
+  public:
+    explicit Reader(std::string_view text) : _text(text) {}
+
+    bool
+    empty() const
+    {
+      return _text.empty();
+    }
+
+    bool
+    next_is(char c) const
+    {
+      return !_text.empty() && _text.front() == c;
+    }
+
+    bool
+    next_is_integer() const
+    {
+      return next_is('-') || (!_text.empty() && is_digit(_text.front()));
+    }
+
+    bool
+    skip(char c)
+    {
+      if (!_text.empty() && _text.front() == c) {
+        _text.remove_prefix(1);
+        return true;
+      }
+      return false;
+    }
+
+    void
+    skip_sp()
+    {
+      while (skip(' ')) {}
+    }
+
+    void
+    skip_ows()
+    {
+      while (skip(' ') || skip('\t')) {}
+    }
+
+    bool
+    key(std::string_view &key)
+    {
+      if (_text.empty() || !(is_lcalpha(_text.front()) || _text.front() == '*')) {
+        return false;
+      }
+      size_t n = 1;
+      while (n < _text.size() && is_key_char(_text[n])) {
+        ++n;
+      }
+      key = _text.substr(0, n);
+      _text.remove_prefix(n);
+      return true;
+    }
+
+    bool
+    integer(int64_t &value)
+    {
+      bool negative = skip('-');
+      if (_text.empty() || !is_digit(_text.front())) {
+        return false;
+      }
+      value = 0;
+      for (int n = 0; !_text.empty() && is_digit(_text.front()); ++n) {
+        if (n == 15) {
+          return false;
+        }
+        value = value * 10 + (_text.front() - '0');
+        _text.remove_prefix(1);
+      }
+      if (skip('.')) {
+        // A decimal, which no parameter of this scheme uses.
+        while (!_text.empty() && is_digit(_text.front())) {
+          _text.remove_prefix(1);
+        }
+        value = -1;
+      }
+      if (negative) {
+        value = -value;
+      }
+      return true;
+    }
+
+    bool
+    boolean(bool &value)
+    {
+      if (!skip('?') || _text.empty() || (_text.front() != '0' && _text.front() != '1')) {
+        return false;
+      }
+      value = _text.front() == '1';
+      _text.remove_prefix(1);
+      return true;
+    }
+
+    bool
+    bare_item()
+    {
+      if (_text.empty()) {
+        return false;
+      }
+      char c = _text.front();
+      if (next_is_integer()) {
+        int64_t value;
+        return integer(value);
+      }
+      if (c == '?') {
+        bool value;
+        return boolean(value);
+      }
+      if (c == '"') {
+        _text.remove_prefix(1);
+        while (!_text.empty()) {
+          c = _text.front();
+          _text.remove_prefix(1);
+          if (c == '"') {
+            return true;
+          }
+          if (c == '\\' && !skip('"') && !skip('\\')) {
+            return false;
+          }
+          if (c < 0x20 || c > 0x7e) {
+            return false;
+          }
+        }
+        return false;
+      }
+      if (c == ':') {
+        _text.remove_prefix(1);
+        while (!_text.empty() && _text.front() != ':') {
+          _text.remove_prefix(1);
+        }
+        return skip(':');
+      }
+      if (is_alpha(c) || c == '*') {
+        while (!_text.empty() && (is_tchar(_text.front()) || _text.front() == ':' || _text.front() == '/')) {
+          _text.remove_prefix(1);
+        }
+        return true;
+      }
+      return false;
+    }
+
+    /// Parameters of an item, which carry nothing for this scheme.
+    bool
+    parameters()
+    {
+      while (skip(';')) {
+        skip_sp();
+        std::string_view name;
+        if (!key(name) || (skip('=') && !bare_item())) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    bool
+    inner_list()
+    {
+      while (true) {
+        skip_sp();
+        if (skip(')')) {
+          return parameters();
+        }
+        if (!bare_item() || !parameters()) {
+          return false;
+        }
+        if (_text.empty() || (_text.front() != ' ' && _text.front() != ')')) {
+          return false;
+        }
+      }
+    }
+
+  private:
+    static bool
+    is_digit(char c)
+    {
+      return '0' <= c && c <= '9';
+    }
+
+    static bool
+    is_lcalpha(char c)
+    {
+      return 'a' <= c && c <= 'z';
+    }
+
+    static bool
+    is_alpha(char c)
+    {
+      return is_lcalpha(c) || ('A' <= c && c <= 'Z');
+    }
+
+    static bool
+    is_key_char(char c)
+    {
+      return is_lcalpha(c) || is_digit(c) || c == '_' || c == '-' || c == '.' || c == '*';
+    }
+
+    static bool
+    is_tchar(char c)
+    {
+      return is_alpha(c) || is_digit(c) || std::string_view{"!#$%&'*+-.^_`|~"}.find(c) != std::string_view::npos;
+    }
+
+    std::string_view _text;
+  };
+
+} // end anonymous namespace
+
+bool
+parse(std::string_view value, Priority &priority)
+{
+  Priority result = priority;
+  Reader   reader{value};
+
+  reader.skip_sp();
+  while (!reader.empty()) {
+    std::string_view key;
+    if (!reader.key(key)) {
+      return false;
+    }
+
+    if (!reader.skip('=')) {
+      // A key on its own is the Boolean true.
+      if (key == "i") {
+        result.incremental = true;
+      }
+    } else if (reader.skip('(')) {
+      if (!reader.inner_list()) {
+        return false;
+      }
+    } else if (key == "u" && reader.next_is_integer()) {
+      int64_t urgency;
+      if (!reader.integer(urgency)) {
+        return false;
+      }
+      // [RFC 9218] 4.1. Values outside the range are ignored.
+      if (0 <= urgency && urgency < URGENCY_LEVELS) {
+        result.urgency = urgency;
+      }
+    } else if (key == "i" && reader.next_is('?')) {
+      bool incremental;
+      if (!reader.boolean(incremental)) {
+        return false;
+      }
+      result.incremental = incremental;
+    } else if (!reader.bare_item()) {
+      // Other members, and a u or an i of another type, are ignored once parsed.
+      return false;
+    }
+    if (!reader.parameters()) {
+      return false;
+    }
+
+    reader.skip_ows();
+    if (reader.empty()) {
+      break;
+    }
+    if (!reader.skip(',')) {
+      return false;
+    }
+    reader.skip_ows();
+    if (reader.empty()) {
+      // A trailing comma
+      return false;
+    }
+  }
+
+  priority = result;
+  return true;
+}
+
+unsigned
+Scheduler::_index(const Priority &priority)
+{
+  return priority.urgency * 2 + priority.incremental;
+}
+
+Node *
+Scheduler::add(uint32_t id, const Priority &priority, void *t)
+{
+  ++_size;
+  return new Node(id, priority, t);
+}
+
+void
+Scheduler::remove(Node *node)
+{
+  deactivate(node, 0);
+  --_size;
+  delete node;
+}
+
+void
+Scheduler::reprioritize(Node *node, const Priority &priority)
+{
+  if (node->priority == priority) {
+    return;
+  }
+  if (node->active) {
+    deactivate(node, 0);
+    node->priority = priority;
+    activate(node);
+  } else {
+    node->priority = priority;
+  }
+}
+
+Node *
+Scheduler::top() const
+{
+  if (_ready == 0) {
+    return nullptr;
+  }
+  return _queues[__builtin_ctz(_ready)].head;
+}
+
+void
+Scheduler::activate(Node *node)
+{
+  if (node->active) {
+    return;
+  }
+  node->active = true;
+
+  unsigned     index = _index(node->priority);
+  Queue<Node> &queue = _queues[index];
+  if (node->priority.incremental) {
+    queue.enqueue(node);
+  } else {
+    Node *after = queue.tail;
+    while (after != nullptr && after->id > node->id) {
+      after = after->link.prev;
+    }
+    if (after != nullptr) {
+      queue.insert(node, after);
+    } else {
+      queue.push(node);
+    }
+  }
+  _ready |= 1u << index;
+}
+
+void
+Scheduler::deactivate(Node *node, uint32_t /* sent ATS_UNUSED */)
+{
+  if (!node->active) {
+    return;
+  }
+  node->active = false;
+
+  unsigned     index = _index(node->priority);
+  Queue<Node> &queue = _queues[index];
+  queue.remove(node);
+  if (queue.empty()) {
+    _ready &= ~(1u << index);
+  }
+}
+
+void
+Scheduler::update(Node *node, uint32_t /* sent ATS_UNUSED */)
+{
+  ink_assert(node->active);
+
+  // An incremental response gives way to the next one of its urgency after each frame.
+  Queue<Node> &queue = _queues[_index(node->priority)];
+  if (node->priority.incremental && queue.tail != node) {
+    queue.remove(node);
+    queue.enqueue(node);
+  }
+}
+
+uint32_t
+Scheduler::size() const
+{
+  return _size;
+}
+
+bool
+PendingUpdates::add(uint64_t id, const Priority &priority, size_t limit)
+{
+  if (auto it = _updates.find(id); it != _updates.end()) {
+    it->second = priority;
+    return true;
+  }
+  if (_updates.size() >= limit) {
+    return false;
+  }
+  _updates.emplace(id, priority);
+  return true;
+}
+
+bool
+PendingUpdates::take(uint64_t id, Priority &priority)
+{
+  auto end   = _updates.upper_bound(id);
+  bool found = end != _updates.begin() && std::prev(end)->first == id;
+  if (found) {
+    priority = std::prev(end)->second;
+  }
+  _updates.erase(_updates.begin(), end);
+  return found;
+}
+
+size_t
+PendingUpdates::size() const
+{
+  return _updates.size();
+}
+
+void
+PendingUpdates::clear()
+{
+  _updates.clear();
+}
+
+} // namespace ExtensiblePriority
@@ -1971,6 +1971,15 @@ HTTPHdrImpl::unmarshal(intptr_t offset)
   HDR_UNMARSHAL_PTR(m_fields_impl, MIMEHdrImpl, offset);
 }
 
+void
+HTTPHdrImpl::move_objects(intptr_t offset)
+{
+  if (m_polarity == HTTPType::REQUEST) {
+    HDR_UNMARSHAL_PTR(u.req.m_url_impl, URLImpl, offset);
+  }
+  HDR_UNMARSHAL_PTR(m_fields_impl, MIMEHdrImpl, offset);
+}
+
 void
 HTTPHdrImpl::move_strings(HdrStrHeap *new_heap)
 {
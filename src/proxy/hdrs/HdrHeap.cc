@@ -997,6 +997,64 @@ HdrHeap::unmarshal(int buf_length, int obj_type, HdrHeapObjImpl **found_obj, Ref
   return unmarshal_size;
 }
 
+// HdrHeap* HdrHeap::duplicate()
+//
+//   Copies a heap that came out of unmarshal so that it can be
+//     written.  Unmarshalled heaps are a single block, so the
+//     objects are copied in one piece and only the pointers
+//     between objects need to be moved.  The strings stay in
+//     the marshal buffer and are shared until they are changed.
+//
+HdrHeap *
+HdrHeap::duplicate() const
+{
+  if (m_writeable || m_next != nullptr || m_read_write_heap) {
+    return nullptr;
+  }
+  ink_assert(m_magic == HdrBufMagic::ALIVE);
+
+  int      used = static_cast<int>(m_free_start - m_data_start);
+  HdrHeap *h    = new_HdrHeap(HDR_HEAP_HDR_SIZE + used);
+  ink_assert(static_cast<int>(h->m_free_size) >= used);
+
+  memcpy(h->m_data_start, m_data_start, used);
+  h->m_free_start += used;
+  h->m_free_size  -= used;
+
+  char    *obj_data = h->m_data_start;
+  intptr_t offset   = h->m_data_start - m_data_start;
+
+  while (obj_data < h->m_free_start) {
+    HdrHeapObjImpl *obj = reinterpret_cast<HdrHeapObjImpl *>(obj_data);
+    ink_assert(obj_is_aligned(obj));
+    ink_release_assert(0 != obj->m_length);
+
+    switch (static_cast<HdrHeapObjType>(obj->m_type)) {
+    case HdrHeapObjType::HTTP_HEADER:
+      ((HTTPHdrImpl *)obj)->move_objects(offset);
+      break;
+    case HdrHeapObjType::FIELD_BLOCK:
+      ((MIMEFieldBlockImpl *)obj)->move_objects(offset);
+      break;
+    case HdrHeapObjType::MIME_HEADER:
+      ((MIMEHdrImpl *)obj)->move_objects(offset);
+      break;
+    case HdrHeapObjType::URL:
+    case HdrHeapObjType::EMPTY:
+    case HdrHeapObjType::RAW:
+      // No pointers to other objects
+      break;
+    default:
+      ink_release_assert(0);
+    }
+
+    obj_data = obj_data + obj->m_length;
+  }
+
+  h->inherit_string_heaps(this);
+  return h;
+}
+
 inline bool
 HdrHeap::attach_str_heap(char const *h_start, int h_len, RefCountObj *h_ref_obj, int *index)
 {
@@ -22,10 +22,12 @@
  */
 
 #include "tscore/ink_platform.h"
-#include "tscore/HashFNV.h"
 #include "tscore/Diags.h"
 #include "tscore/ink_memory.h"
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
+#include <string_view>
 #include "tscore/Allocator.h"
 #include "proxy/hdrs/HTTP.h"
 #include "proxy/hdrs/HdrToken.h"
@@ -53,7 +55,7 @@ DbgCtl dbg_ctl_hdr_token{"hdr_token"};
 
 */
 
-const char *const _hdrtoken_strs[] = {
+constexpr const char *_hdrtoken_strs[] = {
   // MIME Field names
   "Accept-Charset", "Accept-Encoding", "Accept-Language", "Accept-Ranges", "Accept", "Age", "Allow",
   "Approved", // NNTP
@@ -289,70 +291,122 @@ DFA *hdrtoken_strs_dfa = nullptr;
  *                                                                     *
  ***********************************************************************/
 
-#define HDRTOKEN_HASH_TABLE_SIZE 65536
-
-struct HdrTokenHashBucket {
-  const char *wks;
-  uint32_t    hash;
-};
+namespace
+{
+constexpr unsigned HDRTOKEN_HASH_BITS  = 12;
+constexpr unsigned HDRTOKEN_HASH_SIZE  = 1 << HDRTOKEN_HASH_BITS;
+constexpr int      HDRTOKEN_MAX_LENGTH = 32;
 
-HdrTokenHashBucket hdrtoken_hash_table[HDRTOKEN_HASH_TABLE_SIZE];
+/**
+  The hash reads the length and the characters at five fixed positions, so it
+  costs the same for every string. Upper and lower case letters differ only in
+  0x20, which is set before hashing to ignore the case.
+**/
+constexpr uint32_t
+hdrtoken_hash(const char *string, unsigned length, uint32_t seed)
+{
+  uint32_t hash = seed ^ length;
+  if (length > 0) {
+    for (unsigned i : {0u, 1u, length / 2, length - 2, length - 1}) {
+      hash = (hash ^ (static_cast<unsigned char>(string[std::min(i, length - 1)]) | 0x20)) * 0x9e3779b1;
+    }
+  }
+  return hash >> (32 - HDRTOKEN_HASH_BITS);
+}
 
 /**
-  basic FNV hash
+  A perfect hash of the well known strings, built by the compiler. Every WKS
+  has its own slot, so a lookup is one hash and one compare.
 **/
-#define TINY_MASK(x) (((uint32_t)1 << (x)) - 1)
+struct HdrTokenHashTable {
+  uint32_t seed = 0;
+  uint16_t slots[HDRTOKEN_HASH_SIZE]{}; ///< wks_idx + 1, 0 for an empty slot.
+};
 
-inline uint32_t
-hash_to_slot(uint32_t hash)
+constexpr HdrTokenHashTable
+hdrtoken_hash_table_build()
 {
-  return ((hash >> 15) ^ hash) & TINY_MASK(15);
+  // Try seeds until one puts each string in its own slot.
+  for (uint32_t seed = 1; seed < 1024; ++seed) {
+    uint64_t used[HDRTOKEN_HASH_SIZE / 64]{};
+    bool     unique = true;
+    for (unsigned i = 0; unique && i < SIZEOF(_hdrtoken_strs); ++i) {
+      std::string_view wks{_hdrtoken_strs[i]};
+      uint32_t         slot  = hdrtoken_hash(wks.data(), wks.size(), seed);
+      unique                 = !(used[slot / 64] & (uint64_t{1} << (slot % 64)));
+      used[slot / 64]       |= uint64_t{1} << (slot % 64);
+    }
+    if (unique) {
+      HdrTokenHashTable table;
+      table.seed = seed;
+      for (unsigned i = 0; i < SIZEOF(_hdrtoken_strs); ++i) {
+        std::string_view wks{_hdrtoken_strs[i]};
+        table.slots[hdrtoken_hash(wks.data(), wks.size(), seed)] = i + 1;
+      }
+      return table;
+    }
+  }
+  return {};
 }
 
-inline uint32_t
-hdrtoken_hash(const unsigned char *string, unsigned int length)
+constexpr bool
+hdrtoken_lengths_fit()
 {
-  ATSHash32FNV1a fnv;
-  fnv.update(string, length, ATSHash::nocase());
-  fnv.final();
-  return fnv.get();
+  for (auto wks : _hdrtoken_strs) {
+    if (std::string_view{wks}.size() > HDRTOKEN_MAX_LENGTH) {
+      return false;
+    }
+  }
+  return true;
 }
 
-/*-------------------------------------------------------------------------
-  -------------------------------------------------------------------------*/
+constexpr HdrTokenHashTable hdrtoken_hash_table = hdrtoken_hash_table_build();
+static_assert(hdrtoken_hash_table.seed != 0, "no perfect hash of the well known strings, increase HDRTOKEN_HASH_BITS");
+static_assert(hdrtoken_lengths_fit(), "a well known string is longer than HDRTOKEN_MAX_LENGTH");
 
-void
-hdrtoken_hash_init()
+// wks_idx -> 0x20 for each letter of the WKS, 0 for any other character.
+char hdrtoken_case_masks[SIZEOF(_hdrtoken_strs)][HDRTOKEN_MAX_LENGTH];
+
+inline uint64_t
+load_word(const char *p)
+{
+  uint64_t word;
+  memcpy(&word, p, sizeof(word));
+  return word;
+}
+
+/**
+  Compare @a length bytes of @a string to the WKS @a wks_idx, ignoring case.
+
+  With the case mask of the WKS set in both, a letter matches either case of
+  itself and any other character must be equal, so whole words are compared at
+  once. The last word overlaps the one before it instead of reading past the
+  end of the string.
+**/
+inline bool
+hdrtoken_equal_nocase(const char *string, int wks_idx, int length)
 {
-  uint32_t i;
-  int      num_collisions;
-
-  memset(hdrtoken_hash_table, 0, sizeof(hdrtoken_hash_table));
-  num_collisions = 0;
-
-  for (i = 0; i < static_cast<int> SIZEOF(_hdrtoken_strs); i++) {
-    // convert the common string to the well-known token
-    unsigned const char *wks;
-    int                  wks_idx =
-      hdrtoken_tokenize_dfa(_hdrtoken_strs[i], static_cast<int>(strlen(_hdrtoken_strs[i])), reinterpret_cast<const char **>(&wks));
-    ink_release_assert(wks_idx >= 0);
-
-    uint32_t hash = hdrtoken_hash(wks, hdrtoken_str_lengths[wks_idx]);
-    uint32_t slot = hash_to_slot(hash);
-
-    if (hdrtoken_hash_table[slot].wks) {
-      printf("ERROR: hdrtoken_hash_table[%u] collision: '%s' replacing '%s'\n", slot, reinterpret_cast<const char *>(wks),
-             hdrtoken_hash_table[slot].wks);
-      ++num_collisions;
+  const char *wks  = hdrtoken_strs[wks_idx];
+  const char *mask = hdrtoken_case_masks[wks_idx];
+
+  if (length >= static_cast<int>(sizeof(uint64_t))) {
+    int i = 0;
+    for (; i + static_cast<int>(sizeof(uint64_t)) < length; i += sizeof(uint64_t)) {
+      if ((load_word(string + i) | load_word(mask + i)) != (load_word(wks + i) | load_word(mask + i))) {
+        return false;
+      }
     }
-    hdrtoken_hash_table[slot].wks  = reinterpret_cast<const char *>(wks);
-    hdrtoken_hash_table[slot].hash = hash;
+    i = length - sizeof(uint64_t);
+    return (load_word(string + i) | load_word(mask + i)) == (load_word(wks + i) | load_word(mask + i));
   }
-
-  if (num_collisions > 0) {
-    abort();
+  for (int i = 0; i < length; ++i) {
+    if ((string[i] | mask[i]) != (wks[i] | mask[i])) {
+      return false;
+    }
   }
+  return true;
 }
+} // end anonymous namespace
 
 /***********************************************************************
  *                                                                     *
@@ -466,9 +520,10 @@ hdrtoken_init()
       hdrtoken_str_slotids[i]     = prefix->wks_info.slotid; // parallel array for speed
       hdrtoken_str_masks[i]       = prefix->wks_info.mask;   // parallel array for speed
       hdrtoken_str_flags[i]       = prefix->wks_info.flags;  // parallel array for speed
+      for (int c = 0; c < hdrtoken_str_lengths[i]; ++c) {
+        hdrtoken_case_masks[i][c] = ParseRules::is_alpha(_hdrtoken_strs[i][c]) ? 0x20 : 0;
+      }
     }
-
-    hdrtoken_hash_init();
   }
 }
 
@@ -527,8 +582,7 @@ hdrtoken_method_tokenize(const char *string, int string_len)
 int
 hdrtoken_tokenize(const char *string, int string_len, const char **wks_string_out)
 {
-  int                 wks_idx;
-  HdrTokenHashBucket *bucket;
+  int wks_idx;
 
   ink_assert(string != nullptr);
 
@@ -540,16 +594,14 @@ hdrtoken_tokenize(const char *string, int string_len, const char **wks_string_ou
     return wks_idx;
   }
 
-  uint32_t hash = hdrtoken_hash(reinterpret_cast<const unsigned char *>(string), static_cast<unsigned int>(string_len));
-  uint32_t slot = hash_to_slot(hash);
-
-  bucket = &(hdrtoken_hash_table[slot]);
-  if ((bucket->wks != nullptr) && (bucket->hash == hash) && (hdrtoken_wks_to_length(bucket->wks) == string_len)) {
-    wks_idx = hdrtoken_wks_to_index(bucket->wks);
-    if (wks_string_out) {
-      *wks_string_out = bucket->wks;
+  if (string_len > 0 && string_len <= HDRTOKEN_MAX_LENGTH) {
+    wks_idx = hdrtoken_hash_table.slots[hdrtoken_hash(string, string_len, hdrtoken_hash_table.seed)] - 1;
+    if (wks_idx >= 0 && hdrtoken_str_lengths[wks_idx] == string_len && hdrtoken_equal_nocase(string, wks_idx, string_len)) {
+      if (wks_string_out) {
+        *wks_string_out = hdrtoken_strs[wks_idx];
+      }
+      return wks_idx;
     }
-    return wks_idx;
   }
 
   Dbg(dbg_ctl_hdr_token, "Did not find a WKS for '%.*s'", string_len, string);
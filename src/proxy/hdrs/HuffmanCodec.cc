@@ -23,15 +23,16 @@
 
 #include "proxy/hdrs/HuffmanCodec.h"
 #include "tscore/ink_platform.h"
-#include "tscore/ink_memory.h"
 #include "tscore/ink_defs.h"
 
+#include <iterator>
+
 struct huffman_entry {
   uint32_t code_as_hex;
   uint32_t bit_len;
 };
 
-static const huffman_entry huffman_table[] = {
+static constexpr huffman_entry huffman_table[] = {
   {0x1ff8,     13},
   {0x7fffd8,   23},
   {0xfffffe2,  28},
@@ -291,140 +292,144 @@ static const huffman_entry huffman_table[] = {
   {0x3fffffff, 30}
 };
 
-using Node = struct node {
-  node *left, *right;
-  char  ascii_code;
-  bool  leaf_node;
-};
-
-Node *HUFFMAN_TREE_ROOT;
-
-static Node *
-make_huffman_tree_node()
+namespace
 {
-  Node *n       = static_cast<Node *>(ats_malloc(sizeof(Node)));
-  n->left       = nullptr;
-  n->right      = nullptr;
-  n->ascii_code = '\0';
-  n->leaf_node  = false;
-  return n;
-}
+constexpr unsigned HUFFMAN_SYMBOL_COUNT = std::size(huffman_table);
+constexpr unsigned HUFFMAN_EOS          = HUFFMAN_SYMBOL_COUNT - 1;
+
+// The code is a complete prefix code over 257 symbols, so its tree has exactly 256 internal nodes. These are the states of the
+// decoder, with the root as state 0.
+constexpr unsigned HUFFMAN_STATE_COUNT = HUFFMAN_SYMBOL_COUNT - 1;
+
+// Number of input bits consumed per decoder step. The shortest code is 5 bits long, so a step emits at most one symbol.
+constexpr unsigned HUFFMAN_DECODE_BITS = 4;
+
+struct huffman_tree {
+  // Child node indices, or the bitwise complement of the symbol for leaves.
+  int16_t child[HUFFMAN_STATE_COUNT][2] = {};
+  // Bits consumed since the root, i.e. since the last decoded symbol.
+  uint8_t depth[HUFFMAN_STATE_COUNT] = {};
+  // Whether every bit on the path from the root is 1, i.e. the pending bits are a prefix of EOS.
+  bool all_ones[HUFFMAN_STATE_COUNT] = {};
+};
 
-static Node *
+constexpr huffman_tree
 make_huffman_tree()
 {
-  Node *root = make_huffman_tree_node();
+  huffman_tree tree;
+  int16_t      n_nodes = 1;
 
-  // insert leafs for each ascii code
-  for (unsigned i = 0; i < countof(huffman_table); i++) {
-    uint32_t bit_len = huffman_table[i].bit_len;
-    Node    *current = root;
+  tree.all_ones[0] = true;
+  for (unsigned sym = 0; sym < HUFFMAN_SYMBOL_COUNT; ++sym) {
+    int16_t current = 0;
 
-    while (bit_len > 0) {
-      if (huffman_table[i].code_as_hex & (1 << (bit_len - 1))) {
-        if (!current->right) {
-          current->right = make_huffman_tree_node();
-        }
-        current = current->right;
+    for (uint32_t bit_len = huffman_table[sym].bit_len; bit_len > 0; --bit_len) {
+      unsigned bit = (huffman_table[sym].code_as_hex >> (bit_len - 1)) & 1;
+
+      if (bit_len == 1) {
+        tree.child[current][bit] = ~static_cast<int16_t>(sym);
       } else {
-        if (!current->left) {
-          current->left = make_huffman_tree_node();
+        if (tree.child[current][bit] == 0) {
+          int16_t next             = n_nodes++;
+          tree.child[current][bit] = next;
+          tree.depth[next]         = tree.depth[current] + 1;
+          tree.all_ones[next]      = tree.all_ones[current] && bit;
         }
-        current = current->left;
+        current = tree.child[current][bit];
       }
-      bit_len--;
     }
-    current->ascii_code = i;
-    current->leaf_node  = true;
   }
 
-  return root;
+  return tree;
 }
 
-static void
-free_huffman_tree(Node *node)
-{
-  if (node->left) {
-    free_huffman_tree(node->left);
-  }
-  if (node->right) {
-    free_huffman_tree(node->right);
-  }
+enum huffman_decode_flags : uint8_t {
+  HUFFMAN_DECODE_EMIT   = 1 << 0, ///< @a sym is decoded by this step.
+  HUFFMAN_DECODE_ACCEPT = 1 << 1, ///< The input may end in @a state (pending bits are valid padding).
+  HUFFMAN_DECODE_FAIL   = 1 << 2, ///< EOS was decoded, which is an error.
+};
 
-  ats_free(node);
-}
+struct huffman_decode_entry {
+  uint8_t state;
+  uint8_t flags;
+  uint8_t sym;
+};
 
-void
-hpack_huffman_init()
-{
-  if (!HUFFMAN_TREE_ROOT) {
-    HUFFMAN_TREE_ROOT = make_huffman_tree();
-  }
-}
+struct huffman_decode_table {
+  huffman_decode_entry entry[HUFFMAN_STATE_COUNT][1 << HUFFMAN_DECODE_BITS];
+};
 
-void
-hpack_huffman_fin()
+constexpr huffman_decode_table
+make_huffman_decode_table()
 {
-  if (HUFFMAN_TREE_ROOT) {
-    free_huffman_tree(HUFFMAN_TREE_ROOT);
+  constexpr huffman_tree tree = make_huffman_tree();
+  huffman_decode_table   table{};
+
+  for (unsigned state = 0; state < HUFFMAN_STATE_COUNT; ++state) {
+    for (unsigned input = 0; input < (1 << HUFFMAN_DECODE_BITS); ++input) {
+      huffman_decode_entry &entry   = table.entry[state][input];
+      unsigned              current = state;
+
+      for (unsigned shift = HUFFMAN_DECODE_BITS; shift > 0; --shift) {
+        int16_t next = tree.child[current][(input >> (shift - 1)) & 1];
+
+        if (next >= 0) {
+          current = next;
+          continue;
+        }
+        if (static_cast<unsigned>(~next) == HUFFMAN_EOS) {
+          entry.flags = HUFFMAN_DECODE_FAIL;
+          break;
+        }
+        entry.flags |= HUFFMAN_DECODE_EMIT;
+        entry.sym    = ~next;
+        current      = 0;
+      }
+
+      if (entry.flags & HUFFMAN_DECODE_FAIL) {
+        continue;
+      }
+      entry.state = current;
+      // Padding must be a prefix of EOS that is shorter than a byte.
+      if (tree.depth[current] <= 7 && tree.all_ones[current]) {
+        entry.flags |= HUFFMAN_DECODE_ACCEPT;
+      }
+    }
   }
+
+  return table;
 }
 
-#define MAX_HUFFMAN_CODE_LEN 30
-#define EOS                  0x3fffffff
+constexpr huffman_decode_table HUFFMAN_DECODE_TABLE = make_huffman_decode_table();
+
+} // end anonymous namespace
 
 int64_t
 huffman_decode(char *dst_start, const uint8_t *src, uint32_t src_len)
 {
-  char    *dst_end   = dst_start;
-  uint8_t  shift     = 7;
-  Node    *current   = HUFFMAN_TREE_ROOT;
-  int      nbits     = 0;
-  uint32_t curr_bits = 0;
-
-  while (src_len) {
-    if (nbits > 0) {
-      curr_bits <<= 1;
-    }
-    if (*src & (1 << shift)) {
-      curr_bits |= 1;
-      current    = current->right;
-    } else {
-      current = current->left;
-    }
-    ++nbits;
+  char          *dst_end = dst_start;
+  const uint8_t *src_end = src + src_len;
+  uint8_t        state   = 0;
+  uint8_t        flags   = HUFFMAN_DECODE_ACCEPT;
 
-    if (current->leaf_node == true) {
-      if (curr_bits == EOS) {
-        return -1;
-      }
-      nbits     = 0;
-      curr_bits = 0;
-      *dst_end  = current->ascii_code;
-      ++dst_end;
-      current = HUFFMAN_TREE_ROOT;
-    }
+  static_assert(HUFFMAN_DECODE_BITS * 2 == 8);
 
-    if (shift) {
-      --shift;
-    } else {
-      shift = 7;
-      ++src;
-      --src_len;
-    }
+  for (; src < src_end; ++src) {
+    for (uint8_t input : {static_cast<uint8_t>(*src >> 4), static_cast<uint8_t>(*src & 0xf)}) {
+      const huffman_decode_entry &entry = HUFFMAN_DECODE_TABLE.entry[state][input];
 
-    if (nbits > MAX_HUFFMAN_CODE_LEN) {
-      return -1;
+      if (entry.flags & HUFFMAN_DECODE_FAIL) {
+        return -1;
+      }
+      if (entry.flags & HUFFMAN_DECODE_EMIT) {
+        *dst_end++ = entry.sym;
+      }
+      state = entry.state;
+      flags = entry.flags;
     }
   }
 
-  if (nbits > 7) {
-    return -1;
-  }
-
-  // Padding bits must be a prefix of EOS
-  uint8_t mask = (1 << nbits) - 1;
-  if ((mask & curr_bits) != mask) {
+  if (!(flags & HUFFMAN_DECODE_ACCEPT)) {
     return -1;
   }
 
@@ -444,36 +449,30 @@ int64_t
 huffman_encode(uint8_t *dst_start, const uint8_t *src, uint32_t src_len)
 {
   uint8_t *dst = dst_start;
-  // NOTE: The maximum length of Huffman Code is 30, thus using uint32_t as buffer.
-  uint32_t buf         = 0;
-  uint32_t remain_bits = 32;
-
-  for (uint32_t i = 0; i < src_len; ++i) {
-    const uint32_t hex     = huffman_table[src[i]].code_as_hex;
-    const uint32_t bit_len = huffman_table[src[i]].bit_len;
-
-    if (remain_bits > bit_len) {
-      remain_bits  = remain_bits - bit_len;
-      buf         |= hex << remain_bits;
-    } else if (remain_bits == bit_len) {
-      buf         |= hex;
-      dst          = huffman_encode_append(dst, buf);
-      remain_bits  = 32;
-      buf          = 0;
-    } else {
-      buf         |= hex >> (bit_len - remain_bits);
-      dst          = huffman_encode_append(dst, buf);
-      remain_bits  = (32 - (bit_len - remain_bits));
-      buf          = hex << remain_bits;
+  // NOTE: Fewer than 32 bits are pending before a code is appended and the maximum length of Huffman Code is 30, thus a 64 bit
+  // accumulator never overflows. Only the low @a pending_bits bits of @a buf are meaningful.
+  uint64_t buf          = 0;
+  uint32_t pending_bits = 0;
+
+  for (const uint8_t *src_end = src + src_len; src < src_end; ++src) {
+    const huffman_entry &code = huffman_table[*src];
+
+    buf           = (buf << code.bit_len) | code.code_as_hex;
+    pending_bits += code.bit_len;
+    if (pending_bits >= 32) {
+      pending_bits -= 32;
+      dst           = huffman_encode_append(dst, static_cast<uint32_t>(buf >> pending_bits));
     }
   }
 
-  dst = huffman_encode_append(dst, buf, remain_bits / 8);
-
   // NOTE: Add padding w/ EOS
-  uint32_t pad_len = remain_bits % 8;
-  if (pad_len) {
-    *(dst - 1) |= 0xff >> (8 - pad_len);
+  if (uint32_t pad_len = (8 - pending_bits % 8) % 8; pad_len) {
+    buf           = (buf << pad_len) | ((1u << pad_len) - 1);
+    pending_bits += pad_len;
+  }
+  while (pending_bits > 0) {
+    pending_bits -= 8;
+    *dst++        = static_cast<uint8_t>(buf >> pending_bits);
   }
 
   return dst - dst_start;
@@ -29,6 +29,9 @@
 #include <cstring>
 #include <cctype>
 #include <algorithm>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #include "proxy/hdrs/MIME.h"
 #include "proxy/hdrs/HdrHeap.h"
 #include "proxy/hdrs/HdrToken.h"
@@ -2316,6 +2319,83 @@ MIMEScanner::get(TextView &input, TextView &output, bool &output_shares_input, b
   return zret;
 }
 
+namespace
+{
+/** Find the first control character other than HT in @a text, and the first ':' before it.
+ *
+ * @return The offset of the control character, or the size of @a text if there is none.
+ */
+size_t
+mime_find_line_stop(TextView text, size_t &colon)
+{
+  char const *p = text.data();
+  size_t      n = text.size();
+  size_t      i = 0;
+
+  colon = TextView::npos;
+#if defined(__SSE2__)
+  // A control character is 0x00-0x1f except HT, or DEL. The unsigned compare is min(v, 0x1f) == v.
+  __m128i const ctl_max = _mm_set1_epi8(0x1f);
+  __m128i const ht      = _mm_set1_epi8('\t');
+  __m128i const del     = _mm_set1_epi8(0x7f);
+  __m128i const sep     = _mm_set1_epi8(':');
+  for (; i + 16 <= n; i += 16) {
+    __m128i  v    = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p + i));
+    __m128i  low  = _mm_andnot_si128(_mm_cmpeq_epi8(v, ht), _mm_cmpeq_epi8(_mm_min_epu8(v, ctl_max), v));
+    unsigned stop = _mm_movemask_epi8(_mm_or_si128(low, _mm_cmpeq_epi8(v, del)));
+    unsigned seps = _mm_movemask_epi8(_mm_cmpeq_epi8(v, sep));
+    if (stop) {
+      // only a ':' before the stop is in this line
+      seps &= (1u << __builtin_ctz(stop)) - 1;
+    }
+    if (seps && colon == TextView::npos) {
+      colon = i + __builtin_ctz(seps);
+    }
+    if (stop) {
+      return i + __builtin_ctz(stop);
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    if (ParseRules::is_control(p[i])) {
+      return i;
+    }
+    if (p[i] == ':' && colon == TextView::npos) {
+      colon = i;
+    }
+  }
+  return n;
+}
+} // end anonymous namespace
+
+bool
+MIMEScanner::get_field_line(TextView &input, TextView &output, size_t &colon)
+{
+  if (m_state != MimeParseState::BEFORE || !m_line.empty()) {
+    return false;
+  }
+
+  size_t stop = mime_find_line_stop(input, colon);
+  size_t lf   = stop;
+  // A stop at the start is the end of the header, and anything other than CR LF or LF is left to get().
+  if (stop == 0 || stop == input.size()) {
+    return false;
+  } else if (input[stop] == ParseRules::CHAR_CR && stop + 1 < input.size() && input[stop + 1] == ParseRules::CHAR_LF) {
+    lf = stop + 1;
+  } else if (input[stop] != ParseRules::CHAR_LF) {
+    return false;
+  }
+  // A folded line must be glued together by get(). If the input ends here, get() would not wait
+  // for the next line either.
+  if (lf + 1 < input.size() && ParseRules::is_ws(input[lf + 1])) {
+    return false;
+  }
+
+  output = input.prefix(lf + 1);
+  input.remove_prefix(lf + 1);
+  return true;
+}
+
 void
 _mime_parser_init(MIMEParser *parser)
 {
@@ -2357,10 +2437,17 @@ mime_parser_parse(MIMEParser *parser, HdrHeap *heap, MIMEHdrImpl *mh, const char
 
     TextView text{*real_s, real_e};
     TextView parsed;
-    err     = scanner->get(text, parsed, line_is_real, eof, MIMEScanner::ScanType::FIELD);
-    *real_s = text.data();
-    if (err != ParseResult::OK) {
-      return err;
+    size_t   colon      = TextView::npos;
+    bool     plain_line = scanner->get_field_line(text, parsed, colon);
+    if (plain_line) {
+      line_is_real = true;
+      *real_s      = text.data();
+    } else {
+      err     = scanner->get(text, parsed, line_is_real, eof, MIMEScanner::ScanType::FIELD);
+      *real_s = text.data();
+      if (err != ParseResult::OK) {
+        return err;
+      }
     }
 
     //////////////////////////////////////////////////
@@ -2390,8 +2477,13 @@ mime_parser_parse(MIMEParser *parser, HdrHeap *heap, MIMEHdrImpl *mh, const char
     }
 
     // find name last
-    auto field_value = parsed; // need parsed as is later on.
-    auto field_name  = field_value.split_prefix_at(':');
+    auto     field_value = parsed; // need parsed as is later on.
+    TextView field_name;
+    if (!plain_line) {
+      field_name = field_value.split_prefix_at(':');
+    } else if (colon != TextView::npos) {
+      field_name = field_value.split_prefix(colon);
+    }
     if (field_name.empty()) {
       continue; // toss away garbage line
     }
@@ -2452,10 +2544,13 @@ mime_parser_parse(MIMEParser *parser, HdrHeap *heap, MIMEHdrImpl *mh, const char
     }
 
     // RFC 9110 Section 5.5. Field Values
-    for (char i : field_value) {
-      // FIXME: ParseRules::is_http_field_value() should be used but the implementation looks wrong
-      if (ParseRules::is_control(i)) {
-        return ParseResult::ERROR;
+    // A plain line has no control characters before the trailing CR LF, which is not in the value.
+    if (!plain_line) {
+      for (char i : field_value) {
+        // FIXME: ParseRules::is_http_field_value() should be used but the implementation looks wrong
+        if (ParseRules::is_control(i)) {
+          return ParseResult::ERROR;
+        }
       }
     }
 
@@ -3562,6 +3657,20 @@ MIMEFieldBlockImpl::unmarshal(intptr_t offset)
   }
 }
 
+void
+MIMEFieldBlockImpl::move_objects(intptr_t offset)
+{
+  HDR_UNMARSHAL_PTR(m_next, MIMEFieldBlockImpl, offset);
+
+  for (uint32_t index = 0; index < m_freetop; index++) {
+    MIMEField *field = &(m_field_slots[index]);
+
+    if (field->is_live() && field->m_next_dup) {
+      HDR_UNMARSHAL_PTR(field->m_next_dup, MIMEField, offset);
+    }
+  }
+}
+
 void
 MIMEFieldBlockImpl::move_strings(HdrStrHeap *new_heap)
 {
@@ -3632,6 +3741,13 @@ MIMEHdrImpl::unmarshal(intptr_t offset)
   m_first_fblock.unmarshal(offset);
 }
 
+void
+MIMEHdrImpl::move_objects(intptr_t offset)
+{
+  HDR_UNMARSHAL_PTR(m_fblock_list_tail, MIMEFieldBlockImpl, offset);
+  m_first_fblock.move_objects(offset);
+}
+
 void
 MIMEHdrImpl::move_strings(HdrStrHeap *new_heap)
 {
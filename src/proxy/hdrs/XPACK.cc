@@ -30,6 +30,8 @@
 #include "tscore/ink_memory.h"
 #include "tsutil/LocalBuffer.h"
 #include <cstdint>
+#include <functional>
+#include <utility>
 
 namespace
 {
@@ -55,6 +57,18 @@ match(const char *s1, int s1_len, const char *s2, int s2_len)
   return true;
 }
 
+inline size_t
+name_hash(std::string_view name)
+{
+  return std::hash<std::string_view>{}(name);
+}
+
+inline size_t
+field_hash(size_t hash, std::string_view value)
+{
+  return hash ^ (std::hash<std::string_view>{}(value) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2));
+}
+
 } // end anonymous namespace
 
 //
@@ -272,30 +286,41 @@ XpackDynamicTable::lookup(const char *name, size_t name_len, const char *value,
 {
   XPACKDbg("Lookup entry: name=%.*s, value=%.*s", static_cast<int>(name_len), name, static_cast<int>(value_len), value);
   XpackLookupResult::MatchType match_type      = XpackLookupResult::MatchType::NONE;
-  uint32_t                     i               = this->_calc_index(this->_entries_tail, 1);
-  uint32_t                     end             = this->_calc_index(this->_entries_head, 1);
   uint32_t                     candidate_index = 0;
-  const char                  *tmp_name        = nullptr;
-  const char                  *tmp_value       = nullptr;
 
   // DynamicTable is empty
-  if (this->is_empty()) {
+  if (this->is_empty() || name_len == 0) {
     return {candidate_index, match_type};
   }
 
-  for (; i != end; i = this->_calc_index(i, 1)) {
-    if (name_len != 0 && this->_entries[i].name_len == name_len) {
-      this->_storage.read(this->_entries[i].offset, &tmp_name, this->_entries[i].name_len, &tmp_value, this->_entries[i].value_len);
-      if (match(name, name_len, tmp_name, this->_entries[i].name_len)) {
-        candidate_index = this->_entries[i].index;
-        if (match(value, value_len, tmp_value, this->_entries[i].value_len)) {
-          // Exact match
-          match_type = XpackLookupResult::MatchType::EXACT;
+  std::string_view name_sv{name, name_len};
+  std::string_view value_sv{value, value_len};
+  size_t           hash   = name_hash(name_sv);
+  uint32_t         oldest = this->_entries[this->_calc_index(this->_entries_tail, 1)].index;
+
+  // Exact match -- Prefer the oldest entry
+  if (auto spot = this->_field_index.find(field_hash(hash, value_sv)); spot != this->_field_index.end()) {
+    for (uint32_t index = spot->second; index != NO_ENTRY && index >= oldest;) {
+      uint32_t pos = this->_entry_position(index);
+      if (this->_entry_matches(pos, name_sv, &value_sv)) {
+        candidate_index = index;
+        match_type      = XpackLookupResult::MatchType::EXACT;
+      }
+      index = this->_entries[pos].older_same_field;
+    }
+  }
+
+  // Name match -- Prefer the newest entry
+  if (match_type == XpackLookupResult::MatchType::NONE) {
+    if (auto spot = this->_name_index.find(hash); spot != this->_name_index.end()) {
+      for (uint32_t index = spot->second; index != NO_ENTRY && index >= oldest;) {
+        uint32_t pos = this->_entry_position(index);
+        if (this->_entry_matches(pos, name_sv, nullptr)) {
+          candidate_index = index;
+          match_type      = XpackLookupResult::MatchType::NAME;
           break;
-        } else {
-          // Name match -- Keep it for no exact matches
-          match_type = XpackLookupResult::MatchType::NAME;
         }
+        index = this->_entries[pos].older_same_name;
       }
     }
   }
@@ -359,9 +384,23 @@ XpackDynamicTable::insert_entry(const char *name, size_t name_len, const char *v
     static_cast<uint32_t>(name_len),
     static_cast<uint32_t>(value_len),
     0,
-    wks};
+    wks,
+    NO_ENTRY,
+    NO_ENTRY};
   this->_available -= required_size;
 
+  // Index
+  auto  &entry                   = this->_entries[this->_entries_head];
+  size_t hash                    = name_hash({name, name_len});
+  auto [name_spot, name_added]   = this->_name_index.try_emplace(hash, entry.index);
+  auto [field_spot, field_added] = this->_field_index.try_emplace(field_hash(hash, {value, value_len}), entry.index);
+  if (!name_added) {
+    entry.older_same_name = std::exchange(name_spot->second, entry.index);
+  }
+  if (!field_added) {
+    entry.older_same_field = std::exchange(field_spot->second, entry.index);
+  }
+
   XPACKDbg("Insert Entry: entry=%u, index=%u, size=%zu", this->_entries_head, this->_entries_inserted - 1, name_len + value_len);
   XPACKDbg("Available size: %u", this->_available);
   return {this->_entries_inserted, value_len ? XpackLookupResult::MatchType::EXACT : XpackLookupResult::MatchType::NAME};
@@ -510,6 +549,7 @@ XpackDynamicTable::_make_space(uint64_t extra_space_needed)
       break;
     }
     freed += this->_entries[tail].name_len + this->_entries[tail].value_len + ADDITIONAL_32_BYTES;
+    this->_unindex_entry(tail);
   }
 
   // Evict
@@ -525,6 +565,49 @@ XpackDynamicTable::_make_space(uint64_t extra_space_needed)
   return freed >= extra_space_needed;
 }
 
+bool
+XpackDynamicTable::_entry_matches(uint32_t pos, std::string_view name, const std::string_view *value) const
+{
+  const XpackDynamicTableEntry &entry     = this->_entries[pos];
+  const char                   *tmp_name  = nullptr;
+  const char                   *tmp_value = nullptr;
+
+  if (entry.name_len != name.size() || (value && entry.value_len != value->size())) {
+    return false;
+  }
+  this->_storage.read(entry.offset, &tmp_name, entry.name_len, &tmp_value, entry.value_len);
+  return match(name.data(), name.size(), tmp_name, entry.name_len) &&
+         (!value || match(value->data(), value->size(), tmp_value, entry.value_len));
+}
+
+void
+XpackDynamicTable::_unindex_entry(uint32_t pos)
+{
+  const XpackDynamicTableEntry &entry     = this->_entries[pos];
+  const char                   *tmp_name  = nullptr;
+  const char                   *tmp_value = nullptr;
+
+  this->_storage.read(entry.offset, &tmp_name, entry.name_len, &tmp_value, entry.value_len);
+
+  // Entries are evicted oldest first, so older entries in a chain are gone already and only a chain's newest entry needs
+  // its key removed. Newer entries still linking to this one stop there because of its index.
+  size_t hash = name_hash({tmp_name, entry.name_len});
+  if (auto spot = this->_name_index.find(hash); spot != this->_name_index.end() && spot->second == entry.index) {
+    this->_name_index.erase(spot);
+  }
+  if (auto spot = this->_field_index.find(field_hash(hash, {tmp_value, entry.value_len}));
+      spot != this->_field_index.end() && spot->second == entry.index) {
+    this->_field_index.erase(spot);
+  }
+}
+
+uint32_t
+XpackDynamicTable::_entry_position(uint32_t index) const
+{
+  uint32_t newer = this->_entries[this->_entries_head].index - index;
+  return (this->_entries_head + this->_max_entries - newer) % this->_max_entries;
+}
+
 uint32_t
 XpackDynamicTable::_calc_index(uint32_t base, int64_t offset) const
 {
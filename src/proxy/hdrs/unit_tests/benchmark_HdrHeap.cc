@@ -0,0 +1,168 @@
+/** @file
+
+  Micro benchmark for reading cached headers.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+
+#include "proxy/hdrs/HTTP.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+
+extern int cmd_disable_pfreelist;
+
+namespace
+{
+struct BenchRefCountObj : public RefCountObj {
+  void
+  free() override
+  {
+  }
+};
+
+// A response with @a n_fields fields, like a cached object from an origin behind a CDN.
+std::string
+make_response(int n_fields)
+{
+  std::string text = "HTTP/1.1 200 OK\r\n"
+                     "Date: Mon, 15 Jan 2024 10:00:00 GMT\r\n"
+                     "Content-Type: text/html; charset=utf-8\r\n"
+                     "Content-Length: 48213\r\n"
+                     "Cache-Control: public, max-age=300\r\n"
+                     "ETag: \"5f3e1c2a-1b4d3\"\r\n"
+                     "Last-Modified: Sun, 14 Jan 2024 22:41:09 GMT\r\n"
+                     "Vary: Accept-Encoding\r\n"
+                     "Server: nginx\r\n";
+  for (int i = 8; i < n_fields; ++i) {
+    text += "X-Origin-Field-" + std::to_string(i) + ": 7b1e9c52-4a0f-4c3e-9d5b-" + std::to_string(i) + "\r\n";
+  }
+  return text + "\r\n";
+}
+
+int
+heap_blocks(HdrHeap *heap)
+{
+  int n = 0;
+  for (; heap != nullptr; heap = heap->m_next) {
+    ++n;
+  }
+  return n;
+}
+
+// The previous copy of a cached header, each object created in a new heap.
+void
+clone(HTTPHdr &to, HTTPHdr const &from)
+{
+  to.m_heap = new_HdrHeap();
+  to.m_http = http_hdr_clone(from.m_http, from.m_heap, to.m_heap);
+  to.m_mime = to.m_http->m_fields_impl;
+}
+
+void
+bench_response(int n_fields)
+{
+  std::string text  = make_response(n_fields);
+  const char *start = text.data();
+  HTTPParser  parser;
+  HTTPHdr     hdr;
+
+  hdr.create(HTTPType::RESPONSE);
+  http_parser_init(&parser);
+  REQUIRE(hdr.parse_resp(&parser, &start, text.data() + text.size(), true) == ParseResult::DONE);
+  http_parser_clear(&parser);
+  REQUIRE(hdr.fields_count() == n_fields);
+
+  // The marshalled image as it is stored in a cache Doc.
+  int                     len = hdr.m_heap->marshal_length();
+  std::unique_ptr<char[]> image(new char[len]);
+  std::unique_ptr<char[]> buf(new char[len]);
+  REQUIRE(hdr.m_heap->marshal(image.get(), len) > 0);
+  hdr.destroy();
+
+  BenchRefCountObj ref;
+  ref.refcount_inc();
+
+  auto read = [&](HTTPHdr &cached) {
+    memcpy(buf.get(), image.get(), len);
+    return cached.unmarshal(buf.get(), len, &ref);
+  };
+
+  HTTPHdr cached, a, b;
+  REQUIRE(read(cached) > 0);
+  a.copy(&cached);
+  clone(b, cached);
+  REQUIRE(a.fields_count() == n_fields);
+  REQUIRE(b.fields_count() == n_fields);
+  std::printf("%d fields, %d byte image: copy uses %d heap block(s), clone uses %d heap block(s)\n", n_fields, len,
+              heap_blocks(a.m_heap), heap_blocks(b.m_heap));
+  a.destroy();
+  b.destroy();
+
+  BENCHMARK("unmarshal " + std::to_string(n_fields) + " fields")
+  {
+    HTTPHdr cached;
+    return read(cached);
+  };
+
+  BENCHMARK("unmarshal and copy " + std::to_string(n_fields) + " fields")
+  {
+    HTTPHdr cached, copy;
+    read(cached);
+    copy.copy(&cached);
+    int n = copy.fields_count();
+    copy.destroy();
+    return n;
+  };
+
+  BENCHMARK("unmarshal and clone " + std::to_string(n_fields) + " fields")
+  {
+    HTTPHdr cached, copy;
+    read(cached);
+    clone(copy, cached);
+    int n = copy.fields_count();
+    copy.destroy();
+    return n;
+  };
+}
+
+} // end anonymous namespace
+
+TEST_CASE("HdrHeap cache read", "[proxy][hdrs][bench]")
+{
+  bench_response(20);
+  bench_response(40);
+}
+
+int
+main(int argc, char *argv[])
+{
+  // No thread setup, forbid use of thread local allocators.
+  cmd_disable_pfreelist = true;
+  // Get all of the HTTP WKS items populated.
+  http_init();
+
+  return Catch::Session().run(argc, argv);
+}
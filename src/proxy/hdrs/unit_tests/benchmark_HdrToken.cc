@@ -0,0 +1,147 @@
+/** @file
+
+  Micro benchmark for well known string tokenizing.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+
+#include "tscore/HashFNV.h"
+#include "proxy/hdrs/HdrToken.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+// Field names seen in requests and responses that are not well known strings.
+const char *other_names[] = {
+  "sec-ch-ua", "sec-ch-ua-mobile", "sec-ch-ua-platform", "Sec-Fetch-Site", "Sec-Fetch-Mode", "Sec-Fetch-Dest", "Sec-Fetch-User",
+  "Upgrade-Insecure-Requests", "Origin", "X-Requested-With", "X-Forwarded-Proto", "X-Request-Id", "CDN-Loop", "Priority",
+  "Access-Control-Allow-Origin", "Content-Security-Policy", "X-Content-Type-Options", "X-Frame-Options", "Alt-Svc",
+  "X-Cache", "Timing-Allow-Origin", "Report-To", "NEL", "Server-Timing",
+};
+
+// The previous implementation, a 32 bit FNV-1a hash into a sparse table that trusts a matching hash and length.
+namespace reference
+{
+  struct Bucket {
+    const char *wks;
+    uint32_t    hash;
+  };
+
+  std::vector<Bucket> table(65536);
+
+  uint32_t
+  hash(const char *string, int length)
+  {
+    ATSHash32FNV1a fnv;
+    fnv.update(string, length, ATSHash::nocase());
+    fnv.final();
+    return fnv.get();
+  }
+
+  uint32_t
+  hash_to_slot(uint32_t hash)
+  {
+    return ((hash >> 15) ^ hash) & ((1 << 15) - 1);
+  }
+
+  void
+  init()
+  {
+    for (int i = 0; i < hdrtoken_num_wks; ++i) {
+      uint32_t h                  = hash(hdrtoken_strs[i], hdrtoken_str_lengths[i]);
+      table[hash_to_slot(h)].wks  = hdrtoken_strs[i];
+      table[hash_to_slot(h)].hash = h;
+    }
+  }
+
+  int
+  tokenize(const char *string, int length)
+  {
+    uint32_t      h      = hash(string, length);
+    Bucket const &bucket = table[hash_to_slot(h)];
+    if (bucket.wks != nullptr && bucket.hash == h && hdrtoken_wks_to_length(bucket.wks) == length) {
+      return hdrtoken_wks_to_index(bucket.wks);
+    }
+    return -1;
+  }
+} // namespace reference
+
+} // end anonymous namespace
+
+TEST_CASE("HdrToken tokenize", "[proxy][hdrs][bench]")
+{
+  // Copies, so the strings are not recognized by their address in the token heap.
+  std::vector<std::string> wks;
+  std::vector<std::string> others{std::begin(other_names), std::end(other_names)};
+  for (int i = 0; i < hdrtoken_num_wks; ++i) {
+    wks.emplace_back(hdrtoken_strs[i]);
+  }
+
+  for (size_t i = 0; i < wks.size(); ++i) {
+    REQUIRE(hdrtoken_tokenize(wks[i].data(), wks[i].size()) == static_cast<int>(i));
+    REQUIRE(reference::tokenize(wks[i].data(), wks[i].size()) == static_cast<int>(i));
+  }
+  for (auto const &name : others) {
+    REQUIRE(hdrtoken_tokenize(name.data(), name.size()) == -1);
+    REQUIRE(reference::tokenize(name.data(), name.size()) == -1);
+  }
+
+  auto run = [](std::vector<std::string> const &names, auto &&tokenize) {
+    int n = 0;
+    for (auto const &name : names) {
+      n += tokenize(name.data(), name.size()) >= 0;
+    }
+    return n;
+  };
+
+  BENCHMARK("FNV table, WKS")
+  {
+    return run(wks, reference::tokenize);
+  };
+
+  BENCHMARK("perfect hash, WKS")
+  {
+    return run(wks, [](const char *s, int len) { return hdrtoken_tokenize(s, len); });
+  };
+
+  BENCHMARK("FNV table, other names")
+  {
+    return run(others, reference::tokenize);
+  };
+
+  BENCHMARK("perfect hash, other names")
+  {
+    return run(others, [](const char *s, int len) { return hdrtoken_tokenize(s, len); });
+  };
+}
+
+int
+main(int argc, char *argv[])
+{
+  hdrtoken_init();
+  reference::init();
+
+  return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,578 @@
+/** @file
+
+  Micro benchmark for the HPACK / QPACK Huffman codec.
+
+  Compares the table driven decoder and the 64 bit accumulator encoder against the previous bit-at-a-time tree walking
+  implementation, which is kept here as a reference. Run with e.g.
+  ```
+  $ ./benchmark_Huffmancode --benchmark-samples 200
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "proxy/hdrs/HuffmanCodec.h"
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Header values as seen in typical browser requests and CDN responses.
+constexpr std::string_view request_values[] = {
+  "www.example.com",
+  "/assets/js/vendor.7f3c2a9b1e.min.js?v=20240115",
+  "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0.0.0 Safari/537.36",
+  "text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,image/apng,*/*;q=0.8",
+  "gzip, deflate, br, zstd",
+  "en-US,en;q=0.9,de;q=0.8",
+  "https://www.example.com/products/category/shoes?page=2&sort=price_asc",
+  "_ga=GA1.2.1234567890.1700000000; _gid=GA1.2.987654321.1700000000; session_id=a8f5f167f44f4964e6c998dee827110c; consent=1",
+  "\"Not_A Brand\";v=\"8\", \"Chromium\";v=\"120\", \"Google Chrome\";v=\"120\"",
+  "?0",
+  "\"Windows\"",
+  "same-origin",
+  "no-cache",
+};
+
+constexpr std::string_view response_values[] = {
+  "200",
+  "Mon, 21 Oct 2013 20:13:21 GMT",
+  "public, max-age=31536000, immutable",
+  "application/javascript; charset=utf-8",
+  "\"5f3e1c2a-1b4d3\"",
+  "Accept-Encoding, Origin",
+  "ATS/10.0.0",
+  "HIT, MISS",
+  "max-age=63072000; includeSubDomains; preload",
+  "bytes",
+  "184093",
+  "1a2b3c4d5e6f7a8b9c0d1e2f3a4b5c6d",
+};
+
+// The previous implementation, walking a pointer based code tree one bit at a time and encoding into a 32 bit buffer.
+namespace reference
+{
+  constexpr uint32_t MAX_HUFFMAN_CODE_LEN = 30;
+  constexpr uint32_t EOS                  = 0x3fffffff;
+
+  struct Node {
+    Node *left       = nullptr;
+    Node *right      = nullptr;
+    char  ascii_code = '\0';
+    bool  leaf_node  = false;
+  };
+
+  struct Code {
+    uint32_t code_as_hex;
+    uint32_t bit_len;
+  };
+
+  // RFC 7541 Appendix B, indexed by symbol, EOS last. Kept separate from the codec so the two are checked against each other.
+  const Code codes[257] = {
+    {0x1ff8,     13},
+    {0x7fffd8,   23},
+    {0xfffffe2,  28},
+    {0xfffffe3,  28},
+    {0xfffffe4,  28},
+    {0xfffffe5,  28},
+    {0xfffffe6,  28},
+    {0xfffffe7,  28},
+    {0xfffffe8,  28},
+    {0xffffea,   24},
+    {0x3ffffffc, 30},
+    {0xfffffe9,  28},
+    {0xfffffea,  28},
+    {0x3ffffffd, 30},
+    {0xfffffeb,  28},
+    {0xfffffec,  28},
+    {0xfffffed,  28},
+    {0xfffffee,  28},
+    {0xfffffef,  28},
+    {0xffffff0,  28},
+    {0xffffff1,  28},
+    {0xffffff2,  28},
+    {0x3ffffffe, 30},
+    {0xffffff3,  28},
+    {0xffffff4,  28},
+    {0xffffff5,  28},
+    {0xffffff6,  28},
+    {0xffffff7,  28},
+    {0xffffff8,  28},
+    {0xffffff9,  28},
+    {0xffffffa,  28},
+    {0xffffffb,  28},
+    {0x14,       6 },
+    {0x3f8,      10},
+    {0x3f9,      10},
+    {0xffa,      12},
+    {0x1ff9,     13},
+    {0x15,       6 },
+    {0xf8,       8 },
+    {0x7fa,      11},
+    {0x3fa,      10},
+    {0x3fb,      10},
+    {0xf9,       8 },
+    {0x7fb,      11},
+    {0xfa,       8 },
+    {0x16,       6 },
+    {0x17,       6 },
+    {0x18,       6 },
+    {0x0,        5 },
+    {0x1,        5 },
+    {0x2,        5 },
+    {0x19,       6 },
+    {0x1a,       6 },
+    {0x1b,       6 },
+    {0x1c,       6 },
+    {0x1d,       6 },
+    {0x1e,       6 },
+    {0x1f,       6 },
+    {0x5c,       7 },
+    {0xfb,       8 },
+    {0x7ffc,     15},
+    {0x20,       6 },
+    {0xffb,      12},
+    {0x3fc,      10},
+    {0x1ffa,     13},
+    {0x21,       6 },
+    {0x5d,       7 },
+    {0x5e,       7 },
+    {0x5f,       7 },
+    {0x60,       7 },
+    {0x61,       7 },
+    {0x62,       7 },
+    {0x63,       7 },
+    {0x64,       7 },
+    {0x65,       7 },
+    {0x66,       7 },
+    {0x67,       7 },
+    {0x68,       7 },
+    {0x69,       7 },
+    {0x6a,       7 },
+    {0x6b,       7 },
+    {0x6c,       7 },
+    {0x6d,       7 },
+    {0x6e,       7 },
+    {0x6f,       7 },
+    {0x70,       7 },
+    {0x71,       7 },
+    {0x72,       7 },
+    {0xfc,       8 },
+    {0x73,       7 },
+    {0xfd,       8 },
+    {0x1ffb,     13},
+    {0x7fff0,    19},
+    {0x1ffc,     13},
+    {0x3ffc,     14},
+    {0x22,       6 },
+    {0x7ffd,     15},
+    {0x3,        5 },
+    {0x23,       6 },
+    {0x4,        5 },
+    {0x24,       6 },
+    {0x5,        5 },
+    {0x25,       6 },
+    {0x26,       6 },
+    {0x27,       6 },
+    {0x6,        5 },
+    {0x74,       7 },
+    {0x75,       7 },
+    {0x28,       6 },
+    {0x29,       6 },
+    {0x2a,       6 },
+    {0x7,        5 },
+    {0x2b,       6 },
+    {0x76,       7 },
+    {0x2c,       6 },
+    {0x8,        5 },
+    {0x9,        5 },
+    {0x2d,       6 },
+    {0x77,       7 },
+    {0x78,       7 },
+    {0x79,       7 },
+    {0x7a,       7 },
+    {0x7b,       7 },
+    {0x7ffe,     15},
+    {0x7fc,      11},
+    {0x3ffd,     14},
+    {0x1ffd,     13},
+    {0xffffffc,  28},
+    {0xfffe6,    20},
+    {0x3fffd2,   22},
+    {0xfffe7,    20},
+    {0xfffe8,    20},
+    {0x3fffd3,   22},
+    {0x3fffd4,   22},
+    {0x3fffd5,   22},
+    {0x7fffd9,   23},
+    {0x3fffd6,   22},
+    {0x7fffda,   23},
+    {0x7fffdb,   23},
+    {0x7fffdc,   23},
+    {0x7fffdd,   23},
+    {0x7fffde,   23},
+    {0xffffeb,   24},
+    {0x7fffdf,   23},
+    {0xffffec,   24},
+    {0xffffed,   24},
+    {0x3fffd7,   22},
+    {0x7fffe0,   23},
+    {0xffffee,   24},
+    {0x7fffe1,   23},
+    {0x7fffe2,   23},
+    {0x7fffe3,   23},
+    {0x7fffe4,   23},
+    {0x1fffdc,   21},
+    {0x3fffd8,   22},
+    {0x7fffe5,   23},
+    {0x3fffd9,   22},
+    {0x7fffe6,   23},
+    {0x7fffe7,   23},
+    {0xffffef,   24},
+    {0x3fffda,   22},
+    {0x1fffdd,   21},
+    {0xfffe9,    20},
+    {0x3fffdb,   22},
+    {0x3fffdc,   22},
+    {0x7fffe8,   23},
+    {0x7fffe9,   23},
+    {0x1fffde,   21},
+    {0x7fffea,   23},
+    {0x3fffdd,   22},
+    {0x3fffde,   22},
+    {0xfffff0,   24},
+    {0x1fffdf,   21},
+    {0x3fffdf,   22},
+    {0x7fffeb,   23},
+    {0x7fffec,   23},
+    {0x1fffe0,   21},
+    {0x1fffe1,   21},
+    {0x3fffe0,   22},
+    {0x1fffe2,   21},
+    {0x7fffed,   23},
+    {0x3fffe1,   22},
+    {0x7fffee,   23},
+    {0x7fffef,   23},
+    {0xfffea,    20},
+    {0x3fffe2,   22},
+    {0x3fffe3,   22},
+    {0x3fffe4,   22},
+    {0x7ffff0,   23},
+    {0x3fffe5,   22},
+    {0x3fffe6,   22},
+    {0x7ffff1,   23},
+    {0x3ffffe0,  26},
+    {0x3ffffe1,  26},
+    {0xfffeb,    20},
+    {0x7fff1,    19},
+    {0x3fffe7,   22},
+    {0x7ffff2,   23},
+    {0x3fffe8,   22},
+    {0x1ffffec,  25},
+    {0x3ffffe2,  26},
+    {0x3ffffe3,  26},
+    {0x3ffffe4,  26},
+    {0x7ffffde,  27},
+    {0x7ffffdf,  27},
+    {0x3ffffe5,  26},
+    {0xfffff1,   24},
+    {0x1ffffed,  25},
+    {0x7fff2,    19},
+    {0x1fffe3,   21},
+    {0x3ffffe6,  26},
+    {0x7ffffe0,  27},
+    {0x7ffffe1,  27},
+    {0x3ffffe7,  26},
+    {0x7ffffe2,  27},
+    {0xfffff2,   24},
+    {0x1fffe4,   21},
+    {0x1fffe5,   21},
+    {0x3ffffe8,  26},
+    {0x3ffffe9,  26},
+    {0xffffffd,  28},
+    {0x7ffffe3,  27},
+    {0x7ffffe4,  27},
+    {0x7ffffe5,  27},
+    {0xfffec,    20},
+    {0xfffff3,   24},
+    {0xfffed,    20},
+    {0x1fffe6,   21},
+    {0x3fffe9,   22},
+    {0x1fffe7,   21},
+    {0x1fffe8,   21},
+    {0x7ffff3,   23},
+    {0x3fffea,   22},
+    {0x3fffeb,   22},
+    {0x1ffffee,  25},
+    {0x1ffffef,  25},
+    {0xfffff4,   24},
+    {0xfffff5,   24},
+    {0x3ffffea,  26},
+    {0x7ffff4,   23},
+    {0x3ffffeb,  26},
+    {0x7ffffe6,  27},
+    {0x3ffffec,  26},
+    {0x3ffffed,  26},
+    {0x7ffffe7,  27},
+    {0x7ffffe8,  27},
+    {0x7ffffe9,  27},
+    {0x7ffffea,  27},
+    {0x7ffffeb,  27},
+    {0xffffffe,  28},
+    {0x7ffffec,  27},
+    {0x7ffffed,  27},
+    {0x7ffffee,  27},
+    {0x7ffffef,  27},
+    {0x7fffff0,  27},
+    {0x3ffffee,  26},
+    {0x3fffffff, 30}
+  };
+
+  Node *root = nullptr;
+
+  void
+  insert(Node *node, Code code, char ascii_code)
+  {
+    for (uint32_t bit_len = code.bit_len; bit_len > 0; --bit_len) {
+      Node *&next = code.code_as_hex & (1 << (bit_len - 1)) ? node->right : node->left;
+      if (!next) {
+        next = new Node;
+      }
+      node = next;
+    }
+    node->ascii_code = ascii_code;
+    node->leaf_node  = true;
+  }
+
+  void
+  init()
+  {
+    if (root) {
+      return;
+    }
+    root = new Node;
+    for (unsigned sym = 0; sym < 257; ++sym) {
+      insert(root, codes[sym], sym);
+    }
+  }
+
+  int64_t
+  huffman_decode(char *dst_start, const uint8_t *src, uint32_t src_len)
+  {
+    char    *dst_end   = dst_start;
+    uint8_t  shift     = 7;
+    Node    *current   = root;
+    uint32_t nbits     = 0;
+    uint32_t curr_bits = 0;
+
+    while (src_len) {
+      if (nbits > 0) {
+        curr_bits <<= 1;
+      }
+      if (*src & (1 << shift)) {
+        curr_bits |= 1;
+        current    = current->right;
+      } else {
+        current = current->left;
+      }
+      ++nbits;
+
+      if (current->leaf_node == true) {
+        if (curr_bits == EOS) {
+          return -1;
+        }
+        nbits     = 0;
+        curr_bits = 0;
+        *dst_end  = current->ascii_code;
+        ++dst_end;
+        current = root;
+      }
+
+      if (shift) {
+        --shift;
+      } else {
+        shift = 7;
+        ++src;
+        --src_len;
+      }
+
+      if (nbits > MAX_HUFFMAN_CODE_LEN) {
+        return -1;
+      }
+    }
+
+    if (nbits > 7) {
+      return -1;
+    }
+
+    uint8_t mask = (1 << nbits) - 1;
+    if ((mask & curr_bits) != mask) {
+      return -1;
+    }
+
+    return dst_end - dst_start;
+  }
+
+  int64_t
+  huffman_encode(uint8_t *dst_start, const uint8_t *src, uint32_t src_len)
+  {
+    uint8_t *dst         = dst_start;
+    uint32_t buf         = 0;
+    uint32_t remain_bits = 32;
+
+    for (uint32_t i = 0; i < src_len; ++i) {
+      const uint32_t hex     = codes[src[i]].code_as_hex;
+      const uint32_t bit_len = codes[src[i]].bit_len;
+
+      if (remain_bits > bit_len) {
+        remain_bits  = remain_bits - bit_len;
+        buf         |= hex << remain_bits;
+      } else if (remain_bits == bit_len) {
+        buf         |= hex;
+        dst          = huffman_encode_append(dst, buf, 0);
+        remain_bits  = 32;
+        buf          = 0;
+      } else {
+        buf         |= hex >> (bit_len - remain_bits);
+        dst          = huffman_encode_append(dst, buf, 0);
+        remain_bits  = (32 - (bit_len - remain_bits));
+        buf          = hex << remain_bits;
+      }
+    }
+
+    dst = huffman_encode_append(dst, buf, remain_bits / 8);
+
+    uint32_t pad_len = remain_bits % 8;
+    if (pad_len) {
+      *(dst - 1) |= 0xff >> (8 - pad_len);
+    }
+
+    return dst - dst_start;
+  }
+} // namespace reference
+
+struct Corpus {
+  std::vector<std::string_view>      plain;
+  std::vector<std::vector<uint8_t>> encoded;
+
+  template <size_t N> explicit Corpus(const std::string_view (&values)[N])
+  {
+    for (auto v : values) {
+      std::vector<uint8_t> buf(v.size() * 4 + 4);
+      buf.resize(::huffman_encode(buf.data(), reinterpret_cast<const uint8_t *>(v.data()), v.size()));
+      plain.push_back(v);
+      encoded.push_back(std::move(buf));
+    }
+  }
+};
+
+template <typename F>
+int64_t
+decode_all(const Corpus &corpus, F &&decode)
+{
+  static char dst[4096];
+  int64_t     total = 0;
+
+  for (auto const &e : corpus.encoded) {
+    total += decode(dst, e.data(), e.size());
+  }
+  return total;
+}
+
+template <typename F>
+int64_t
+encode_all(const Corpus &corpus, F &&encode)
+{
+  static uint8_t dst[4096];
+  int64_t        total = 0;
+
+  for (auto v : corpus.plain) {
+    total += encode(dst, reinterpret_cast<const uint8_t *>(v.data()), v.size());
+  }
+  return total;
+}
+
+const std::vector<std::pair<std::string, Corpus>> &
+corpora()
+{
+  static const std::vector<std::pair<std::string, Corpus>> corpora = {
+    {"request",  Corpus{request_values} },
+    {"response", Corpus{response_values}},
+  };
+  return corpora;
+}
+
+} // end anonymous namespace
+
+TEST_CASE("Huffman decode", "[proxy][huffman][bench]")
+{
+  reference::init();
+
+  for (auto const &[name, corpus] : corpora()) {
+    // Both implementations must agree before they are compared.
+    for (size_t i = 0; i < corpus.plain.size(); ++i) {
+      char    dst[4096];
+      int64_t len = reference::huffman_decode(dst, corpus.encoded[i].data(), corpus.encoded[i].size());
+      REQUIRE(std::string_view{dst, static_cast<size_t>(len)} == corpus.plain[i]);
+      len = ::huffman_decode(dst, corpus.encoded[i].data(), corpus.encoded[i].size());
+      REQUIRE(std::string_view{dst, static_cast<size_t>(len)} == corpus.plain[i]);
+    }
+
+    BENCHMARK(std::string("tree walk ") + name)
+    {
+      return decode_all(corpus, reference::huffman_decode);
+    };
+    BENCHMARK(std::string("state table ") + name)
+    {
+      return decode_all(corpus, ::huffman_decode);
+    };
+  }
+}
+
+TEST_CASE("Huffman encode", "[proxy][huffman][bench]")
+{
+  reference::init();
+
+  for (auto const &[name, corpus] : corpora()) {
+    for (size_t i = 0; i < corpus.plain.size(); ++i) {
+      uint8_t dst[4096];
+      auto    src = reinterpret_cast<const uint8_t *>(corpus.plain[i].data());
+      int64_t len = reference::huffman_encode(dst, src, corpus.plain[i].size());
+      REQUIRE(len == static_cast<int64_t>(corpus.encoded[i].size()));
+      REQUIRE(memcmp(dst, corpus.encoded[i].data(), len) == 0);
+    }
+
+    BENCHMARK(std::string("32 bit buffer ") + name)
+    {
+      return encode_all(corpus, reference::huffman_encode);
+    };
+    BENCHMARK(std::string("64 bit accumulator ") + name)
+    {
+      return encode_all(corpus, ::huffman_encode);
+    };
+  }
+}
@@ -0,0 +1,166 @@
+/** @file
+
+  Micro benchmark for XpackDynamicTable lookups by name and value, as done by the HPACK and QPACK encoders.
+
+  Each iteration encodes a batch of CDN response header sets: every field is looked up in the dynamic table and inserted
+  unless there is an exact match. The hash index is compared against a linear scan of the table done through the public
+  lookup by index, which is what lookups by name and value used to cost. Run with e.g.
+  ```
+  $ ./benchmark_XPACK --benchmark-samples 50
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "proxy/hdrs/XPACK.h"
+
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using Field     = std::pair<std::string, std::string>;
+using HeaderSet = std::vector<Field>;
+
+constexpr int N_RESPONSES = 200;
+
+// Response headers for a mix of objects, with per response values (dates, identifiers, lengths) that keep the table churning.
+std::vector<HeaderSet>
+make_responses()
+{
+  static const char *content_types[] = {"text/html; charset=utf-8", "application/javascript", "text/css", "image/webp",
+                                        "image/jpeg", "application/json", "font/woff2", "video/mp4"};
+  std::vector<HeaderSet> responses;
+
+  for (int i = 0; i < N_RESPONSES; ++i) {
+    responses.push_back({
+      {":status",                     i % 10 ? "200" : "304"                                           },
+      {"date",                        "Mon, 21 Oct 2024 20:13:" + std::to_string(10 + i % 50) + " GMT" },
+      {"content-type",                content_types[i % std::size(content_types)]                      },
+      {"content-length",              std::to_string(1000 + i * 37)                                    },
+      {"cache-control",               i % 3 ? "public, max-age=31536000, immutable" : "no-cache"       },
+      {"etag",                        "\"5f3e1c2a-" + std::to_string(i * 7919) + "\""                  },
+      {"last-modified",               "Tue, 15 Nov 1994 12:45:26 GMT"                                  },
+      {"accept-ranges",               "bytes"                                                          },
+      {"vary",                        "Accept-Encoding"                                                },
+      {"server",                      "ATS/10.0.0"                                                     },
+      {"age",                         std::to_string(i % 600)                                          },
+      {"x-cache",                     i % 4 ? "HIT" : "MISS"                                           },
+      {"x-request-id",                "a8f5f167-f44f-4964-e6c9-" + std::to_string(100000000 + i * 13) },
+      {"strict-transport-security",   "max-age=63072000; includeSubDomains; preload"                   },
+      {"access-control-allow-origin", "*"                                                              },
+      {"alt-svc",                     "h3=\":443\"; ma=86400"                                          },
+      {"via",                         "https/1.1 edge" + std::to_string(i % 8) + ".example.net (ATS)"  },
+    });
+  }
+  return responses;
+}
+
+// The cost of a lookup before the table was indexed: compare against every entry, oldest to newest.
+XpackLookupResult
+linear_lookup(const XpackDynamicTable &dt, const std::string &name, const std::string &value)
+{
+  XpackLookupResult result;
+
+  if (dt.is_empty()) {
+    return result;
+  }
+  for (uint32_t index = dt.largest_index() + 1 - dt.count(); index <= dt.largest_index(); ++index) {
+    const char *e_name;
+    const char *e_value;
+    size_t      e_name_len;
+    size_t      e_value_len;
+
+    dt.lookup(index, &e_name, &e_name_len, &e_value, &e_value_len);
+    if (e_name_len == name.size() && memcmp(e_name, name.data(), e_name_len) == 0) {
+      result.index = index;
+      if (e_value_len == value.size() && memcmp(e_value, value.data(), e_value_len) == 0) {
+        result.match_type = XpackLookupResult::MatchType::EXACT;
+        break;
+      }
+      result.match_type = XpackLookupResult::MatchType::NAME;
+    }
+  }
+  return result;
+}
+
+template <typename F>
+int
+encode(XpackDynamicTable &dt, const std::vector<HeaderSet> &responses, F &&lookup)
+{
+  int exact = 0;
+
+  for (auto const &response : responses) {
+    for (auto const &[name, value] : response) {
+      if (lookup(dt, name, value).match_type == XpackLookupResult::MatchType::EXACT) {
+        ++exact;
+      } else {
+        dt.insert_entry(name, value);
+      }
+    }
+  }
+  return exact;
+}
+
+} // end anonymous namespace
+
+TEST_CASE("XpackDynamicTable lookup", "[xpack][bench]")
+{
+  const auto responses = make_responses();
+  auto       indexed   = [](XpackDynamicTable &dt, const std::string &name, const std::string &value) {
+    return dt.lookup(name, value);
+  };
+
+  for (uint32_t table_size : {4096, 16384, 65536}) {
+    // Both lookups must agree before they are compared.
+    XpackDynamicTable dt(table_size);
+    for (auto const &response : responses) {
+      for (auto const &[name, value] : response) {
+        XpackLookupResult expected = linear_lookup(dt, name, value);
+        XpackLookupResult actual   = dt.lookup(name, value);
+        REQUIRE(actual.match_type == expected.match_type);
+        REQUIRE(actual.index == expected.index);
+        if (actual.match_type != XpackLookupResult::MatchType::EXACT) {
+          dt.insert_entry(name, value);
+        }
+      }
+    }
+
+    std::string suffix = " " + std::to_string(table_size / 1024) + " KiB";
+
+    BENCHMARK_ADVANCED(std::string("linear scan") + suffix)(Catch::Benchmark::Chronometer meter)
+    {
+      XpackDynamicTable dt(table_size);
+      encode(dt, responses, linear_lookup);
+      meter.measure([&] { return encode(dt, responses, linear_lookup); });
+    };
+    BENCHMARK_ADVANCED(std::string("hash index") + suffix)(Catch::Benchmark::Chronometer meter)
+    {
+      XpackDynamicTable dt(table_size);
+      encode(dt, responses, indexed);
+      meter.measure([&] { return encode(dt, responses, indexed); });
+    };
+  }
+}
@@ -2102,3 +2102,132 @@ TEST_CASE("HdrTest", "[proxy][hdrtest]")
     }
   }
 }
+
+TEST_CASE("HdrTokenize", "[proxy][hdrtoken]")
+{
+  hdrtoken_init();
+
+  // A string matches the WKS that is equal to it ignoring case, or nothing.
+  auto check = [](std::string const &s) {
+    INFO(s);
+    int wks_idx = hdrtoken_tokenize(s.data(), s.size());
+    if (wks_idx >= 0) {
+      CHECK(s.size() == static_cast<size_t>(hdrtoken_index_to_length(wks_idx)));
+      CHECK(strncasecmp(s.data(), hdrtoken_index_to_wks(wks_idx), s.size()) == 0);
+    }
+    return wks_idx;
+  };
+
+  for (int i = 0; i < hdrtoken_num_wks; ++i) {
+    std::string wks{hdrtoken_index_to_wks(i)};
+    std::string upper{wks};
+    std::string lower{wks};
+    for (size_t c = 0; c < wks.size(); ++c) {
+      upper[c] = toupper(wks[c]);
+      lower[c] = tolower(wks[c]);
+    }
+    CHECK(check(wks) == i);
+    CHECK(check(upper) == i);
+    CHECK(check(lower) == i);
+
+    check(wks.substr(0, wks.size() - 1));
+    check(wks + "x");
+    for (size_t c = 0; c < wks.size(); ++c) {
+      // flipping 0x20 only changes the case of a letter, and turns '-' into CR
+      std::string flipped{wks};
+      flipped[c] ^= 0x20;
+      CHECK(check(flipped) == (isalpha(wks[c]) ? i : -1));
+      flipped[c] ^= 0x21;
+      CHECK(check(flipped) != i);
+    }
+  }
+
+  for (auto name : {"X-Request-Id", "sec-ch-ua", "Origin", "CDN-Loop", "Accept-", "Content-Lengths", "Hos", ""}) {
+    CHECK(check(name) == -1);
+  }
+}
+
+TEST_CASE("HdrHeapDuplicate", "[proxy][hdrheap]")
+{
+  auto print = [](HTTPHdr const &hdr) {
+    char buf[4096];
+    int  bufindex = 0, dumpoffset = 0;
+    REQUIRE(hdr.print(buf, sizeof(buf), &bufindex, &dumpoffset) == 1);
+    return std::string(buf, bufindex);
+  };
+
+  // A typical cached response, enough fields to need more than one field block.
+  std::string text = "HTTP/1.1 200 OK\r\n"
+                     "Date: Mon, 15 Jan 2024 10:00:00 GMT\r\n"
+                     "Content-Type: text/html; charset=utf-8\r\n"
+                     "Content-Length: 48213\r\n"
+                     "Cache-Control: public, max-age=300\r\n"
+                     "ETag: \"5f3e1c2a-1b4d3\"\r\n"
+                     "Last-Modified: Sun, 14 Jan 2024 22:41:09 GMT\r\n"
+                     "Vary: Accept-Encoding\r\n"
+                     "Set-Cookie: a=1; Path=/\r\n"
+                     "Set-Cookie: b=2; Path=/\r\n";
+  for (int i = 0; i < 30; ++i) {
+    text += "X-Field-" + std::to_string(i) + ": value " + std::to_string(i) + "\r\n";
+  }
+  text += "Set-Cookie: c=3; Path=/\r\n"
+          "\r\n";
+
+  HTTPHdr     hdr;
+  HTTPParser  parser;
+  const char *start = text.data();
+
+  hdr.create(HTTPType::RESPONSE);
+  http_parser_init(&parser);
+  REQUIRE(hdr.parse_resp(&parser, &start, text.data() + text.size(), true) == ParseResult::DONE);
+  http_parser_clear(&parser);
+  std::string const expected = print(hdr);
+
+  // Marshal and unmarshal as the cache does.
+  TestRefCountObj ref;
+  ref.refcount_inc();
+  int                     marshal_len = hdr.m_heap->marshal_length();
+  std::unique_ptr<char[]> marshal_buf(new char[marshal_len]);
+  REQUIRE(hdr.m_heap->marshal(marshal_buf.get(), marshal_len) > 0);
+  hdr.destroy();
+
+  HTTPHdr cached;
+  cached.create(HTTPType::RESPONSE);
+  cached.unmarshal(marshal_buf.get(), marshal_len, &ref);
+  REQUIRE(print(cached) == expected);
+
+  HTTPHdr copy;
+  copy.copy(&cached);
+  REQUIRE(copy.valid());
+  CHECK(copy.m_heap != cached.m_heap);
+  CHECK(copy.m_heap->m_writeable);
+  CHECK(copy.m_heap->m_next == nullptr);
+  // The strings are shared with the marshal buffer.
+  CHECK(ref.refcount() == 2);
+  CHECK(print(copy) == expected);
+
+  auto in_heap = [](HTTPHdr const &h, const void *p) {
+    return static_cast<const char *>(p) >= h.m_heap->m_data_start && static_cast<const char *>(p) < h.m_heap->m_free_start;
+  };
+  int n_dups = 0;
+  for (MIMEField *field = copy.field_find("Set-Cookie"sv); field != nullptr; field = field->m_next_dup) {
+    CHECK(in_heap(copy, field));
+    ++n_dups;
+  }
+  CHECK(n_dups == 3);
+  CHECK(copy.value_get("X-Field-29"sv) == "value 29"sv);
+
+  // Changing the copy leaves the cached header alone.
+  copy.value_set("Cache-Control"sv, "no-store"sv);
+  copy.field_delete("Set-Cookie"sv);
+  for (int i = 0; i < 20; ++i) {
+    copy.value_set("X-Added-" + std::to_string(i), "added");
+  }
+  CHECK(copy.value_get("Cache-Control"sv) == "no-store"sv);
+  CHECK(copy.value_get("X-Added-19"sv) == "added"sv);
+  CHECK(copy.field_find("Set-Cookie"sv) == nullptr);
+  CHECK(print(cached) == expected);
+
+  copy.destroy();
+  CHECK(ref.refcount() == 1);
+}
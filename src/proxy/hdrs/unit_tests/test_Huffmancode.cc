@@ -206,3 +206,24 @@ TEST_CASE("decode_errors", "[proxy][huffman]")
     free(dst);
   }
 }
+
+TEST_CASE("round_trip", "[proxy][huffman]")
+{
+  uint8_t src[1024];
+  uint8_t encoded[sizeof(src) * 4];
+  char    decoded[sizeof(src)];
+
+  for (int i = 0; i < 100; i++) {
+    uint32_t src_len = lrand48() % sizeof(src);
+    for (uint32_t j = 0; j < src_len; j++) {
+      // coverity[dont_call]
+      src[j] = static_cast<uint8_t>(lrand48());
+    }
+
+    int64_t encoded_len = huffman_encode(encoded, src, src_len);
+    REQUIRE(encoded_len >= 0);
+    int64_t decoded_len = huffman_decode(decoded, encoded, encoded_len);
+    REQUIRE(decoded_len == src_len);
+    REQUIRE(memcmp(src, decoded, src_len) == 0);
+  }
+}
@@ -124,9 +124,6 @@ TEST_CASE("XPACK_String", "[xpack]")
 
   SECTION("Decoding")
   {
-    // Decoding string needs huffman tree
-    hpack_huffman_init();
-
     for (const auto &i : string_test_case) {
       Arena    arena;
       char    *actual     = nullptr;
@@ -393,6 +390,66 @@ TEST_CASE("XPACK_String", "[xpack]")
       dt.insert_entry(name, value);
     }
   }
+
+  SECTION("Dynamic Table Lookup by Name and Value")
+  {
+    constexpr uint16_t MAX_SIZE = 128;
+    XpackDynamicTable  dt(MAX_SIZE);
+    XpackLookupResult  result;
+
+    // Each entry takes 34 bytes, so three of them fit.
+    dt.insert_entry("a", "1");
+    dt.insert_entry("b", "2");
+    dt.insert_entry("a", "3");
+
+    result = dt.lookup("a", "1");
+    REQUIRE(result.match_type == XpackLookupResult::MatchType::EXACT);
+    REQUIRE(result.index == 0);
+    result = dt.lookup("a", "3");
+    REQUIRE(result.match_type == XpackLookupResult::MatchType::EXACT);
+    REQUIRE(result.index == 2);
+    // The newest entry with the name is preferred.
+    result = dt.lookup("a", "9");
+    REQUIRE(result.match_type == XpackLookupResult::MatchType::NAME);
+    REQUIRE(result.index == 2);
+    result = dt.lookup("b", "9");
+    REQUIRE(result.match_type == XpackLookupResult::MatchType::NAME);
+    REQUIRE(result.index == 1);
+    result = dt.lookup("c", "1");
+    REQUIRE(result.match_type == XpackLookupResult::MatchType::NONE);
+    result = dt.lookup("", "1");
+    REQUIRE(result.match_type == XpackLookupResult::MatchType::NONE);
+
+    // The oldest entry is preferred for exact matches.
+    dt.insert_entry("b", "2"); // Evicts a: 1
+    REQUIRE(dt.count() == 3);
+    result = dt.lookup("b", "2");
+    REQUIRE(result.match_type == XpackLookupResult::MatchType::EXACT);
+    REQUIRE(result.index == 1);
+    result = dt.lookup("a", "1");
+    REQUIRE(result.match_type == XpackLookupResult::MatchType::NAME);
+    REQUIRE(result.index == 2);
+
+    dt.insert_entry("c", "4"); // Evicts b: 2
+    dt.insert_entry("c", "5"); // Evicts a: 3
+    result = dt.lookup("b", "2");
+    REQUIRE(result.match_type == XpackLookupResult::MatchType::EXACT);
+    REQUIRE(result.index == 3);
+    result = dt.lookup("a", "3");
+    REQUIRE(result.match_type == XpackLookupResult::MatchType::NONE);
+    result = dt.lookup("c", "9");
+    REQUIRE(result.match_type == XpackLookupResult::MatchType::NAME);
+    REQUIRE(result.index == 5);
+
+    // Relative indices are counted from the newest entry.
+    result = dt.lookup_relative("b", "2");
+    REQUIRE(result.match_type == XpackLookupResult::MatchType::EXACT);
+    REQUIRE(result.index == 2);
+
+    dt.update_maximum_size(0);
+    result = dt.lookup("c", "5");
+    REQUIRE(result.match_type == XpackLookupResult::MatchType::NONE);
+  }
 }
 
 // Return a 110 character string.
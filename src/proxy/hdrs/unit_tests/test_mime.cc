@@ -23,7 +23,10 @@
 
 #include <cstdio>
 
+#include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 using namespace std::literals;
 
@@ -232,3 +235,85 @@ TEST_CASE("MimeParsers", "[proxy][mimeparsers]")
   std::printf("Date1: %" PRIdMAX "\n", d1);
   std::printf("Date2: %" PRIdMAX "\n", d2);
 }
+
+namespace
+{
+struct ParsedFields {
+  ParseResult                                      result;
+  size_t                                           consumed;
+  std::vector<std::pair<std::string, std::string>> fields;
+};
+
+// Parse @a text in two pieces, split at @a split, so that the line across the split goes through the scanner.
+ParsedFields
+parse_fields(std::string_view text, size_t split)
+{
+  std::string copy{text}; // folding is done in place
+  MIMEParser  parser;
+  MIMEHdr     hdr;
+  hdr.create(nullptr);
+  mime_parser_init(&parser);
+
+  ParsedFields parsed;
+  char const  *start = copy.data();
+  char const  *end   = copy.data() + copy.size();
+  parsed.result      = ParseResult::CONT;
+  if (split < copy.size()) {
+    parsed.result = hdr.parse(&parser, &start, copy.data() + split, false, false, false);
+  }
+  if (parsed.result == ParseResult::CONT) {
+    parsed.result = hdr.parse(&parser, &start, end, false, true, false);
+  }
+  parsed.consumed = start - copy.data();
+  for (auto const &field : hdr) {
+    parsed.fields.emplace_back(field.name_get(), field.value_get());
+  }
+
+  mime_parser_clear(&parser);
+  hdr.destroy();
+  return parsed;
+}
+} // end anonymous namespace
+
+TEST_CASE("MimeParserLines", "[proxy][mimeparser]")
+{
+  using Fields = std::vector<std::pair<std::string, std::string>>;
+  struct Test {
+    std::string_view text;
+    ParseResult      result;
+    Fields           fields;
+  };
+  static const std::vector<Test> tests = {
+    {"Host: example.com\r\nAccept:  */* \r\n\r\n"sv, ParseResult::DONE, {{"Host", "example.com"}, {"Accept", "*/*"}}},
+    {"Host: example.com\nAccept: */*\n\n"sv, ParseResult::DONE, {{"Host", "example.com"}, {"Accept", "*/*"}}},
+    {"X-Long-Custom-Header-Name: a\tvalue: with colons\r\n\r\n"sv, ParseResult::DONE,
+     {{"X-Long-Custom-Header-Name", "a\tvalue: with colons"}}},
+    {"X-Folded: one\r\n two\r\nHost: h\r\n\r\n"sv, ParseResult::DONE, {{"X-Folded", "one   two"}, {"Host", "h"}}},
+    {"no colon here\r\nHost: h\r\n\r\n"sv, ParseResult::DONE, {{"Host", "h"}}},
+    {"X-High: caf\xc3\xa9\r\n\r\n"sv, ParseResult::DONE, {{"X-High", "caf\xc3\xa9"}}},
+    {"Host: h\r\nX-Very-Long-Header-Name-Over-Sixteen: v\x01v\r\n\r\n"sv, ParseResult::ERROR, {{"Host", "h"}}},
+    {"X-Bare-Cr: a\rb\r\n\r\n"sv, ParseResult::ERROR, {}},
+    {"X-Nul: a\0b\r\n\r\n"sv, ParseResult::ERROR, {}},
+    {"X-Del-Past-Sixteen-Bytes: abc\x7f\r\n\r\n"sv, ParseResult::ERROR, {}},
+    {"X-Space : v\r\n\r\n"sv, ParseResult::ERROR, {}},
+    {"Host: h\r\nX-No-End: v"sv, ParseResult::ERROR, {{"Host", "h"}}},
+  };
+
+  for (auto const &test : tests) {
+    INFO(test.text);
+    // A split in a line sends the line through the scanner. A split in or right after a line end is
+    // skipped, the scanner does not look for a folded line across it.
+    for (size_t split = 0; split <= test.text.size(); ++split) {
+      if (split > 0 && split < test.text.size() && (test.text[split - 1] == '\r' || test.text[split - 1] == '\n')) {
+        continue;
+      }
+      INFO("split at " << split);
+      auto parsed = parse_fields(test.text, split);
+      CHECK(parsed.result == test.result);
+      CHECK(parsed.fields == test.fields);
+      if (test.result == ParseResult::DONE) {
+        CHECK(parsed.consumed == test.text.size());
+      }
+    }
+  }
+}
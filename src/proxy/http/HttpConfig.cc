@@ -174,6 +174,7 @@ static const ConfigEnumPair<TSServerSessionSharingPoolType> SessionSharingPoolSt
   {TS_SERVER_SESSION_SHARING_POOL_THREAD,        "thread"       },
   {TS_SERVER_SESSION_SHARING_POOL_HYBRID,        "hybrid"       },
   {TS_SERVER_SESSION_SHARING_POOL_GLOBAL_LOCKED, "global_locked"},
+  {TS_SERVER_SESSION_SHARING_POOL_SHARDED,       "sharded"      },
 };
 
 int              HttpConfig::m_id = 0;
@@ -292,6 +293,7 @@ register_stat_callbacks()
   http_rsb.cache_open_write_begin_time       = Metrics::Counter::createPtr("proxy.process.http.milestone.cache_open_write_begin");
   http_rsb.cache_open_write_end_time         = Metrics::Counter::createPtr("proxy.process.http.milestone.cache_open_write_end");
   http_rsb.cache_open_write_fail_count       = Metrics::Counter::createPtr("proxy.process.http.cache_open_write_fail_count");
+  http_rsb.cache_ram_hit_fast_path           = Metrics::Counter::createPtr("proxy.process.http.cache_ram_hit_fast_path");
   http_rsb.cache_read_error                  = Metrics::Counter::createPtr("proxy.process.http.cache_read_error");
   http_rsb.cache_read_errors                 = Metrics::Counter::createPtr("proxy.process.http.cache_read_errors");
   http_rsb.cache_updates                     = Metrics::Counter::createPtr("proxy.process.http.cache_updates");
@@ -390,6 +392,9 @@ register_stat_callbacks()
   http_rsb.parent_proxy_response_total_bytes = Metrics::Counter::createPtr("proxy.process.http.parent_proxy_response_total_bytes");
   http_rsb.parent_proxy_transaction_time     = Metrics::Counter::createPtr("proxy.process.http.parent_proxy_transaction_time");
   http_rsb.pooled_server_connections         = Metrics::Gauge::createPtr("proxy.process.http.pooled_server_connections");
+  http_rsb.pooled_server_session_hits        = Metrics::Counter::createPtr("proxy.process.http.pooled_server_session.hits");
+  http_rsb.pooled_server_session_misses      = Metrics::Counter::createPtr("proxy.process.http.pooled_server_session.misses");
+  http_rsb.pooled_server_session_steals      = Metrics::Counter::createPtr("proxy.process.http.pooled_server_session.steals");
   http_rsb.post_body_too_large               = Metrics::Counter::createPtr("proxy.process.http.post_body_too_large");
   http_rsb.post_requests                     = Metrics::Counter::createPtr("proxy.process.http.post_requests");
   http_rsb.proxy_loop_detected               = Metrics::Counter::createPtr("proxy.process.http.http_proxy_loop_detected");
@@ -1042,6 +1047,7 @@ HttpConfig::startup()
   HttpEstablishStaticConfigByte(c.oride.cache_required_headers, "proxy.config.http.cache.required_headers");
   HttpEstablishStaticConfigByte(c.oride.cache_range_lookup, "proxy.config.http.cache.range.lookup");
   HttpEstablishStaticConfigByte(c.oride.cache_range_write, "proxy.config.http.cache.range.write");
+  HttpEstablishStaticConfigLongLong(c.cache_ram_hit_fast_path_size, "proxy.config.http.cache.ram_hit_fast_path_size");
 
   HttpEstablishStaticConfigStringAlloc(c.connect_ports_string, "proxy.config.http.connect_ports");
 
@@ -1350,6 +1356,7 @@ HttpConfig::reconfigure()
   params->oride.cache_range_lookup     = INT_TO_BOOL(m_master.oride.cache_range_lookup);
   params->oride.cache_range_write      = INT_TO_BOOL(m_master.oride.cache_range_write);
   params->oride.allow_multi_range      = m_master.oride.allow_multi_range;
+  params->cache_ram_hit_fast_path_size = m_master.cache_ram_hit_fast_path_size;
 
   params->connect_ports_string = ats_strdup(m_master.connect_ports_string);
   params->connect_ports        = parse_ports_list(params->connect_ports_string);
@@ -6801,6 +6801,21 @@ HttpSM::setup_cache_read_transfer()
     doc_size += hdr_size;
   }
 
+  // A small RAM cache hit is sent straight out of the cache's buffer, the same way an internal message
+  // is, rather than running the cache read VC as a producer. The VC stays open until the transaction
+  // is done because t_state.cache_info.object_read points into it.
+  if (IOBufferBlock *body = ram_hit_body(); body != nullptr) {
+    SMDbg(dbg_ctl_http, "serving %" PRId64 " byte RAM cache hit without a cache read", body->read_avail());
+    buf->append_block(body);
+    HttpTunnelProducer *p = tunnel.add_producer(HTTP_TUNNEL_STATIC_PRODUCER, doc_size, buf_start, (HttpProducerHandler) nullptr,
+                                                HttpTunnelType_t::STATIC, "cache ram hit");
+    tunnel.add_consumer(_ua.get_entry()->vc, HTTP_TUNNEL_STATIC_PRODUCER, &HttpSM::tunnel_handler_ua, HttpTunnelType_t::HTTP_CLIENT,
+                        "user agent");
+    Metrics::Counter::increment(http_rsb.cache_ram_hit_fast_path);
+    _ua.get_entry()->in_tunnel = true;
+    return p;
+  }
+
   HttpTunnelProducer *p = tunnel.add_producer(cache_sm.cache_read_vc, doc_size, buf_start, &HttpSM::tunnel_handler_cache_read,
                                               HttpTunnelType_t::CACHE_READ, "cache read");
   tunnel.add_consumer(_ua.get_entry()->vc, cache_sm.cache_read_vc, &HttpSM::tunnel_handler_ua, HttpTunnelType_t::HTTP_CLIENT,
@@ -6820,6 +6835,25 @@ HttpSM::setup_cache_read_transfer()
   return p;
 }
 
+// IOBufferBlock* HttpSM::ram_hit_body()
+//
+//   Returns the body of the cached object if it is small enough to be served
+//     without a cache read, i.e. a RAM cache hit of a single fragment that
+//     needs no chunking and no range handling by the cache read VC.
+//
+IOBufferBlock *
+HttpSM::ram_hit_body()
+{
+  int64_t max_size = t_state.http_config_param->cache_ram_hit_fast_path_size;
+
+  if (max_size <= 0 || t_state.cache_info.object_read->object_size_get() > max_size ||
+      t_state.client_info.receive_chunked_response || t_state.range_setup == HttpTransact::RangeSetup_t::NOT_TRANSFORM_REQUESTED ||
+      !cache_sm.is_ram_cache_hit() || tunnel.get_producer(HTTP_TUNNEL_STATIC_PRODUCER) != nullptr) {
+    return nullptr;
+  }
+  return cache_sm.cache_read_vc->get_single_data_block();
+}
+
 HttpTunnelProducer *
 HttpSM::setup_cache_transfer_to_transform()
 {
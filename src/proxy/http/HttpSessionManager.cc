@@ -36,6 +36,7 @@
 #include "proxy/http/HttpSM.h"
 #include "proxy/http/HttpDebugNames.h"
 #include "iocore/net/TLSSNISupport.h"
+#include <algorithm>
 #include <iterator>
 
 namespace
@@ -397,6 +398,16 @@ HttpSessionManager::acquire_session(HttpSM *sm, sockaddr const *ip, const char *
   if (this->get_pool_type() == TS_SERVER_SESSION_SHARING_POOL_THREAD ||
       this->get_pool_type() == TS_SERVER_SESSION_SHARING_POOL_HYBRID) {
     retval = _acquire_session(ip, hostname_hash, sm, match_style, TS_SERVER_SESSION_SHARING_POOL_THREAD);
+  } else if (this->get_pool_type() == TS_SERVER_SESSION_SHARING_POOL_SHARDED) {
+    retval = _acquire_session(ip, hostname_hash, sm, match_style, TS_SERVER_SESSION_SHARING_POOL_SHARDED);
+    // Only look in the other threads when there is nothing to use here.
+    if (retval == HSMresult_t::NOT_FOUND) {
+      retval = _steal_session(ip, hostname_hash, sm, match_style);
+      if (retval == HSMresult_t::DONE) {
+        Metrics::Counter::increment(http_rsb.pooled_server_session_steals);
+        return retval;
+      }
+    }
   }
 
   //  If you didn't get a match, and the global pool is an option go there.
@@ -408,6 +419,8 @@ HttpSessionManager::acquire_session(HttpSM *sm, sockaddr const *ip, const char *
       retval = _acquire_session(ip, hostname_hash, sm, match_style, TS_SERVER_SESSION_SHARING_POOL_GLOBAL_LOCKED);
   }
 
+  Metrics::Counter::increment(retval == HSMresult_t::DONE ? http_rsb.pooled_server_session_hits :
+                                                            http_rsb.pooled_server_session_misses);
   return retval;
 }
 
@@ -421,7 +434,7 @@ lockSessionPool(Ptr<ProxyMutex> &mutex, EThread *const ethread, TSServerSessionS
                 MutexLock *const mlock, MutexTryLock *const tlock)
 {
   bool locked = false;
-  if (TS_SERVER_SESSION_SHARING_POOL_GLOBAL_LOCKED == pool_type) {
+  if (TS_SERVER_SESSION_SHARING_POOL_GLOBAL_LOCKED == pool_type || TS_SERVER_SESSION_SHARING_POOL_SHARDED == pool_type) {
     SCOPED_MUTEX_LOCK(lock, mutex, ethread);
     *mlock = std::move(lock);
     locked = true;
@@ -448,15 +461,16 @@ HttpSessionManager::_acquire_session(sockaddr const *ip, CryptoHash const &hostn
   {
     // Now check to see if we have a connection in our shared connection pool
     EThread        *ethread = this_ethread();
-    Ptr<ProxyMutex> pool_mutex =
-      (TS_SERVER_SESSION_SHARING_POOL_THREAD == pool_type) ? ethread->server_session_pool->mutex : m_g_pool->mutex;
+    bool const thread_pool =
+      TS_SERVER_SESSION_SHARING_POOL_THREAD == pool_type || TS_SERVER_SESSION_SHARING_POOL_SHARDED == pool_type;
+    Ptr<ProxyMutex> pool_mutex = thread_pool ? ethread->server_session_pool->mutex : m_g_pool->mutex;
 
     MutexLock    mlock;
     MutexTryLock tlock;
     bool const   locked = lockSessionPool(pool_mutex, ethread, pool_type, &mlock, &tlock);
 
     if (locked) {
-      if (TS_SERVER_SESSION_SHARING_POOL_THREAD == pool_type) {
+      if (thread_pool) {
         retval = ethread->server_session_pool->acquireSession(ip, hostname_hash, match_style, sm, to_return);
         Dbg(dbg_ctl_http_ss, "[acquire session] thread pool search %s", to_return ? "successful" : "failed");
       } else {
@@ -464,33 +478,8 @@ HttpSessionManager::_acquire_session(sockaddr const *ip, CryptoHash const &hostn
         Dbg(dbg_ctl_http_ss, "[acquire session] global pool search %s", to_return ? "successful" : "failed");
         // At this point to_return has been removed from the pool. Do we need to move it
         // to the same thread?
-        if (to_return) {
-          UnixNetVConnection *server_vc = dynamic_cast<UnixNetVConnection *>(to_return->get_netvc());
-          if (server_vc) {
-            // Disable i/o on this vc now, but, hold onto the g_pool cont
-            // and the mutex to stop any stray events from getting in
-            server_vc->do_io_read(m_g_pool, 0, nullptr);
-            server_vc->do_io_write(m_g_pool, 0, nullptr);
-            UnixNetVConnection *new_vc = server_vc->migrateToCurrentThread(sm, ethread);
-            // The VC moved, free up the original one
-            if (new_vc != server_vc) {
-              ink_assert(new_vc == nullptr || new_vc->nh != nullptr);
-              if (!new_vc) {
-                // Close out to_return, we were't able to get a connection
-                Metrics::Counter::increment(http_rsb.origin_shutdown_migration_failure);
-                to_return->do_io_close();
-                to_return = nullptr;
-                retval    = HSMresult_t::NOT_FOUND;
-              } else {
-                // Keep things from timing out on us
-                new_vc->set_inactivity_timeout(new_vc->get_inactivity_timeout());
-                to_return->set_netvc(new_vc);
-              }
-            } else {
-              // Keep things from timing out on us
-              server_vc->set_inactivity_timeout(server_vc->get_inactivity_timeout());
-            }
-          }
+        if (to_return && !_migrate_session(m_g_pool, to_return, sm, ethread)) {
+          retval = HSMresult_t::NOT_FOUND;
         }
       }
     } else { // Didn't get the lock.  to_return is still NULL
@@ -517,12 +506,98 @@ HttpSessionManager::_acquire_session(sockaddr const *ip, CryptoHash const &hostn
   return retval;
 }
 
+bool
+HttpSessionManager::_migrate_session(ServerSessionPool *pool, PoolableSession *&ssn, HttpSM *sm, EThread *ethread)
+{
+  UnixNetVConnection *server_vc = dynamic_cast<UnixNetVConnection *>(ssn->get_netvc());
+  if (server_vc) {
+    // Disable i/o on this vc now, but, hold onto the pool cont
+    // and the mutex to stop any stray events from getting in
+    server_vc->do_io_read(pool, 0, nullptr);
+    server_vc->do_io_write(pool, 0, nullptr);
+    UnixNetVConnection *new_vc = server_vc->migrateToCurrentThread(sm, ethread);
+    // The VC moved, free up the original one
+    if (new_vc != server_vc) {
+      ink_assert(new_vc == nullptr || new_vc->nh != nullptr);
+      if (!new_vc) {
+        // Close out ssn, we were't able to get a connection
+        Metrics::Counter::increment(http_rsb.origin_shutdown_migration_failure);
+        ssn->do_io_close();
+        ssn = nullptr;
+        return false;
+      } else {
+        // Keep things from timing out on us
+        new_vc->set_inactivity_timeout(new_vc->get_inactivity_timeout());
+        ssn->set_netvc(new_vc);
+      }
+    } else {
+      // Keep things from timing out on us
+      server_vc->set_inactivity_timeout(server_vc->get_inactivity_timeout());
+    }
+  }
+  return true;
+}
+
+HSMresult_t
+HttpSessionManager::_steal_session(sockaddr const *ip, CryptoHash const &hostname_hash, HttpSM *sm,
+                                   TSServerSessionSharingMatchMask match_style)
+{
+  EThread   *ethread = this_ethread();
+  auto const threads = eventProcessor.active_group_threads(ET_NET);
+  int const  n       = threads.end() - threads.begin();
+  // Start with the thread after this one so the threads do not all search the others in the same order.
+  int const self = std::find(threads.begin(), threads.end(), ethread) - threads.begin();
+
+  for (int i = 1; i < n; ++i) {
+    EThread           *owner = threads.begin()[(self + i) % n];
+    ServerSessionPool *pool  = owner->server_session_pool;
+    if (pool == nullptr) {
+      continue;
+    }
+    // Never wait on another thread, its pool is only worth a look if it is free.
+    MUTEX_TRY_LOCK(lock, pool->mutex, ethread);
+    if (!lock.is_locked()) {
+      continue;
+    }
+
+    PoolableSession *to_return = nullptr;
+    if (pool->acquireSession(ip, hostname_hash, match_style, sm, to_return) != HSMresult_t::DONE) {
+      continue;
+    }
+    // A multiplexed session stays in its pool to be shared by that thread, it cannot move. The origin negotiated a
+    // multiplexed protocol, so the other pools would offer the same: stop looking and connect from this thread, whose
+    // session is then shared here.
+    if (to_return->is_multiplexing()) {
+      Dbg(dbg_ctl_http_ss, "[%" PRId64 "] [acquire session] multiplexed session in the pool of thread %p, not stealing",
+          to_return->connection_id(), owner);
+      return HSMresult_t::NOT_FOUND;
+    }
+    if (!_migrate_session(pool, to_return, sm, ethread)) {
+      continue;
+    }
+
+    if (sm->create_server_txn(to_return)) {
+      Dbg(dbg_ctl_http_ss, "[%" PRId64 "] [acquire session] return session from the pool of thread %p", to_return->connection_id(),
+          owner);
+      to_return->state = PoolableSession::PooledState::SSN_IN_USE;
+      return HSMresult_t::DONE;
+    }
+    Dbg(dbg_ctl_http_ss, "[%" PRId64 "] [acquire session] failed to get transaction on session from the pool of another thread",
+        to_return->connection_id());
+    to_return->do_io_close();
+    return HSMresult_t::RETRY;
+  }
+  return HSMresult_t::NOT_FOUND;
+}
+
 HSMresult_t
 HttpSessionManager::release_session(PoolableSession *to_release)
 {
   EThread           *ethread = this_ethread();
-  ServerSessionPool *pool =
-    TS_SERVER_SESSION_SHARING_POOL_THREAD == to_release->sharing_pool ? ethread->server_session_pool : m_g_pool;
+  ServerSessionPool *pool    = (TS_SERVER_SESSION_SHARING_POOL_THREAD == to_release->sharing_pool ||
+                             TS_SERVER_SESSION_SHARING_POOL_SHARDED == to_release->sharing_pool) ?
+                                 ethread->server_session_pool :
+                                 m_g_pool;
   bool released_p = true;
 
   // The per thread lock looks like it should not be needed but if it's not locked the close checking I/O op will crash.
@@ -43,7 +43,9 @@
 #include "tscore/ink_memory.h"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstring>
 
 namespace
 {
@@ -58,6 +60,23 @@ const char *const CHUNK_HEADER_FMT         = "%" PRIx64 "\r\n";
 // a block in the input stream.
 int const CHUNK_IOBUFFER_SIZE_INDEX = MIN_IOBUFFER_SIZE;
 
+// Value of each hex digit, -1 for other characters.
+constexpr std::array<int8_t, 256> HEX_VALUE = [] {
+  std::array<int8_t, 256> table{};
+  for (int c = 0; c < 256; ++c) {
+    if (c >= '0' && c <= '9') {
+      table[c] = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      table[c] = c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      table[c] = c - 'A' + 10;
+    } else {
+      table[c] = -1;
+    }
+  }
+  return table;
+}();
+
 } // end anonymous namespace
 
 ChunkedHandler::ChunkedHandler() : max_chunk_size(DEFAULT_MAX_CHUNK_SIZE) {}
@@ -262,6 +281,97 @@ ChunkedHandler::read_size()
   return bytes_consumed;
 }
 
+// int64_t ChunkedHandler::read_chunks_in_block()
+//
+//   Dechunk as many chunks as are complete in the first block of
+//   chunked_reader, for a well formed stream of small chunks. Each size
+//   line is parsed in place, with a memchr for its LF, and the reader is
+//   consumed once for the whole run. Stops at anything else, a size line
+//   or chunk that is cut by the end of the block, a chunk large enough to
+//   block reference, the last chunk, or a line that is not a plain
+//   "<hex>[ext]CRLF", leaving the state for the byte at a time parsers.
+//
+int64_t
+ChunkedHandler::read_chunks_in_block()
+{
+  const char *const start = chunked_reader->start();
+  const char *const end   = start + chunked_reader->block_read_avail();
+  const char       *p     = start;
+
+  while (p < end) {
+    if (state == ChunkedState::READ_SIZE_START) {
+      // The CRLF after the previous chunk.
+      if (num_cr != 0 || end - p < 2 || p[0] != '\r' || p[1] != '\n') {
+        break;
+      }
+      p           += 2;
+      running_sum  = 0;
+      num_digits   = 0;
+      prev_is_cr   = true;
+      state        = ChunkedState::READ_SIZE;
+    } else if (state != ChunkedState::READ_SIZE || num_digits != 0) {
+      break;
+    }
+
+    const char *digits = p;
+    int         sum    = 0;
+    int         value;
+    while (p < end && (value = HEX_VALUE[static_cast<unsigned char>(*p)]) >= 0 && can_safely_shift_left(sum, 4)) {
+      sum = (sum << 4) + value;
+      ++p;
+    }
+    // The size must be followed by a single CR right before the LF, with an
+    // optional extension in between.
+    const char *lf = nullptr;
+    if (p > digits && p < end && (*p == '\r' || *p == ';' || ParseRules::is_ws(*p))) {
+      lf = static_cast<const char *>(memchr(p, '\n', end - p));
+    }
+    if (lf == nullptr || lf[-1] != '\r' || memchr(p, '\r', lf - 1 - p) != nullptr) {
+      p = digits;
+      break;
+    }
+    num_digits = p - digits;
+    p          = lf + 1;
+
+    Dbg(dbg_ctl_http_chunk, "read chunk size of %d bytes", sum);
+    running_sum          = sum;
+    num_cr               = 0;
+    prev_is_cr           = true;
+    cur_chunk_bytes_left = (cur_chunk_size = sum);
+    if (sum == 0) {
+      state = ChunkedState::READ_TRAILER_BLANK;
+      break;
+    }
+    state = ChunkedState::READ_CHUNK;
+
+    // The chunk body, copied for the same reason as in transfer_bytes.
+    int64_t to_move = std::min<int64_t>(cur_chunk_bytes_left, end - p);
+    if (dechunked_buffer) {
+      if (to_move >= min_block_transfer_bytes) {
+        break;
+      }
+      dechunked_buffer->write(p, to_move);
+      dechunked_size += to_move;
+    }
+    p                    += to_move;
+    cur_chunk_bytes_left -= to_move;
+    if (cur_chunk_bytes_left > 0) {
+      break;
+    }
+    state = ChunkedState::READ_SIZE_START;
+  }
+
+  int64_t bytes_used = p - start;
+  if (bytes_used > 0) {
+    if (drop_chunked_trailers) {
+      chunked_buffer->write(chunked_reader, bytes_used);
+      chunked_size += bytes_used;
+    }
+    chunked_reader->consume(bytes_used);
+  }
+  return bytes_used;
+}
+
 // int ChunkedHandler::transfer_bytes()
 //
 //   Transfer bytes from chunked_reader to dechunked buffer.
@@ -392,8 +502,13 @@ ChunkedHandler::process_chunked_content()
   while (chunked_reader->is_read_avail_more_than(0) && state != ChunkedState::READ_DONE && state != ChunkedState::READ_ERROR) {
     switch (state) {
     case ChunkedState::READ_SIZE:
-    case ChunkedState::READ_SIZE_CRLF:
     case ChunkedState::READ_SIZE_START:
+      if (int64_t const n = read_chunks_in_block(); n > 0) {
+        bytes_read += n;
+        break;
+      }
+      [[fallthrough]];
+    case ChunkedState::READ_SIZE_CRLF:
       bytes_read += read_size();
       break;
     case ChunkedState::READ_CHUNK:
@@ -41,6 +41,10 @@ constexpr std::string_view hash_url_request = "request";
 constexpr std::string_view hash_url_cache   = "cache";
 constexpr std::string_view hash_url_parent  = "parent";
 
+// hash_algorithm strings
+constexpr std::string_view hash_algorithm_ring   = "ring";
+constexpr std::string_view hash_algorithm_maglev = "maglev";
+
 static bool
 isWrapped(std::vector<bool> &wrap_around, uint32_t groups)
 {
@@ -83,6 +87,31 @@ NextHopConsistentHash::chashLookup(const std::shared_ptr<ATSConsistentHash> &rin
   }
 }
 
+std::shared_ptr<HostRecord>
+NextHopConsistentHash::maglevLookup(const std::shared_ptr<ATSMaglevHash> &table, uint32_t cur_ring, ParentResult &result,
+                                    HttpRequestData &request_info, bool *wrapped, uint64_t sm_id)
+{
+  uint64_t           hash_key = 0;
+  ATSHash64Sip24     hash;
+  HostRecord        *host_rec = nullptr;
+  ATSMaglevHashIter *iter     = &result.maglevIter[cur_ring];
+
+  // the table walk knows when it has visited every slot, so unlike the ring there is no need to track
+  // a first wrap in mapWrapped.
+  if (result.chash_init[cur_ring] == false) {
+    hash_key                    = getHashKey(sm_id, request_info, &hash);
+    host_rec                    = static_cast<HostRecord *>(table->lookup_by_hashval(hash_key, iter, wrapped));
+    result.chash_init[cur_ring] = true;
+  } else {
+    host_rec = static_cast<HostRecord *>(table->lookup_next(iter, wrapped));
+  }
+
+  if (host_rec == nullptr) {
+    return nullptr;
+  }
+  return host_groups[host_rec->group_index][host_rec->host_index];
+}
+
 NextHopConsistentHash::~NextHopConsistentHash()
 {
   NH_Dbg(NH_DBG_CTL, "destructor called for strategy named: %s", strategy_name.c_str());
@@ -140,9 +169,33 @@ NextHopConsistentHash::NextHopConsistentHash(const std::string_view name, const
                                 "', this strategy will be ignored.");
   }
 
-  // load up the hash rings.
+  try {
+    if (n["hash_algorithm"]) {
+      auto hash_algorithm_val = n["hash_algorithm"].Scalar();
+      if (hash_algorithm_val == hash_algorithm_ring) {
+        hash_algorithm = NHHashAlgorithmType::RING;
+      } else if (hash_algorithm_val == hash_algorithm_maglev) {
+        hash_algorithm = NHHashAlgorithmType::MAGLEV;
+      } else {
+        hash_algorithm = NHHashAlgorithmType::RING;
+        NH_Note("Invalid 'hash_algorithm' value, '%s', for the strategy named '%s', using default '%s'.",
+                hash_algorithm_val.c_str(), strategy_name.c_str(), hash_algorithm_ring.data());
+      }
+    }
+  } catch (std::exception &ex) {
+    throw std::invalid_argument("Error parsing the strategy named '" + strategy_name + "' due to '" + ex.what() +
+                                "', this strategy will be ignored.");
+  }
+
+  // load up the hash rings or tables.
   for (uint32_t i = 0; i < groups; i++) {
-    std::shared_ptr<ATSConsistentHash> hash_ring = std::make_shared<ATSConsistentHash>();
+    std::shared_ptr<ATSConsistentHash> hash_ring;
+    std::shared_ptr<ATSMaglevHash>     maglev_table;
+    if (hash_algorithm == NHHashAlgorithmType::MAGLEV) {
+      maglev_table = std::make_shared<ATSMaglevHash>();
+    } else {
+      hash_ring = std::make_shared<ATSConsistentHash>();
+    }
     for (uint32_t j = 0; j < host_groups[i].size(); j++) {
       // ATSConsistentHash needs the raw pointer.
       HostRecord *p = host_groups[i][j].get();
@@ -154,12 +207,23 @@ NextHopConsistentHash::NextHopConsistentHash(const std::string_view name, const
       }
       p->group_index = host_groups[i][j]->group_index;
       p->host_index  = host_groups[i][j]->host_index;
-      hash_ring->insert(p, p->weight, &hash);
+      if (maglev_table) {
+        maglev_table->insert(p, p->weight);
+      } else {
+        hash_ring->insert(p, p->weight, &hash);
+      }
       NH_Dbg(NH_DBG_CTL, "Loading hash rings - ring: %d, host record: %d, name: %s, hostname: %s, strategy: %s", i, j, p->name,
              p->hostname.c_str(), strategy_name.c_str());
     }
+    if (maglev_table) {
+      maglev_table->build(&hash);
+      NH_Dbg(NH_DBG_CTL, "Built maglev table - ring: %d, slots: %u, strategy: %s", i, maglev_table->table_size(),
+             strategy_name.c_str());
+      maglev_tables.push_back(std::move(maglev_table));
+    } else {
+      rings.push_back(std::move(hash_ring));
+    }
     hash.clear();
-    rings.push_back(std::move(hash_ring));
   }
 }
 
@@ -356,10 +420,13 @@ NextHopConsistentHash::findNextHop(TSHttpTxn txnp, void * /* ih ATS_UNUSED */, t
       }
 
       // search for available parent
-      std::shared_ptr<ATSConsistentHash> r = rings[cur_ring];
-      pRec                                 = chashLookup(r, cur_ring, result, request_info, &wrapped, sm_id);
-      hst                                  = (pRec) ? pStatus.getHostStatus(pRec->hostname.c_str()) : nullptr;
-      wrap_around[cur_ring]                = wrapped;
+      if (hash_algorithm == NHHashAlgorithmType::MAGLEV) {
+        pRec = maglevLookup(maglev_tables[cur_ring], cur_ring, result, request_info, &wrapped, sm_id);
+      } else {
+        pRec = chashLookup(rings[cur_ring], cur_ring, result, request_info, &wrapped, sm_id);
+      }
+      hst                   = (pRec) ? pStatus.getHostStatus(pRec->hostname.c_str()) : nullptr;
+      wrap_around[cur_ring] = wrapped;
       lookups++;
 
       // found a parent
@@ -0,0 +1,262 @@
+/** @file
+
+    Literal prefilter for regex remap rules.
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "proxy/http/remap/RegexPrefilter.h"
+
+#include "tscore/ink_assert.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <deque>
+
+namespace
+{
+// Shorter literals occur in too many hosts to be worth the automaton states.
+constexpr size_t MIN_LITERAL_LEN = 3;
+
+} // end anonymous namespace
+
+int
+RegexPrefilter::symbol(char c)
+{
+  if (c >= 'a' && c <= 'z') {
+    return c - 'a';
+  }
+  if (c >= '0' && c <= '9') {
+    return 26 + (c - '0');
+  }
+  switch (c) {
+  case '.':
+    return 36;
+  case '-':
+    return 37;
+  case '_':
+    return 38;
+  default:
+    return -1;
+  }
+}
+
+std::string
+RegexPrefilter::required_literal(std::string_view pattern)
+{
+  std::string best;
+  std::string run;
+  int         depth = 0;
+
+  auto flush = [&]() {
+    if (run.size() > best.size()) {
+      best = run;
+    }
+    run.clear();
+  };
+  auto literal = [&](char c) {
+    if (depth > 0) {
+      return;
+    }
+    if (symbol(c) < 0) {
+      flush();
+    } else {
+      run += c;
+    }
+  };
+
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    char c = pattern[i];
+    switch (c) {
+    case '\\': {
+      if (++i >= pattern.size()) {
+        return {};
+      }
+      char e = pattern[i];
+      if (!isalnum(static_cast<unsigned char>(e))) {
+        literal(e);
+      } else if (strchr("QxocpPgkN", e) != nullptr || isdigit(static_cast<unsigned char>(e))) {
+        // quoting, escapes with arguments and back references
+        return {};
+      } else if (depth == 0) {
+        flush();
+      }
+      break;
+    }
+    case '[':
+      if (depth == 0) {
+        flush();
+      }
+      // skip the class, a ']' right after the opening bracket is a member
+      if (i + 1 < pattern.size() && pattern[i + 1] == '^') {
+        ++i;
+      }
+      if (i + 1 < pattern.size() && pattern[i + 1] == ']') {
+        ++i;
+      }
+      for (++i; i < pattern.size() && pattern[i] != ']'; ++i) {
+        if (pattern[i] == '\\') {
+          ++i;
+        }
+      }
+      if (i >= pattern.size()) {
+        return {};
+      }
+      break;
+    case '(':
+      if (i + 1 < pattern.size() && pattern[i + 1] == '?' && (i + 2 >= pattern.size() || pattern[i + 2] != ':')) {
+        // inline options and assertions
+        return {};
+      }
+      if (depth == 0) {
+        flush();
+      }
+      ++depth;
+      break;
+    case ')':
+      if (--depth < 0) {
+        return {};
+      }
+      break;
+    case '|':
+      if (depth == 0) {
+        return {};
+      }
+      break;
+    case '*':
+    case '?':
+    case '{':
+      // the quantified character is optional
+      if (depth == 0) {
+        if (!run.empty()) {
+          run.pop_back();
+        }
+        flush();
+      }
+      if (c == '{') {
+        i = std::min(pattern.find('}', i), pattern.size());
+      }
+      break;
+    case '+':
+      // the quantified character is required, but what follows need not be adjacent to it
+      if (depth == 0) {
+        flush();
+      }
+      break;
+    case '.':
+    case '^':
+    case '$':
+      if (depth == 0) {
+        flush();
+      }
+      break;
+    default:
+      literal(c);
+      break;
+    }
+  }
+  if (depth != 0) {
+    return {};
+  }
+  flush();
+
+  if (best.size() < MIN_LITERAL_LEN) {
+    best.clear();
+  }
+  return best;
+}
+
+void
+RegexPrefilter::build(std::vector<std::string> const &literals)
+{
+  _next.assign(1, State{});
+  _out.assign(1, {});
+  _always.clear();
+  _n_rules = literals.size();
+
+  // State 0 is the root, which is never a target of the trie, so 0 marks a missing transition.
+  for (uint32_t rule = 0; rule < literals.size(); ++rule) {
+    if (literals[rule].empty()) {
+      _always.push_back(rule);
+      continue;
+    }
+    int32_t state = 0;
+    for (char c : literals[rule]) {
+      int s = symbol(c);
+      ink_assert(s >= 0);
+      if (_next[state][s] == 0) {
+        _next[state][s] = static_cast<int32_t>(_next.size());
+        _next.emplace_back(State{});
+        _out.emplace_back();
+      }
+      state = _next[state][s];
+    }
+    _out[state].push_back(rule);
+  }
+
+  // Walk the trie breadth first so the failure state of every state is complete before the state
+  // itself, then fill in the missing transitions from it and take over its rules.
+  std::vector<int32_t> fail(_next.size(), 0);
+  std::deque<int32_t>  queue;
+  for (int s = 0; s < ALPHABET; ++s) {
+    if (_next[0][s] != 0) {
+      queue.push_back(_next[0][s]);
+    }
+  }
+  while (!queue.empty()) {
+    int32_t state = queue.front();
+    queue.pop_front();
+
+    auto const &suffix = _out[fail[state]];
+    _out[state].insert(_out[state].end(), suffix.begin(), suffix.end());
+
+    for (int s = 0; s < ALPHABET; ++s) {
+      int32_t child = _next[state][s];
+      if (child != 0) {
+        fail[child] = _next[fail[state]][s];
+        queue.push_back(child);
+      } else {
+        _next[state][s] = _next[fail[state]][s];
+      }
+    }
+  }
+}
+
+void
+RegexPrefilter::candidates(std::string_view host, std::vector<uint32_t> &candidates) const
+{
+  candidates.clear();
+  if (_next.empty()) {
+    return;
+  }
+
+  int32_t state = 0;
+  for (char c : host) {
+    int s = symbol(c);
+    state = s < 0 ? 0 : _next[state][s];
+    if (!_out[state].empty()) {
+      candidates.insert(candidates.end(), _out[state].begin(), _out[state].end());
+    }
+  }
+  candidates.insert(candidates.end(), _always.begin(), _always.end());
+
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+}
@@ -64,6 +64,15 @@ UrlMappingPathIndex::Insert(url_mapping *mapping)
   return true;
 }
 
+/** Compile the tries, after which no more mappings can be inserted. */
+void
+UrlMappingPathIndex::Freeze()
+{
+  for (auto &m_trie : m_tries) {
+    m_trie.second->Freeze();
+  }
+}
+
 url_mapping *
 UrlMappingPathIndex::Search(URL *request_url, int request_port, bool normal_search /* = true */) const
 {
@@ -104,8 +113,8 @@ UrlMappingPathIndex::PrintUrlMappingPathIndex() const
 {
   std::string result;
   for (auto &m_trie : m_tries) {
-    for (auto const &node : *m_trie.second) {
-      result += node.PrintRemapHitCount();
+    for (auto const *mapping : *m_trie.second) {
+      result += mapping->PrintRemapHitCount();
       result += ",\n";
     }
   }
@@ -29,6 +29,8 @@
 #include "tscore/Filenames.h"
 #include "proxy/http/HttpSM.h"
 
+#include <algorithm>
+
 #define modulePrefix "[ReverseProxy]"
 
 namespace
@@ -821,6 +823,12 @@ UrlRewrite::BuildTable(const char *path)
     return TS_ERROR;
   }
 
+  _compileStore(forward_mappings);
+  _compileStore(reverse_mappings);
+  _compileStore(permanent_redirects);
+  _compileStore(temporary_redirects);
+  _compileStore(forward_mappings_with_recv_port);
+
   // Destroy unused tables
   if (num_rules_forward == 0) {
     forward_mappings.hash_lookup.reset(nullptr);
@@ -920,7 +928,7 @@ UrlRewrite::_mappingLookup(MappingsStore &mappings, URL *request_url, int reques
     mapping_container.set(mapping);
     retval = true;
   }
-  if (_regexMappingLookup(mappings.regex_list, request_url, request_port, request_host_lower, request_host_len, rank_ceiling,
+  if (_regexMappingLookup(mappings, request_url, request_port, request_host_lower, request_host_len, rank_ceiling,
                           mapping_container)) {
     Dbg(dbg_ctl_url_rewrite, "Using regex mapping with rank %d", (mapping_container.getMapping())->getRank());
     retval = true;
@@ -980,12 +988,9 @@ lOverFlow:
 }
 
 bool
-UrlRewrite::_regexMappingLookup(RegexMappingList &regex_mappings, URL *request_url, int request_port, const char *request_host,
+UrlRewrite::_regexMappingLookup(MappingsStore &mappings, URL *request_url, int request_port, const char *request_host,
                                 int request_host_len, int rank_ceiling, UrlMappingContainer &mapping_container)
 {
-  bool         retval = false;
-  RegexMatches matches;
-
   if (rank_ceiling == -1) { // we will now look at all regex mappings
     rank_ceiling = INT_MAX;
     Dbg(dbg_ctl_url_rewrite_regex, "Going to match all regexes");
@@ -993,11 +998,11 @@ UrlRewrite::_regexMappingLookup(RegexMappingList &regex_mappings, URL *request_u
     Dbg(dbg_ctl_url_rewrite_regex, "Going to match regexes with rank <= %d", rank_ceiling);
   }
 
-  int         request_scheme_len, reg_map_scheme_len;
-  const char *request_scheme = request_url->scheme_get(&request_scheme_len), *reg_map_scheme;
+  int         request_scheme_len;
+  const char *request_scheme = request_url->scheme_get(&request_scheme_len);
 
-  int         request_path_len, reg_map_path_len;
-  const char *request_path = request_url->path_get(&request_path_len), *reg_map_path;
+  int         request_path_len;
+  const char *request_path = request_url->path_get(&request_path_len);
 
   // If the scheme is empty (e.g. because of a CONNECT method), guess it based on port
   // This is equivalent to the logic in UrlMappingPathIndex::_GetTrie().
@@ -1006,66 +1011,132 @@ UrlRewrite::_regexMappingLookup(RegexMappingList &regex_mappings, URL *request_u
     request_scheme_len = hdrtoken_wks_to_length(request_scheme);
   }
 
+  std::string_view scheme{request_scheme, static_cast<size_t>(request_scheme_len)};
+  std::string_view path{request_path, static_cast<size_t>(request_path_len)};
+
+  // Only the regexes of the rules the prefilter could not rule out are run, still in rank order.
+  if (mappings.regex_prefilter.size() == mappings.regex_rules.size() && !mappings.regex_rules.empty()) {
+    std::vector<uint32_t> candidates;
+    mappings.regex_prefilter.candidates(std::string_view(request_host, request_host_len), candidates);
+    Dbg(dbg_ctl_url_rewrite_regex, "%zu of %zu regexes are candidates", candidates.size(), mappings.regex_rules.size());
+    for (uint32_t idx : candidates) {
+      RegexMapping *reg_map = mappings.regex_rules[idx];
+      if (reg_map->url_map->getRank() > rank_ceiling) {
+        break;
+      }
+      if (_regexMappingMatch(reg_map, scheme, request_port, path, request_host, request_host_len, mapping_container)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   // Loop over the entire linked list, or until we're satisfied
-  forl_LL(RegexMapping, list_iter, regex_mappings)
+  forl_LL(RegexMapping, list_iter, mappings.regex_list)
   {
-    int reg_map_rank = list_iter->url_map->getRank();
-
-    if (reg_map_rank > rank_ceiling) {
+    if (list_iter->url_map->getRank() > rank_ceiling) {
       break;
     }
-
-    reg_map_scheme = list_iter->url_map->fromURL.scheme_get(&reg_map_scheme_len);
-    if ((request_scheme_len != reg_map_scheme_len) || strncmp(request_scheme, reg_map_scheme, request_scheme_len)) {
-      Dbg(dbg_ctl_url_rewrite_regex, "Skipping regex with rank %d as scheme does not match request scheme", reg_map_rank);
-      continue;
+    if (_regexMappingMatch(list_iter, scheme, request_port, path, request_host, request_host_len, mapping_container)) {
+      return true;
     }
+  }
 
-    if (list_iter->url_map->fromURL.port_get() != request_port) {
-      Dbg(dbg_ctl_url_rewrite_regex,
-          "Skipping regex with rank %d as regex map port does not match request port. "
-          "regex map port: %d, request port %d",
-          reg_map_rank, list_iter->url_map->fromURL.port_get(), request_port);
-      continue;
-    }
+  return false;
+}
 
-    reg_map_path = list_iter->url_map->fromURL.path_get(&reg_map_path_len);
-    if ((request_path_len < reg_map_path_len) ||
-        strncmp(reg_map_path, request_path, reg_map_path_len)) { // use the shorter path length here
-      Dbg(dbg_ctl_url_rewrite_regex, "Skipping regex with rank %d as path does not cover request path", reg_map_rank);
-      continue;
-    }
+bool
+UrlRewrite::_regexMappingMatch(RegexMapping *reg_map, std::string_view request_scheme, int request_port,
+                               std::string_view request_path, const char *request_host, int request_host_len,
+                               UrlMappingContainer &mapping_container)
+{
+  RegexMatches matches;
+  int          reg_map_rank = reg_map->url_map->getRank();
+
+  int         reg_map_scheme_len;
+  const char *reg_map_scheme = reg_map->url_map->fromURL.scheme_get(&reg_map_scheme_len);
+  if (request_scheme != std::string_view(reg_map_scheme, reg_map_scheme_len)) {
+    Dbg(dbg_ctl_url_rewrite_regex, "Skipping regex with rank %d as scheme does not match request scheme", reg_map_rank);
+    return false;
+  }
+
+  if (reg_map->url_map->fromURL.port_get() != request_port) {
+    Dbg(dbg_ctl_url_rewrite_regex,
+        "Skipping regex with rank %d as regex map port does not match request port. "
+        "regex map port: %d, request port %d",
+        reg_map_rank, reg_map->url_map->fromURL.port_get(), request_port);
+    return false;
+  }
 
-    int match_result = list_iter->regular_expression.exec(std::string_view(request_host, request_host_len), matches);
+  int         reg_map_path_len;
+  const char *reg_map_path = reg_map->url_map->fromURL.path_get(&reg_map_path_len);
+  if (!request_path.starts_with(std::string_view(reg_map_path, reg_map_path_len))) {
+    Dbg(dbg_ctl_url_rewrite_regex, "Skipping regex with rank %d as path does not cover request path", reg_map_rank);
+    return false;
+  }
 
-    if (match_result > 0) {
-      Dbg(dbg_ctl_url_rewrite_regex,
-          "Request URL host [%.*s] matched regex in mapping of rank %d "
-          "with %d possible substitutions",
-          request_host_len, request_host, reg_map_rank, match_result);
+  int match_result = reg_map->regular_expression.exec(std::string_view(request_host, request_host_len), matches);
 
-      mapping_container.set(list_iter->url_map);
+  if (match_result <= 0) {
+    Dbg(dbg_ctl_url_rewrite_regex, "Request URL host [%.*s] did NOT match regex in mapping of rank %d", request_host_len,
+        request_host, reg_map_rank);
+    return false;
+  }
 
-      char buf[4096];
-      int  buf_len;
+  Dbg(dbg_ctl_url_rewrite_regex,
+      "Request URL host [%.*s] matched regex in mapping of rank %d "
+      "with %d possible substitutions",
+      request_host_len, request_host, reg_map_rank, match_result);
 
-      // Expand substitutions in the host field from the stored template
-      size_t *matches_info = matches.get_ovector_pointer();
-      buf_len              = _expandSubstitutions(matches_info, list_iter, request_host, buf, sizeof(buf));
-      URL *expanded_url    = mapping_container.createNewToURL();
-      expanded_url->copy(&((list_iter->url_map)->toURL));
-      expanded_url->host_set(buf, buf_len);
+  mapping_container.set(reg_map->url_map);
 
-      Dbg(dbg_ctl_url_rewrite_regex, "Expanded toURL to [%.*s]", expanded_url->length_get(), expanded_url->string_get_ref());
-      retval = true;
-      break;
-    } else {
-      Dbg(dbg_ctl_url_rewrite_regex, "Request URL host [%.*s] did NOT match regex in mapping of rank %d", request_host_len,
-          request_host, reg_map_rank);
-    }
+  char buf[4096];
+  int  buf_len;
+
+  // Expand substitutions in the host field from the stored template
+  size_t *matches_info = matches.get_ovector_pointer();
+  buf_len              = _expandSubstitutions(matches_info, reg_map, request_host, buf, sizeof(buf));
+  URL *expanded_url    = mapping_container.createNewToURL();
+  expanded_url->copy(&((reg_map->url_map)->toURL));
+  expanded_url->host_set(buf, buf_len);
+
+  Dbg(dbg_ctl_url_rewrite_regex, "Expanded toURL to [%.*s]", expanded_url->length_get(), expanded_url->string_get_ref());
+  return true;
+}
+
+/** Index the regex mappings of @a store for _regexMappingLookup. */
+void
+UrlRewrite::_buildRegexPrefilter(MappingsStore &store)
+{
+  std::vector<std::string> literals;
+
+  store.regex_rules.clear();
+  forl_LL(RegexMapping, list_iter, store.regex_list)
+  {
+    // the regex is kept as the (lower cased) host of fromURL
+    int         pattern_len;
+    const char *pattern = list_iter->url_map->fromURL.host_get(&pattern_len);
+    store.regex_rules.push_back(list_iter);
+    literals.push_back(RegexPrefilter::required_literal(std::string_view(pattern, pattern_len)));
   }
+  store.regex_prefilter.build(literals);
 
-  return retval;
+  if (!store.regex_rules.empty()) {
+    Dbg(dbg_ctl_url_rewrite_regex, "%zu of %zu regexes have a literal to prefilter on",
+        store.regex_rules.size() - std::count(literals.begin(), literals.end(), std::string{}), store.regex_rules.size());
+  }
+}
+
+/** Compile the lookup structures of @a store once all of its mappings are inserted. */
+void
+UrlRewrite::_compileStore(MappingsStore &store)
+{
+  if (store.hash_lookup) {
+    for (auto &it : *store.hash_lookup) {
+      it.second->Freeze();
+    }
+  }
+  _buildRegexPrefilter(store);
 }
 
 void
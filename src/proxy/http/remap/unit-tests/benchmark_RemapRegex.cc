@@ -0,0 +1,123 @@
+/** @file
+
+  Benchmark regex remap rule lookups with a large number of rules.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include "proxy/hdrs/HdrHeap.h"
+#include "proxy/http/remap/UrlMapping.h"
+#include "proxy/http/remap/UrlRewrite.h"
+#include "records/RecordsConfig.h"
+#include "swoc/swoc_file.h"
+#include "tscore/BaseLogFile.h"
+#include "tsutil/Regex.h"
+
+#include <fstream>
+#include <memory>
+
+namespace
+{
+constexpr int N_RULES = 2000;
+
+struct BenchmarkListener : Catch::TestEventListenerBase {
+  using TestEventListenerBase::TestEventListenerBase;
+
+  void
+  testRunStarting(Catch::TestRunInfo const & /* testRunInfo ATS_UNUSED */) override
+  {
+    Thread *main_thread = new EThread();
+    main_thread->set_specific();
+
+    DiagsPtr::set(new Diags("benchmark_RemapRegex", "", "", new BaseLogFile("stderr")));
+    url_init();
+    mime_init();
+    http_init();
+    Layout::create();
+    RecProcessInit(diags());
+    LibRecordsConfigInit();
+  }
+};
+
+CATCH_REGISTER_LISTENER(BenchmarkListener);
+
+std::string
+rule_pattern(int i)
+{
+  return R"(^(.*)\.tenant)" + std::to_string(i) + R"(\.example\.com$)";
+}
+
+} // end anonymous namespace
+
+TEST_CASE("regex remap lookup", "[proxy][remap][bench]")
+{
+  std::string config;
+  for (int i = 0; i < N_RULES; ++i) {
+    config += "regex_map http://" + rule_pattern(i) + "/ http://$1.origin" + std::to_string(i) + ".com/\n";
+  }
+  auto path = swoc::file::temp_directory_path() / swoc::file::path("benchmark_RemapRegex.config");
+  {
+    std::ofstream f(path.c_str(), std::ios::trunc);
+    f << config;
+  }
+
+  auto urlrw = std::make_unique<UrlRewrite>();
+  REQUIRE(urlrw->BuildTable(path.c_str()) == TS_SUCCESS);
+  REQUIRE(urlrw->rule_count() == N_RULES);
+
+  // The same rules run one after the other, as the lookup did before the prefilter.
+  std::vector<std::unique_ptr<Regex>> linear;
+  for (int i = 0; i < N_RULES; ++i) {
+    linear.emplace_back(std::make_unique<Regex>());
+    REQUIRE(linear.back()->compile(rule_pattern(i)));
+  }
+
+  for (int target : {0, N_RULES / 2, N_RULES - 1}) {
+    std::string host    = "www.tenant" + std::to_string(target) + ".example.com";
+    std::string request = "http://" + host + "/";
+
+    HdrHeap *heap = new_HdrHeap();
+    URL      url;
+    url.create(heap);
+    url.parse(request);
+
+    BENCHMARK("prefiltered lookup, rule " + std::to_string(target))
+    {
+      UrlMappingContainer urlmap;
+      return urlrw->forwardMappingLookup(&url, 80, host.c_str(), host.size(), urlmap);
+    };
+
+    BENCHMARK("linear regex scan, rule " + std::to_string(target))
+    {
+      RegexMatches matches;
+      for (auto const &re : linear) {
+        if (re->exec(host, matches) > 0) {
+          return true;
+        }
+      }
+      return false;
+    };
+
+    heap->destroy();
+  }
+}
@@ -670,3 +670,88 @@ SCENARIO("Testing NextHopConsistentHash using a peering ring_mode.")
     }
   }
 }
+
+SCENARIO("Testing NextHopConsistentHash class, using hash_algorithm 'maglev'", "[NextHopConsistentHash]")
+{
+  // We need this to build a HdrHeap object in build_request();
+  // No thread setup, forbid use of thread local allocators.
+  cmd_disable_pfreelist = true;
+  // Get all of the HTTP WKS items populated.
+  http_init();
+
+  GIVEN("Loading the consistent-hash-tests.yaml config for 'maglev' tests.")
+  {
+    std::shared_ptr<NextHopSelectionStrategy> strategy;
+    NextHopStrategyFactory                    nhf(TS_SRC_DIR "/consistent-hash-tests.yaml");
+    strategy = nhf.strategyInstance("consistent-hash-maglev");
+
+    WHEN("requests are received.")
+    {
+      THEN("the same parent is selected for a path until it fails, then the others are tried in turn.")
+      {
+        HttpSM        sm;
+        ParentResult *result = &sm.t_state.parent_result;
+        TSHttpTxn     txnp   = reinterpret_cast<TSHttpTxn>(&sm);
+
+        REQUIRE(nhf.strategies_loaded == true);
+        REQUIRE(strategy != nullptr);
+        REQUIRE(std::static_pointer_cast<NextHopConsistentHash>(strategy)->hash_algorithm == NHHashAlgorithmType::MAGLEV);
+
+        auto in_group = [&](uint32_t group, const char *hostname) {
+          for (auto const &h : strategy->host_groups[group]) {
+            if (h->hostname == hostname) {
+              return true;
+            }
+          }
+          return false;
+        };
+
+        build_request(40001, &sm, nullptr, "rabbit.net", nullptr);
+        result->reset();
+        strategy->findNextHop(txnp);
+        REQUIRE(result->result == ParentResultType::SPECIFIED);
+        std::string first = result->hostname;
+        CHECK(in_group(0, first.c_str()));
+
+        // a new transaction for the same path gets the same parent.
+        build_request(40002, &sm, nullptr, "rabbit.net", nullptr);
+        result->reset();
+        strategy->findNextHop(txnp);
+        REQUIRE(result->result == ParentResultType::SPECIFIED);
+        CHECK(first == result->hostname);
+
+        // the primary group is exhausted before the secondary is used.
+        strategy->markNextHop(txnp, result->hostname, result->port, NHCmd::MARK_DOWN);
+        build_request(40003, &sm, nullptr, "rabbit.net", nullptr);
+        strategy->findNextHop(txnp);
+        REQUIRE(result->result == ParentResultType::SPECIFIED);
+        std::string second = result->hostname;
+        CHECK(second != first);
+        CHECK(in_group(0, second.c_str()));
+
+        strategy->markNextHop(txnp, result->hostname, result->port, NHCmd::MARK_DOWN);
+        build_request(40004, &sm, nullptr, "rabbit.net", nullptr);
+        strategy->findNextHop(txnp);
+        REQUIRE(result->result == ParentResultType::SPECIFIED);
+        std::string third = result->hostname;
+        CHECK(in_group(1, third.c_str()));
+
+        strategy->markNextHop(txnp, result->hostname, result->port, NHCmd::MARK_DOWN);
+        build_request(40005, &sm, nullptr, "rabbit.net", nullptr);
+        strategy->findNextHop(txnp);
+        REQUIRE(result->result == ParentResultType::SPECIFIED);
+        CHECK(third != result->hostname);
+        CHECK(in_group(1, result->hostname));
+
+        // with every parent down and go_direct disabled the lookup fails.
+        strategy->markNextHop(txnp, result->hostname, result->port, NHCmd::MARK_DOWN);
+        build_request(40006, &sm, nullptr, "rabbit.net", nullptr);
+        strategy->findNextHop(txnp, nullptr, time(nullptr) - 1);
+        CHECK(result->result == ParentResultType::FAIL);
+
+        // free up request resources.
+        br_destroy(sm);
+      }
+    }
+  }
+}
@@ -0,0 +1,76 @@
+/** @file
+
+  Unit tests for the regex remap rule prefilter.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "proxy/http/remap/RegexPrefilter.h"
+
+#define CATCH_CONFIG_MAIN /* include main function */
+#include <catch.hpp>      /* catch unit-test framework */
+
+TEST_CASE("RegexPrefilter required literal", "[proxy][remap]")
+{
+  // The longest run outside of groups, classes and quantifiers.
+  CHECK(RegexPrefilter::required_literal(R"(^(.*)\.example\.com$)") == ".example.com");
+  CHECK(RegexPrefilter::required_literal(R"(^www[0-9]+\.foo-bar\.net$)") == ".foo-bar.net");
+  CHECK(RegexPrefilter::required_literal(R"(^img\d{2,3}\.static\.org$)") == ".static.org");
+  CHECK(RegexPrefilter::required_literal(R"(^(?:www\.)?shop\.io$)") == "shop.io");
+  CHECK(RegexPrefilter::required_literal(R"(^(a|b)\.cdn\.net$)") == ".cdn.net");
+  // a quantified character is not required
+  CHECK(RegexPrefilter::required_literal("abcd?efgh") == "efgh");
+  CHECK(RegexPrefilter::required_literal("abcd*ef") == "abc");
+  CHECK(RegexPrefilter::required_literal("abc+defg") == "defg");
+
+  // Nothing that every match must contain.
+  CHECK(RegexPrefilter::required_literal("foo.com|bar.com") == "");
+  CHECK(RegexPrefilter::required_literal(R"((?i)example\.com)") == "");
+  CHECK(RegexPrefilter::required_literal(R"(\Qexample.com\E)") == "");
+  CHECK(RegexPrefilter::required_literal(R"(ex\x61mple)") == "");
+  CHECK(RegexPrefilter::required_literal("^.*$") == "");
+  CHECK(RegexPrefilter::required_literal("ab.cd") == "");
+  CHECK(RegexPrefilter::required_literal("(unbalanced") == "");
+}
+
+TEST_CASE("RegexPrefilter candidates", "[proxy][remap]")
+{
+  RegexPrefilter           prefilter;
+  std::vector<uint32_t>    candidates;
+  std::vector<std::string> literals = {".example.com", "", "shop.io", "ample.c", "www.example.com"};
+
+  prefilter.build(literals);
+  REQUIRE(prefilter.size() == literals.size());
+
+  prefilter.candidates("www.example.com", candidates);
+  CHECK(candidates == std::vector<uint32_t>{0, 1, 3, 4});
+
+  prefilter.candidates("cdn.example.com", candidates);
+  CHECK(candidates == std::vector<uint32_t>{0, 1, 3});
+
+  prefilter.candidates("shop.io", candidates);
+  CHECK(candidates == std::vector<uint32_t>{1, 2});
+
+  // characters outside of the host name alphabet restart the scan
+  prefilter.candidates("shop:.io", candidates);
+  CHECK(candidates == std::vector<uint32_t>{1});
+
+  prefilter.candidates("", candidates);
+  CHECK(candidates == std::vector<uint32_t>{1});
+}
@@ -166,3 +166,45 @@ map https://h1.example.com \
     }
   }
 }
+
+SCENARIO("Regex remap rules", "[proxy][remap]")
+{
+  GIVEN("Regex rules with and without a required host literal")
+  {
+    std::unique_ptr<UrlRewrite> urlrw = std::make_unique<UrlRewrite>();
+
+    std::string config = R"RMCFG(
+regex_map http://^(.*)\.shop\.example\.com$/ http://$1.shop.origin.com/
+regex_map http://^(www|img)\.example\.com$/ http://$1.origin.com/
+regex_map http://^[a-z]+\.example\.(com|net)$/ http://catchall.origin.com/
+regex_map http://^(?i)foo\.bar$/ http://foo.origin.com/
+  )RMCFG";
+
+    auto cpath = write_test_remap(config, "test_regex");
+    int  rc    = urlrw->BuildTable(cpath.c_str());
+
+    auto lookup = [&](const char *request, const char *host) -> std::string {
+      EasyURL             url(request);
+      UrlMappingContainer urlmap;
+      if (!urlrw->forwardMappingLookup(&url.url, 80, host, strlen(host), urlmap)) {
+        return {};
+      }
+      int         len  = 0;
+      const char *to   = urlmap.getToURL()->host_get(&len);
+      std::string rank = std::to_string(urlmap.getMapping()->getRank());
+      return rank + ":" + std::string(to, len);
+    };
+
+    THEN("the lowest ranked matching rule is used")
+    {
+      REQUIRE(rc == TS_SUCCESS);
+      REQUIRE(urlrw->rule_count() == 4);
+
+      CHECK(lookup("http://a.shop.example.com/", "a.shop.example.com") == "0:a.shop.origin.com");
+      CHECK(lookup("http://img.example.com/", "img.example.com") == "1:img.origin.com");
+      CHECK(lookup("http://cdn.example.net/", "cdn.example.net") == "2:catchall.origin.com");
+      CHECK(lookup("http://foo.bar/", "foo.bar") == "3:foo.origin.com");
+      CHECK(lookup("http://a.b.example.org/", "a.b.example.org") == "");
+    }
+  }
+}
@@ -0,0 +1,124 @@
+/** @file
+
+  Benchmark dechunking chunked transfer coded content
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "proxy/http/HttpTunnel.h"
+#include "records/RecordsConfig.h"
+#include "tscore/Layout.h"
+
+#include "iocore/eventsystem/EventSystem.h"
+#include "iocore/utils/diags.i"
+
+#include <random>
+#include <string>
+
+namespace
+{
+constexpr size_t BODY_SIZE = 1 << 20;
+
+struct BenchmarkListener : Catch::TestEventListenerBase {
+  using TestEventListenerBase::TestEventListenerBase;
+
+  void
+  testRunStarting(Catch::TestRunInfo const & /* testRunInfo ATS_UNUSED */) override
+  {
+    Layout::create();
+    init_diags("", nullptr);
+    RecProcessInit();
+    LibRecordsConfigInit();
+
+    ink_event_system_init(EVENT_SYSTEM_MODULE_PUBLIC_VERSION);
+    eventProcessor.start(1);
+
+    EThread *main_thread = new EThread;
+    main_thread->set_specific();
+  }
+};
+
+CATCH_REGISTER_LISTENER(BenchmarkListener);
+
+// About BODY_SIZE bytes of chunks with sizes in [min_size, max_size].
+std::string
+make_chunked(size_t min_size, size_t max_size)
+{
+  std::mt19937                          rng(1);
+  std::uniform_int_distribution<size_t> chunk_size(min_size, max_size);
+  std::string                           input;
+  char                                  line[32];
+
+  for (size_t body = 0; body < BODY_SIZE;) {
+    size_t size = chunk_size(rng);
+    input.append(line, snprintf(line, sizeof(line), "%zx\r\n", size)).append(size, 'x').append("\r\n");
+    body += size;
+  }
+  return input.append("0\r\n\r\n");
+}
+
+// Dechunk @a input as it would arrive from an origin, in 32K reads.
+int64_t
+dechunk(std::string const &input)
+{
+  MIOBuffer      *buffer = new_MIOBuffer(BUFFER_SIZE_INDEX_32K);
+  IOBufferReader *reader = buffer->alloc_reader();
+  ChunkedHandler  handler;
+
+  handler.init_by_action(reader, ChunkedHandler::Action::DECHUNK, false, true);
+  handler.state        = ChunkedHandler::ChunkedState::READ_SIZE;
+  IOBufferReader *body = handler.dechunked_buffer->alloc_reader();
+
+  for (size_t offset = 0; offset < input.size(); offset += 32 * 1024) {
+    buffer->write(input.data() + offset, std::min<size_t>(32 * 1024, input.size() - offset));
+    handler.process_chunked_content();
+    body->consume(body->read_avail());
+  }
+  int64_t size = handler.dechunked_size;
+
+  handler.clear();
+  free_MIOBuffer(buffer);
+  return size;
+}
+
+} // end anonymous namespace
+
+TEST_CASE("ChunkedHandler dechunk", "[bench][http][chunked]")
+{
+  std::string const tiny  = make_chunked(1, 16);
+  std::string const small = make_chunked(1, 100);
+  std::string const large = make_chunked(4096, 16384);
+
+  BENCHMARK("1M of 1 to 16 byte chunks")
+  {
+    return dechunk(tiny);
+  };
+  BENCHMARK("1M of 1 to 100 byte chunks")
+  {
+    return dechunk(small);
+  };
+  BENCHMARK("1M of 4K to 16K byte chunks")
+  {
+    return dechunk(large);
+  };
+}
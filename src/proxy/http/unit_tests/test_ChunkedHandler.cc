@@ -0,0 +1,139 @@
+/** @file
+
+  Unit tests for dechunking chunked transfer coded content
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "proxy/http/HttpTunnel.h"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+namespace
+{
+struct Dechunked {
+  std::string                  body;
+  bool                         done;
+  ChunkedHandler::ChunkedState state;
+};
+
+// Write @a input into a buffer of small blocks @a step bytes at a time, processing the content after each write.
+Dechunked
+dechunk(std::string_view input, size_t step, bool strict = true)
+{
+  MIOBuffer      *buffer = new_MIOBuffer(BUFFER_SIZE_INDEX_128);
+  IOBufferReader *reader = buffer->alloc_reader();
+  ChunkedHandler  handler;
+
+  handler.init_by_action(reader, ChunkedHandler::Action::DECHUNK, false, strict);
+  handler.state        = ChunkedHandler::ChunkedState::READ_SIZE;
+  IOBufferReader *body = handler.dechunked_buffer->alloc_reader();
+
+  Dechunked result{"", false, handler.state};
+  for (size_t offset = 0; offset < input.size() && !result.done; offset += step) {
+    buffer->write(input.data() + offset, std::min(step, input.size() - offset));
+    result.done = handler.process_chunked_content().second;
+  }
+  result.state = handler.state;
+  while (body->read_avail() > 0) {
+    result.body.append(body->start(), body->block_read_avail());
+    body->consume(body->block_read_avail());
+  }
+
+  handler.clear();
+  free_MIOBuffer(buffer);
+  return result;
+}
+
+std::string
+chunk(std::string_view data, std::string_view extension = "")
+{
+  char size[32];
+  snprintf(size, sizeof(size), "%zx", data.size());
+  return std::string(size).append(extension).append("\r\n").append(data).append("\r\n");
+}
+
+} // end anonymous namespace
+
+TEST_CASE("ChunkedHandler dechunking", "[http][chunked]")
+{
+  std::string input;
+  std::string expected;
+  for (size_t len = 1; len <= 300; len += 7) {
+    std::string data(len, 'a' + len % 26);
+    input    += chunk(data, len % 3 == 0 ? ";name=value" : "");
+    expected += data;
+  }
+  input += "0\r\nTrailer: x\r\n\r\n";
+
+  // Every split of the size lines and bodies across blocks and writes.
+  for (size_t step : {1, 2, 5, 64, 127, 1000, 100000}) {
+    CAPTURE(step);
+    auto result = dechunk(input, step);
+    CHECK(result.done);
+    CHECK(result.state == ChunkedHandler::ChunkedState::READ_DONE);
+    CHECK(result.body == expected);
+  }
+}
+
+TEST_CASE("ChunkedHandler chunk size lines", "[http][chunked]")
+{
+  SECTION("upper case and leading zeros")
+  {
+    auto result = dechunk("000A\r\n0123456789\r\n0\r\n\r\n", 100);
+    CHECK(result.state == ChunkedHandler::ChunkedState::READ_DONE);
+    CHECK(result.body == "0123456789");
+  }
+  SECTION("white space before the extension")
+  {
+    auto result = dechunk("3 ;x\r\nabc\r\n0\r\n\r\n", 100);
+    CHECK(result.state == ChunkedHandler::ChunkedState::READ_DONE);
+    CHECK(result.body == "abc");
+  }
+  SECTION("bare LF")
+  {
+    CHECK(dechunk("3;x\nabc\r\n0\r\n\r\n", 100).state == ChunkedHandler::ChunkedState::READ_ERROR);
+
+    auto result = dechunk("3\r\nabc\n0\r\n\r\n", 100, false);
+    CHECK(result.state == ChunkedHandler::ChunkedState::READ_DONE);
+    CHECK(result.body == "abc");
+  }
+  SECTION("malformed")
+  {
+    std::string_view const malformed[] = {
+      "3\r\r\nabc\r\n0\r\n\r\n",   // two CRs
+      "3;a\rb\r\nabc\r\n0\r\n\r\n", // a CR in the extension
+      "\r\nabc\r\n0\r\n\r\n",     // no size
+      "3x\r\nabc\r\n0\r\n\r\n",   // not a hex digit
+      "3\r\nabcX\r\n0\r\n\r\n",   // a chunk longer than its size
+      "3\r\nabc\r\r\n0\r\n\r\n", // two CRs after the chunk
+      "100000000\r\n",           // too large
+    };
+    for (std::string_view input : malformed) {
+      CAPTURE(input);
+      for (size_t step : {1, 100}) {
+        CHECK(dechunk(input, step).state == ChunkedHandler::ChunkedState::READ_ERROR);
+      }
+    }
+  }
+}
@@ -383,6 +383,20 @@ http2_parse_window_update(IOVec iov, uint32_t &size)
   return true;
 }
 
+bool
+http2_parse_priority_update(IOVec iov, Http2StreamId &prioritized_id)
+{
+  byte_pointer                     ptr(iov.iov_base);
+  byte_addressable_value<uint32_t> sid;
+
+  memcpy_and_advance(sid.bytes, ptr);
+
+  sid.bytes[0]   &= 0x7f; // Clear the reserved bit
+  prioritized_id  = ntohl(sid.value);
+
+  return true;
+}
+
 ParseResult
 http2_convert_header_from_2_to_1_1(HTTPHdr *headers)
 {
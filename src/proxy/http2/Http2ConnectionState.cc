@@ -91,6 +91,18 @@ read_rcv_buffer(char *buf, size_t bufsize, unsigned &nbytes, const Http2Frame &f
   return end - buf;
 }
 
+bool
+is_node_of(const Http2Stream *stream, const Http2DependencyTree::Node *node)
+{
+  return stream->priority_node == node;
+}
+
+bool
+is_node_of(const Http2Stream *stream, const ExtensiblePriority::Node *node)
+{
+  return stream->urgency_node == node;
+}
+
 } // end anonymous namespace
 
 Http2Error
@@ -417,7 +429,13 @@ Http2ConnectionState::rcv_headers_frame(const Http2Frame &frame)
     header_block_fragment_length -= HTTP2_PRIORITY_LEN;
   }
 
-  if (new_stream && Http2::stream_priority_enabled) {
+  if (new_stream && this->priority_scheduler != nullptr) {
+    // Until the Priority header field is decoded, unless a PRIORITY_UPDATE frame came before the stream opened
+    ExtensiblePriority::Priority priority;
+    bool                         updated = this->_pending_priority_updates.take(stream_id, priority);
+    stream->urgency_node                 = this->priority_scheduler->add(stream_id, priority, stream);
+    stream->urgency_node->updated        = updated;
+  } else if (new_stream && this->dependency_tree != nullptr) {
     Http2DependencyTree::Node *node = this->dependency_tree->find(stream_id);
     if (node != nullptr) {
       stream->priority_node = node;
@@ -577,7 +595,8 @@ Http2ConnectionState::rcv_priority_frame(const Http2Frame &frame)
                       "PRIORITY frame depends on itself");
   }
 
-  if (!Http2::stream_priority_enabled) {
+  // [RFC 9218] 2.1. The RFC 7540 signals are ignored when the extensible priorities are used
+  if (this->dependency_tree == nullptr) {
     return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
   }
 
@@ -995,6 +1014,77 @@ Http2ConnectionState::rcv_window_update_frame(const Http2Frame &frame)
   return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
 }
 
+/*
+ * [RFC 9218] 7.1 PRIORITY_UPDATE
+ *
+ * NOTE: An update for a client stream that is still idle is kept until the HEADERS frame opens the stream, up to
+ * as many streams as may be open at once. It takes precedence over the Priority header field of the request.
+ * Updates for closed streams are ignored. The frame is only handled on inbound connections using the RFC 9218
+ * priorities, rcv_frame() discards it as an unsupported type otherwise.
+ *
+ */
+Http2Error
+Http2ConnectionState::rcv_priority_update_frame(const Http2Frame &frame)
+{
+  const Http2StreamId stream_id      = frame.header().streamid;
+  const uint32_t      payload_length = frame.header().length;
+
+  Http2StreamDebug(this->session, stream_id, "Received PRIORITY_UPDATE frame");
+
+  // PRIORITY_UPDATE frames are sent on the control stream, anything else is a connection error of type
+  // PROTOCOL_ERROR.
+  if (stream_id != HTTP2_CONNECTION_CONTROL_STREAM) {
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_CONNECTION, Http2ErrorCode::HTTP2_ERROR_PROTOCOL_ERROR,
+                      "priority update bad stream_id");
+  }
+
+  if (payload_length < HTTP2_PRIORITY_UPDATE_LEN) {
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_CONNECTION, Http2ErrorCode::HTTP2_ERROR_FRAME_SIZE_ERROR,
+                      "priority update bad length");
+  }
+
+  uint8_t buf[HTTP2_PRIORITY_UPDATE_LEN] = {0};
+  frame.reader()->memcpy(buf, HTTP2_PRIORITY_UPDATE_LEN, 0);
+
+  Http2StreamId prioritized_id = 0;
+  http2_parse_priority_update(make_iovec(buf, HTTP2_PRIORITY_UPDATE_LEN), prioritized_id);
+
+  if (prioritized_id == HTTP2_CONNECTION_CONTROL_STREAM) {
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_CONNECTION, Http2ErrorCode::HTTP2_ERROR_PROTOCOL_ERROR,
+                      "priority update 0 prioritized stream_id");
+  }
+
+  if (!http2_is_client_streamid(prioritized_id)) {
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
+  }
+
+  std::string value(payload_length - HTTP2_PRIORITY_UPDATE_LEN, '\0');
+  frame.reader()->memcpy(value.data(), value.size(), HTTP2_PRIORITY_UPDATE_LEN);
+
+  // The update replaces the whole priority, parameters it leaves out take their defaults. A field value which
+  // does not parse is ignored and the stream keeps its priority.
+  ExtensiblePriority::Priority priority;
+  if (!ExtensiblePriority::parse(value, priority)) {
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
+  }
+
+  Http2Stream *stream = this->find_stream(prioritized_id);
+  if (stream != nullptr && stream->urgency_node != nullptr) {
+    Http2StreamDebug(this->session, prioritized_id, "PRIORITY_UPDATE urgency=%u incremental=%d", priority.urgency,
+                     priority.incremental);
+    this->priority_scheduler->reprioritize(stream->urgency_node, priority);
+    stream->urgency_node->updated = true;
+  } else if (prioritized_id > this->latest_streamid_in) {
+    if (!this->_pending_priority_updates.add(prioritized_id, priority, this->_get_configured_max_concurrent_streams())) {
+      Http2StreamDebug(this->session, prioritized_id, "PRIORITY_UPDATE dropped, too many idle streams prioritized");
+    }
+  } else {
+    Http2StreamDebug(this->session, prioritized_id, "PRIORITY_UPDATE for a closed stream");
+  }
+
+  return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
+}
+
 /*
  * [RFC 7540] 6.10 CONTINUATION
  *
@@ -1288,8 +1378,10 @@ Http2ConnectionState::init(Http2CommonSession *ssn)
 
   local_hpack_handle = new HpackHandle(HTTP2_HEADER_TABLE_SIZE);
   peer_hpack_handle  = new HpackHandle(HTTP2_HEADER_TABLE_SIZE);
-  if (Http2::stream_priority_enabled) {
+  if (Http2::stream_priority_enabled == HTTP2_PRIORITY_SCHEME_RFC7540) {
     dependency_tree = new DependencyTree(this->_get_configured_max_concurrent_streams());
+  } else if (Http2::stream_priority_enabled == HTTP2_PRIORITY_SCHEME_RFC9218) {
+    priority_scheduler = new ExtensiblePriority::Scheduler;
   }
 
   // Generally speaking, before enforcing h2 settings we wait upon the client to
@@ -1405,7 +1497,11 @@ Http2ConnectionState::destroy()
   peer_hpack_handle = nullptr;
   delete dependency_tree;
   dependency_tree = nullptr;
-  this->session   = nullptr;
+  delete priority_scheduler;
+  priority_scheduler = nullptr;
+  _pending_priority_updates.clear();
+  stream_table.clear();
+  this->session = nullptr;
 
   if (fini_event) {
     fini_event->cancel();
@@ -1436,9 +1532,13 @@ Http2ConnectionState::rcv_frame(const Http2Frame *frame)
   const Http2StreamId stream_id = frame->header().streamid;
   Http2Error          error;
 
+  // PRIORITY_UPDATE is only supported when the RFC 9218 priorities are in use, and only clients send it.
+  const bool priority_update = frame->header().type == HTTP2_FRAME_TYPE_PRIORITY_UPDATE && this->priority_scheduler != nullptr &&
+                               !this->session->is_outbound();
+
   // [RFC 7540] 5.5. Extending HTTP/2
   //   Implementations MUST discard frames that have unknown or unsupported types.
-  if (frame->header().type >= HTTP2_FRAME_TYPE_MAX) {
+  if (frame->header().type >= HTTP2_FRAME_TYPE_MAX && !priority_update) {
     Http2StreamDebug(session, stream_id, "Discard a frame which has unknown type, type=%x", frame->header().type);
     return;
   }
@@ -1461,7 +1561,9 @@ Http2ConnectionState::rcv_frame(const Http2Frame *frame)
     return;
   }
 
-  if (this->_frame_handlers[frame->header().type]) {
+  if (priority_update) {
+    error = this->rcv_priority_update_frame(*frame);
+  } else if (this->_frame_handlers[frame->header().type]) {
     error = (this->*_frame_handlers[frame->header().type])(*frame);
   } else {
     error = Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_CONNECTION, Http2ErrorCode::HTTP2_ERROR_INTERNAL_ERROR, "no handler");
@@ -1660,6 +1762,7 @@ Http2ConnectionState::set_stream_id(Http2Stream *stream)
   if (stream->get_transaction_id() < 0) {
     Http2StreamId stream_id = (latest_streamid_in == 0) ? 3 : latest_streamid_in + 2;
     stream->set_transaction_id(stream_id);
+    stream_table.insert(stream_id, stream);
     latest_streamid_in = stream_id;
   }
 }
@@ -1848,6 +1951,7 @@ Http2ConnectionState::create_stream(Http2StreamId new_id, Http2Error &error)
   new_stream->is_first_transaction_flag = get_stream_requests() == 0;
 
   stream_list.enqueue(new_stream);
+  stream_table.insert(new_id, new_stream);
   if (is_client_streamid) {
     latest_streamid_in = new_id;
     ink_assert(peer_streams_count_in < UINT32_MAX);
@@ -1885,13 +1989,7 @@ Http2ConnectionState::create_stream(Http2StreamId new_id, Http2Error &error)
 Http2Stream *
 Http2ConnectionState::find_stream(Http2StreamId id) const
 {
-  for (Http2Stream *s = stream_list.head; s; s = static_cast<Http2Stream *>(s->link.next)) {
-    if (s->get_id() == id) {
-      return s;
-    }
-    ink_assert(s != s->link.next);
-  }
-  return nullptr;
+  return stream_table.find(id);
 }
 
 void
@@ -2024,7 +2122,7 @@ Http2ConnectionState::delete_stream(Http2Stream *stream)
   Http2StreamDebug(session, stream->get_id(), "Delete stream");
   REMEMBER(NO_EVENT, this->recursion);
 
-  if (Http2::stream_priority_enabled) {
+  if (this->dependency_tree != nullptr) {
     Http2DependencyTree::Node *node       = stream->priority_node;
     Http2DependencyTree::Node *node_by_id = this->dependency_tree->find(stream->get_id());
     ink_assert(node == node_by_id);
@@ -2041,6 +2139,9 @@ Http2ConnectionState::delete_stream(Http2Stream *stream)
       // ink_release_assert(dependency_tree->find(stream->get_id()) == nullptr);
     }
     stream->priority_node = nullptr;
+  } else if (stream->urgency_node != nullptr) {
+    priority_scheduler->remove(stream->urgency_node);
+    stream->urgency_node = nullptr;
   }
 
   if (stream->get_state() != Http2StreamState::HTTP2_STREAM_STATE_CLOSED) {
@@ -2048,6 +2149,7 @@ Http2ConnectionState::delete_stream(Http2Stream *stream)
   }
 
   stream_list.remove(stream);
+  stream_table.erase(stream->get_id());
   if (http2_is_client_streamid(stream->get_id())) {
     ink_release_assert(peer_streams_count_in > 0);
     --peer_streams_count_in;
@@ -2153,11 +2255,14 @@ Http2ConnectionState::schedule_stream_to_send_priority_frames(Http2Stream *strea
 {
   Http2StreamDebug(session, stream->get_id(), "Scheduling sending priority frames");
 
-  Http2DependencyTree::Node *node = stream->priority_node;
-  ink_release_assert(node != nullptr);
+  ink_release_assert(stream->priority_node != nullptr || stream->urgency_node != nullptr);
 
   SCOPED_MUTEX_LOCK(lock, this->mutex, this_ethread());
-  dependency_tree->activate(node);
+  if (stream->urgency_node != nullptr) {
+    priority_scheduler->activate(stream->urgency_node);
+  } else {
+    dependency_tree->activate(stream->priority_node);
+  }
 
   if (_priority_event == nullptr) {
     SET_HANDLER(&Http2ConnectionState::main_event_handler);
@@ -2210,50 +2315,64 @@ Http2ConnectionState::cancel_retransmit()
 void
 Http2ConnectionState::send_data_frames_depends_on_priority()
 {
-  Http2DependencyTree::Node *node = dependency_tree->top();
-
-  // No node to send or no connection level window left
-  if (node == nullptr || _peer_rwnd <= 0) {
-    return;
+  if (priority_scheduler != nullptr) {
+    _send_data_frames_by_priority(*priority_scheduler);
+  } else {
+    _send_data_frames_by_priority(*dependency_tree);
   }
+}
 
-  Http2Stream *stream = static_cast<Http2Stream *>(node->t);
-  ink_release_assert(stream != nullptr);
-  ink_release_assert(stream->priority_node == node);
-  Http2StreamDebug(session, stream->get_id(), "top node, point=%d", node->point);
-
-  size_t                   len    = 0;
-  Http2SendDataFrameResult result = send_a_data_frame(stream, len);
-  ink_release_assert(stream->priority_node != nullptr);
-
-  switch (result) {
-  case Http2SendDataFrameResult::NO_ERROR: {
-    // No response body to send
-    if (len == 0 && !stream->is_write_vio_done()) {
-      dependency_tree->deactivate(node, len);
-    } else {
-      dependency_tree->update(node, len);
-      SCOPED_MUTEX_LOCK(stream_lock, stream->mutex, this_ethread());
-      stream->signal_write_event(stream->is_write_vio_done() ? VC_EVENT_WRITE_COMPLETE : VC_EVENT_WRITE_READY);
+template <typename Scheduler>
+void
+Http2ConnectionState::_send_data_frames_by_priority(Scheduler &scheduler)
+{
+  // Send as many DATA frames as the windows and the write buffer take, the scheduler picks the stream of each one.
+  // The frames are flushed together once the pass is over.
+  uint32_t sent = Http2DependencyTree::pass(scheduler, PRIORITY_PASS_BYTES, [&](auto node, uint32_t &sent_len) {
+    if (_peer_rwnd <= 0 || this->session->is_write_high_water()) {
+      return false;
+    }
+
+    Http2Stream *stream = static_cast<Http2Stream *>(node->t);
+    ink_release_assert(stream != nullptr);
+    ink_release_assert(is_node_of(stream, node));
+    Http2StreamDebug(session, stream->get_id(), "top node");
+
+    size_t                   len    = 0;
+    Http2SendDataFrameResult result = send_a_data_frame(stream, len);
+    ink_release_assert(is_node_of(stream, node));
+    sent_len = len;
+
+    switch (result) {
+    case Http2SendDataFrameResult::NO_ERROR: {
+      // No response body to send
+      if (len == 0 && !stream->is_write_vio_done()) {
+        scheduler.deactivate(node, len);
+      } else {
+        scheduler.update(node, len);
+        SCOPED_MUTEX_LOCK(stream_lock, stream->mutex, this_ethread());
+        stream->signal_write_event(stream->is_write_vio_done() ? VC_EVENT_WRITE_COMPLETE : VC_EVENT_WRITE_READY);
+      }
+      break;
     }
-    break;
-  }
-  case Http2SendDataFrameResult::DONE: {
-    dependency_tree->deactivate(node, len);
-    stream->initiating_close();
-    break;
-  }
-  default:
-    // When no stream level window left, deactivate node once and wait window_update frame
-    dependency_tree->deactivate(node, len);
-    break;
-  }
+    case Http2SendDataFrameResult::DONE: {
+      scheduler.deactivate(node, len);
+      stream->initiating_close();
+      break;
+    }
+    default:
+      // When no stream level window left, deactivate node once and wait window_update frame
+      scheduler.deactivate(node, len);
+      break;
+    }
+    return true;
+  });
+  this->session->flush();
 
-  if (_priority_event == nullptr) {
+  // Only the budget ends a pass that could go on, everything else resumes on WINDOW_UPDATE or WRITE_READY
+  if (sent >= PRIORITY_PASS_BYTES && _priority_event == nullptr) {
     _priority_event = this_ethread()->schedule_imm_local(static_cast<Continuation *>(this), HTTP2_SESSION_EVENT_PRIO);
   }
-
-  return;
 }
 
 Http2SendDataFrameResult
@@ -2600,7 +2719,9 @@ Http2ConnectionState::send_push_promise_frame(Http2Stream *stream, URL &url, con
   }
 
   SCOPED_MUTEX_LOCK(stream_lock, stream->mutex, this_ethread());
-  if (Http2::stream_priority_enabled) {
+  if (this->priority_scheduler != nullptr) {
+    stream->urgency_node = this->priority_scheduler->add(id, ExtensiblePriority::Priority{}, stream);
+  } else if (this->dependency_tree != nullptr) {
     Http2DependencyTree::Node *node = this->dependency_tree->find(id);
     if (node != nullptr) {
       stream->priority_node = node;
@@ -2658,7 +2779,7 @@ Http2ConnectionState::send_settings_frame(const Http2ConnectionSettings &new_set
 
   Http2StreamDebug(session, stream_id, "Send SETTINGS frame");
 
-  Http2SettingsParameter params[HTTP2_SETTINGS_MAX];
+  Http2SettingsParameter params[HTTP2_SETTINGS_MAX + 1];
   size_t                 params_size = 0;
 
   for (int i = HTTP2_SETTINGS_HEADER_TABLE_SIZE; i < HTTP2_SETTINGS_MAX; ++i) {
@@ -2677,6 +2798,12 @@ Http2ConnectionState::send_settings_frame(const Http2ConnectionSettings &new_set
     }
   }
 
+  // [RFC 9218] 2.1. The value never changes, so repeating it in later SETTINGS frames is harmless.
+  if (this->priority_scheduler != nullptr) {
+    Http2StreamDebug(session, stream_id, "  SETTINGS_NO_RFC7540_PRIORITIES : 1");
+    params[params_size++] = {static_cast<uint16_t>(HTTP2_SETTINGS_NO_RFC7540_PRIORITIES), 1};
+  }
+
   Http2SettingsFrame settings(stream_id, HTTP2_FRAME_NO_FLAG, params, params_size);
 
   this->_outstanding_settings_frames.emplace(new_settings);
@@ -293,7 +293,7 @@ Http2Stream::decode_header_blocks(HpackHandle &hpack_handle, uint32_t maximum_ta
 }
 
 void
-Http2Stream::send_headers(Http2ConnectionState & /* cstate ATS_UNUSED */)
+Http2Stream::send_headers(Http2ConnectionState &cstate)
 {
   if (closed) {
     return;
@@ -320,6 +320,16 @@ Http2Stream::send_headers(Http2ConnectionState & /* cstate ATS_UNUSED */)
       if (method == std::string_view{HTTP_METHOD_CONNECT, static_cast<std::string_view::size_type>(HTTP_LEN_CONNECT)}) {
         this->_is_tunneling = true;
       }
+
+      // [RFC 9218] 5. The Priority HTTP Header Field, unless a PRIORITY_UPDATE frame has reprioritized the stream
+      if (this->urgency_node != nullptr && !this->urgency_node->updated) {
+        ExtensiblePriority::Priority priority;
+        for (MIMEField *field = _receive_header.field_find("Priority"); field != nullptr; field = field->m_next_dup) {
+          ExtensiblePriority::parse(field->value_get(), priority);
+        }
+        Http2StreamDebug("priority u=%u i=%d", priority.urgency, priority.incremental);
+        cstate.priority_scheduler->reprioritize(this->urgency_node, priority);
+      }
     }
     ink_release_assert(this->_sm != nullptr);
     this->_http_sm_id = this->_sm->sm_id;
@@ -972,7 +982,7 @@ Http2Stream::send_body(bool /* call_update ATS_UNUSED */)
   reentrancy_count++;
 
   SCOPED_MUTEX_LOCK(lock, _proxy_ssn->mutex, this_ethread());
-  if (Http2::stream_priority_enabled) {
+  if (this->priority_node != nullptr || this->urgency_node != nullptr) {
     connection_state.schedule_stream_to_send_priority_frames(this);
     // signal_write_event() will be called from `Http2ConnectionState::send_data_frames_depends_on_priority()`
     // when write_vio is consumed
@@ -21,7 +21,6 @@
     limitations under the License.
 */
 
-#include "proxy/hdrs/HuffmanCodec.h"
 #include "proxy/http2/HPACK.h"
 #include "iocore/eventsystem/EThread.h"
 #include "iocore/eventsystem/Thread.h"
@@ -413,11 +412,9 @@ main(int argc, const char **argv)
   url_init();
   mime_init();
   http_init();
-  hpack_huffman_init();
 
   prepare();
   int status = RegressionTest::main(argc, argv, REGRESSION_TEST_QUICK);
 
-  hpack_huffman_fin();
   return status;
 }
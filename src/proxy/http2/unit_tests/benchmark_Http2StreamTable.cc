@@ -0,0 +1,109 @@
+/** @file
+
+  Micro benchmark for finding the stream of a received frame.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "tscore/List.h"
+#include "proxy/http2/Http2StreamTable.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Stands in for Http2Stream, which is large enough that each one is on its own cache lines.
+struct Stream {
+  Http2StreamId id;
+  char          state[1024];
+  LINK(Stream, link);
+};
+
+// The previous Http2ConnectionState::find_stream, a walk of the stream list.
+Stream *
+find_in_list(Queue<Stream> const &list, Http2StreamId id)
+{
+  for (Stream *s = list.head; s; s = s->link.next) {
+    if (s->id == id) {
+      return s;
+    }
+  }
+  return nullptr;
+}
+
+void
+bench_streams(int n_streams)
+{
+  std::vector<std::unique_ptr<Stream>> streams;
+  Queue<Stream>                        list;
+  Http2StreamTable<Stream>             table;
+
+  for (int i = 0; i < n_streams; ++i) {
+    streams.push_back(std::make_unique<Stream>());
+    streams.back()->id = 2 * i + 1;
+    list.enqueue(streams.back().get());
+    table.insert(streams.back()->id, streams.back().get());
+  }
+
+  // DATA and WINDOW_UPDATE frames for random streams, and the occasional frame for a closed one.
+  std::vector<Http2StreamId> frames(4096);
+  std::mt19937               rng(7);
+  for (auto &id : frames) {
+    id = 2 * (rng() % (n_streams + n_streams / 16 + 1)) + 1;
+  }
+  for (auto id : frames) {
+    REQUIRE(find_in_list(list, id) == table.find(id));
+  }
+
+  BENCHMARK("stream list, " + std::to_string(n_streams) + " streams")
+  {
+    int n = 0;
+    for (auto id : frames) {
+      n += find_in_list(list, id) != nullptr;
+    }
+    return n;
+  };
+
+  BENCHMARK("stream table, " + std::to_string(n_streams) + " streams")
+  {
+    int n = 0;
+    for (auto id : frames) {
+      n += table.find(id) != nullptr;
+    }
+    return n;
+  };
+
+  while (list.pop()) {}
+}
+
+} // end anonymous namespace
+
+TEST_CASE("Http2 find stream", "[http2][bench]")
+{
+  for (int n_streams : {8, 100, 256, 1000}) {
+    bench_streams(n_streams);
+  }
+}
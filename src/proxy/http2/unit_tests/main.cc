@@ -31,8 +31,6 @@
 
 #include "iocore/utils/diags.i"
 
-#include "proxy/hdrs/HuffmanCodec.h"
-
 #define TEST_THREADS 1
 
 struct EventProcessorListener : Catch::TestEventListenerBase {
@@ -51,14 +49,6 @@ struct EventProcessorListener : Catch::TestEventListenerBase {
 
     EThread *main_thread = new EThread;
     main_thread->set_specific();
-
-    hpack_huffman_init();
-  }
-
-  void
-  testRunEnded(Catch::TestRunStats const & /* testRunStats */) override
-  {
-    hpack_huffman_fin();
   }
 };
 
@@ -194,3 +194,29 @@ TEST_CASE("Convert HTTPHdr", "[HTTP2]")
     CHECK_THAT(buf, Catch::StartsWith("HTTP/1.1 200 OK\r\n\r\n"));
   }
 }
+
+TEST_CASE("Parse PRIORITY_UPDATE", "[HTTP2]")
+{
+  Http2StreamId prioritized_id = 0;
+
+  SECTION("stream id")
+  {
+    uint8_t payload[] = {0x00, 0x00, 0x01, 0x05};
+    REQUIRE(http2_parse_priority_update(make_iovec(payload), prioritized_id));
+    CHECK(prioritized_id == 0x105);
+  }
+
+  SECTION("reserved bit")
+  {
+    uint8_t payload[] = {0x80, 0x00, 0x00, 0x03};
+    REQUIRE(http2_parse_priority_update(make_iovec(payload), prioritized_id));
+    CHECK(prioritized_id == 3);
+  }
+
+  SECTION("largest stream id")
+  {
+    uint8_t payload[] = {0xff, 0xff, 0xff, 0xff};
+    REQUIRE(http2_parse_priority_update(make_iovec(payload), prioritized_id));
+    CHECK(prioritized_id == 0x7fffffff);
+  }
+}
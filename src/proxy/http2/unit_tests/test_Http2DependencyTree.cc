@@ -25,6 +25,7 @@
 
 #include <iostream>
 #include <cstring>
+#include <map>
 #include <sstream>
 
 #include "proxy/http2/Http2DependencyTree.h"
@@ -892,3 +893,86 @@ TEST_CASE("Http2DependencyTree_max_depth", "[http2][Http2DependencyTree]")
   REQUIRE(leaf != nullptr);
   REQUIRE(leaf->parent->id != 0);
 }
+
+/**
+ * One pass sends the frames of all the active streams, by their weights
+ *
+ *       x
+ *     / | \
+ *    A  B  C
+ *
+ * A has weight 16, B has 48 and C, with weight 16, has a single frame to send.
+ */
+TEST_CASE("Http2DependencyTree_pass", "[http2][Http2DependencyTree]")
+{
+  constexpr uint32_t FRAME  = 16384;
+  constexpr uint32_t BUDGET = 256 * 1024;
+
+  auto   tree = std::make_unique<Tree>(100);
+  string a("A"), b("B"), c("C");
+  map<string *, int> frames = {
+    {&a, 100},
+    {&b, 100},
+    {&c, 1  },
+  };
+  map<string *, int> sent_frames;
+
+  tree->add(0, 1, 15, false, &a);
+  tree->add(0, 3, 47, false, &b);
+  tree->add(0, 5, 15, false, &c);
+  tree->activate(tree->find(1));
+  tree->activate(tree->find(3));
+  tree->activate(tree->find(5));
+
+  ostringstream oss;
+  auto          send = [&](Node *node, uint32_t &len) {
+    string *t = static_cast<string *>(node->t);
+    oss << *t;
+    len = FRAME;
+    ++sent_frames[t];
+    if (--frames[t] == 0) {
+      tree->deactivate(node, len);
+    } else {
+      tree->update(node, len);
+    }
+    return true;
+  };
+
+  SECTION("budget")
+  {
+    REQUIRE(Http2DependencyTree::pass(*tree, BUDGET, send) == BUDGET);
+
+    // C is done, the pass went on with the other streams, B getting about three times the frames of A.
+    CHECK(sent_frames[&c] == 1);
+    CHECK(tree->find(5)->active == false);
+    CHECK(sent_frames[&a] + sent_frames[&b] == BUDGET / FRAME - 1);
+    CHECK(sent_frames[&a] >= 3);
+    CHECK(sent_frames[&b] >= 2 * sent_frames[&a]);
+    CHECK(oss.str().substr(0, 4).find('A') != string::npos);
+    CHECK(oss.str().substr(0, 4).find('B') != string::npos);
+
+    // The budget ended the pass, the next one goes on where it stopped.
+    REQUIRE(tree->top() != nullptr);
+    REQUIRE(Http2DependencyTree::pass(*tree, BUDGET, send) == BUDGET);
+    CHECK(sent_frames[&a] + sent_frames[&b] == 2 * BUDGET / FRAME - 1);
+    CHECK(sent_frames[&b] >= 2 * sent_frames[&a]);
+  }
+
+  SECTION("no active node")
+  {
+    frames[&a] = 2;
+    frames[&b] = 3;
+    REQUIRE(Http2DependencyTree::pass(*tree, BUDGET, send) == 6 * FRAME);
+    REQUIRE(tree->top() == nullptr);
+    REQUIRE(Http2DependencyTree::pass(*tree, BUDGET, send) == 0);
+  }
+
+  SECTION("send stops the pass")
+  {
+    int  calls = 0;
+    auto stop  = [&](Node *node, uint32_t &len) { return ++calls <= 3 ? send(node, len) : false; };
+    REQUIRE(Http2DependencyTree::pass(*tree, BUDGET, stop) == 3 * FRAME);
+    CHECK(calls == 4);
+    CHECK(tree->top() != nullptr);
+  }
+}
@@ -0,0 +1,138 @@
+/** @file
+
+    Unit tests for Http2StreamTable
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "proxy/http2/Http2StreamTable.h"
+
+using Table = Http2StreamTable<uint32_t>;
+
+namespace
+{
+// Every id in @a expected is found with its value, and nothing else near them is.
+void
+check(Table const &table, std::map<Http2StreamId, uint32_t> &expected, Http2StreamId max_id)
+{
+  REQUIRE(table.size() == expected.size());
+  for (Http2StreamId id = 1; id <= max_id; ++id) {
+    auto spot = expected.find(id);
+    if (spot == expected.end()) {
+      REQUIRE(table.find(id) == nullptr);
+    } else {
+      REQUIRE(table.find(id) == &spot->second);
+    }
+  }
+}
+} // end anonymous namespace
+
+TEST_CASE("Http2StreamTable empty", "[http2][Http2StreamTable]")
+{
+  Table table;
+
+  CHECK(table.size() == 0);
+  CHECK(table.find(0) == nullptr);
+  CHECK(table.find(1) == nullptr);
+  CHECK_FALSE(table.erase(1));
+}
+
+TEST_CASE("Http2StreamTable client streams", "[http2][Http2StreamTable]")
+{
+  // Streams opened in order and closed mostly in order, a few staying open for long.
+  Table                              table;
+  std::map<Http2StreamId, uint32_t> expected;
+  Http2StreamId                      next = 1;
+
+  for (int round = 0; round < 50; ++round) {
+    for (int i = 0; i < 40; ++i, next += 2) {
+      expected[next] = next;
+      table.insert(next, &expected[next]);
+    }
+    int n = 0;
+    for (auto spot = expected.begin(); spot != expected.end() && n < 35; ++n) {
+      if (spot->first % 7 == 0) {
+        ++spot;
+        continue;
+      }
+      REQUIRE(table.erase(spot->first));
+      spot = expected.erase(spot);
+    }
+    check(table, expected, next);
+  }
+  CHECK_FALSE(table.erase(next));
+}
+
+TEST_CASE("Http2StreamTable random", "[http2][Http2StreamTable]")
+{
+  Table                              table;
+  std::map<Http2StreamId, uint32_t> expected;
+  std::mt19937                       rng(13);
+  Http2StreamId const                max_id = 2000;
+
+  for (int i = 0; i < 20000; ++i) {
+    Http2StreamId id = rng() % max_id + 1;
+    if (expected.count(id)) {
+      REQUIRE(table.erase(id));
+      expected.erase(id);
+    } else {
+      expected[id] = i;
+      table.insert(id, &expected[id]);
+    }
+    if (i % 1000 == 0) {
+      check(table, expected, max_id);
+    }
+  }
+  check(table, expected, max_id);
+
+  for (auto const &[id, value] : expected) {
+    REQUIRE(table.erase(id));
+  }
+  CHECK(table.size() == 0);
+  CHECK(table.find(1) == nullptr);
+}
+
+TEST_CASE("Http2StreamTable clear", "[http2][Http2StreamTable]")
+{
+  Table                              table;
+  std::map<Http2StreamId, uint32_t> expected;
+
+  for (Http2StreamId id = 1; id < 200; id += 2) {
+    expected[id] = id;
+    table.insert(id, &expected[id]);
+  }
+  table.clear();
+  CHECK(table.size() == 0);
+  CHECK(table.find(1) == nullptr);
+  CHECK_FALSE(table.erase(1));
+
+  // The table is usable again after being cleared.
+  for (Http2StreamId id = 1; id < 200; id += 4) {
+    table.insert(id, &expected[id]);
+  }
+  for (Http2StreamId id = 1; id < 200; id += 2) {
+    CHECK(table.find(id) == (id % 4 == 1 ? &expected[id] : nullptr));
+  }
+}
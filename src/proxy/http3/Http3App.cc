@@ -29,6 +29,7 @@
 
 #include "../../iocore/net/P_Net.h"
 #include "../../iocore/eventsystem/P_VConnection.h"
+#include "iocore/net/quic/QUICConfig.h"
 #include "iocore/net/quic/QUICStreamManager.h"
 #include "iocore/net/quic/QUICStreamVCAdapter.h"
 
@@ -37,6 +38,7 @@
 #include "proxy/http3/Http3DebugNames.h"
 #include "proxy/http3/Http3Session.h"
 #include "proxy/http3/Http3Transaction.h"
+#include "proxy/http3/Http3PriorityUpdateHandler.h"
 #include "proxy/http3/Http3ProtocolEnforcer.h"
 #include "proxy/http3/Http3SettingsHandler.h"
 #include "proxy/http3/Http3SettingsFramer.h"
@@ -70,6 +72,15 @@ Http3App::Http3App(NetVConnection *client_vc, QUICConnection *qc, IpAllow::ACL &
   this->_settings_handler = new Http3SettingsHandler(this->_ssn);
   this->_control_stream_dispatcher.add_handler(this->_settings_handler);
 
+  QUICConfig::scoped_config quic_params;
+  this->_priority_update_handler = new Http3PriorityUpdateHandler(
+    [this](QUICStreamId id) -> QUICStream * {
+      auto it = this->_streams.find(id);
+      return it != this->_streams.end() ? &it->second.adapter.stream() : nullptr;
+    },
+    quic_params->initial_max_streams_bidi_in());
+  this->_control_stream_dispatcher.add_handler(this->_priority_update_handler);
+
   this->_settings_framer = new Http3SettingsFramer(client_vc->get_context());
   this->_control_stream_collector.add_generator(this->_settings_framer);
 
@@ -80,6 +91,7 @@ Http3App::~Http3App()
 {
   delete this->_ssn;
   delete this->_settings_handler;
+  delete this->_priority_update_handler;
   delete this->_settings_framer;
 }
 
@@ -126,6 +138,7 @@ Http3App::on_stream_open(QUICStream &stream)
   }
 
   stream.set_io_adapter(&info.adapter);
+  this->_priority_update_handler->on_stream_open(stream);
 }
 
 void
@@ -27,10 +27,11 @@
 #include "proxy/http3/Http3Frame.h"
 #include "proxy/http3/Http3Config.h"
 
-ClassAllocator<Http3Frame>         http3FrameAllocator("http3FrameAllocator");
-ClassAllocator<Http3DataFrame>     http3DataFrameAllocator("http3DataFrameAllocator");
-ClassAllocator<Http3HeadersFrame>  http3HeadersFrameAllocator("http3HeadersFrameAllocator");
-ClassAllocator<Http3SettingsFrame> http3SettingsFrameAllocator("http3SettingsFrameAllocator");
+ClassAllocator<Http3Frame>               http3FrameAllocator("http3FrameAllocator");
+ClassAllocator<Http3DataFrame>           http3DataFrameAllocator("http3DataFrameAllocator");
+ClassAllocator<Http3HeadersFrame>        http3HeadersFrameAllocator("http3HeadersFrameAllocator");
+ClassAllocator<Http3SettingsFrame>       http3SettingsFrameAllocator("http3SettingsFrameAllocator");
+ClassAllocator<Http3PriorityUpdateFrame> http3PriorityUpdateFrameAllocator("http3PriorityUpdateFrameAllocator");
 
 namespace
 {
@@ -40,6 +41,18 @@ constexpr int HEADER_OVERHEAD      = 10; // This should work as long as a payloa
 
 DbgCtl dbg_ctl_http3_frame_factory{"http3_frame_factory"};
 
+Http3FrameType
+frame_type(uint64_t type)
+{
+  if (type <= static_cast<uint64_t>(Http3FrameType::X_MAX_DEFINED)) {
+    return static_cast<Http3FrameType>(type);
+  } else if (type == HTTP3_PRIORITY_UPDATE_FRAME_TYPE) {
+    return Http3FrameType::PRIORITY_UPDATE;
+  } else {
+    return Http3FrameType::UNKNOWN;
+  }
+}
+
 } // end anonymous namespace
 
 //
@@ -60,11 +73,7 @@ Http3Frame::type(const uint8_t *buf, size_t buf_len)
   size_t   type_field_length = 0;
   int      ret               = QUICVariableInt::decode(type, type_field_length, buf, buf_len);
   ink_assert(ret != 1);
-  if (type <= static_cast<uint64_t>(Http3FrameType::X_MAX_DEFINED)) {
-    return static_cast<Http3FrameType>(type);
-  } else {
-    return Http3FrameType::UNKNOWN;
-  }
+  return frame_type(type);
 }
 
 //
@@ -141,11 +150,7 @@ Http3Frame::length() const
 Http3FrameType
 Http3Frame::type() const
 {
-  if (static_cast<uint64_t>(this->_type) <= static_cast<uint64_t>(Http3FrameType::X_MAX_DEFINED)) {
-    return this->_type;
-  } else {
-    return Http3FrameType::UNKNOWN;
-  }
+  return frame_type(static_cast<uint64_t>(this->_type));
 }
 
 bool
@@ -490,6 +495,54 @@ Http3SettingsFrame::_parse()
   return true;
 }
 
+//
+// PRIORITY_UPDATE Frame
+//
+
+Http3PriorityUpdateFrame::Http3PriorityUpdateFrame(IOBufferReader &reader) : Http3Frame(reader) {}
+
+void
+Http3PriorityUpdateFrame::reset(IOBufferReader &reader)
+{
+  this->~Http3PriorityUpdateFrame();
+  new (this) Http3PriorityUpdateFrame(reader);
+}
+
+uint64_t
+Http3PriorityUpdateFrame::prioritized_element_id() const
+{
+  return this->_prioritized_element_id;
+}
+
+std::string_view
+Http3PriorityUpdateFrame::priority_field_value() const
+{
+  return this->_priority_field_value;
+}
+
+bool
+Http3PriorityUpdateFrame::_parse()
+{
+  if (this->_reader->read_avail() != static_cast<int64_t>(this->_length)) {
+    // Whole payload is not received yet
+    return false;
+  }
+
+  this->_priority_field_value.resize(this->_length);
+  this->_reader->memcpy(this->_priority_field_value.data(), this->_length);
+
+  size_t id_len = 0;
+  if (this->_length == 0 || QUICVariableInt::decode(this->_prioritized_element_id, id_len,
+                                                    reinterpret_cast<const uint8_t *>(this->_priority_field_value.data()),
+                                                    this->_length) != 0) {
+    this->_is_valid = false;
+    return true;
+  }
+  this->_priority_field_value.erase(0, id_len);
+
+  return true;
+}
+
 //
 // Http3FrameFactory
 //
@@ -522,6 +575,10 @@ Http3FrameFactory::create(IOBufferReader &reader)
     frame = http3SettingsFrameAllocator.alloc();
     new (frame) Http3SettingsFrame(reader, params->max_settings());
     return Http3FrameUPtr(frame, &Http3FrameDeleter::delete_settings_frame);
+  case Http3FrameType::PRIORITY_UPDATE:
+    frame = http3PriorityUpdateFrameAllocator.alloc();
+    new (frame) Http3PriorityUpdateFrame(reader);
+    return Http3FrameUPtr(frame, &Http3FrameDeleter::delete_priority_update_frame);
   default:
     // Unknown frame
     Dbg(dbg_ctl_http3_frame_factory, "Unknown frame type %hhx", static_cast<uint8_t>(type));
@@ -81,6 +81,12 @@ Http3HeaderVIOAdaptor::is_complete()
   return this->_is_complete;
 }
 
+const ExtensiblePriority::Priority &
+Http3HeaderVIOAdaptor::get_priority() const
+{
+  return this->_priority;
+}
+
 int
 Http3HeaderVIOAdaptor::event_handler(int event, Event * /* data ATS_UNUSED */)
 {
@@ -122,6 +128,11 @@ Http3HeaderVIOAdaptor::_on_qpack_decode_complete()
     return 0;
   }
 
+  // [RFC 9218] 5. The Priority HTTP Header Field
+  for (MIMEField *field = this->_header.field_find("Priority"); field != nullptr; field = field->m_next_dup) {
+    ExtensiblePriority::parse(field->value_get(), this->_priority);
+  }
+
   SCOPED_MUTEX_LOCK(lock, this->_sink_vio->mutex, this_ethread());
   MIOBuffer *writer = this->_sink_vio->get_writer();
 
@@ -0,0 +1,98 @@
+/** @file
+ *
+ *  PRIORITY_UPDATE Frame Handler for Http3
+ *
+ *  @section license License
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "proxy/http3/Http3PriorityUpdateHandler.h"
+
+namespace
+{
+DbgCtl dbg_ctl_http3{"http3"};
+
+} // end anonymous namespace
+
+//
+// PRIORITY_UPDATE frame handler
+//
+std::vector<Http3FrameType>
+Http3PriorityUpdateHandler::interests()
+{
+  return {Http3FrameType::PRIORITY_UPDATE};
+}
+
+Http3ErrorUPtr
+Http3PriorityUpdateHandler::handle_frame(std::shared_ptr<const Http3Frame> frame, Http3StreamType /* s_type */)
+{
+  ink_assert(frame->type() == Http3FrameType::PRIORITY_UPDATE);
+
+  const Http3PriorityUpdateFrame *update_frame = dynamic_cast<const Http3PriorityUpdateFrame *>(frame.get());
+
+  if (!update_frame) {
+    return Http3ErrorUPtr(nullptr);
+  }
+
+  if (!update_frame->is_valid()) {
+    return std::make_unique<Http3Error>(Http3ErrorClass::CONNECTION, Http3ErrorCode::H3_FRAME_ERROR,
+                                        "invalid PRIORITY_UPDATE frame");
+  }
+
+  // Only client initiated bidirectional streams carry requests.
+  QUICStreamId id = update_frame->prioritized_element_id();
+  if ((id & 0x03) != 0) {
+    return std::make_unique<Http3Error>(Http3ErrorClass::CONNECTION, Http3ErrorCode::H3_ID_ERROR,
+                                        "PRIORITY_UPDATE for a stream which is not a request stream");
+  }
+
+  // The update replaces the whole priority, parameters it leaves out take their defaults. A field value which does not
+  // parse is ignored and the stream keeps its priority.
+  ExtensiblePriority::Priority priority;
+  if (!ExtensiblePriority::parse(update_frame->priority_field_value(), priority)) {
+    return Http3ErrorUPtr(nullptr);
+  }
+
+  if (QUICStream *stream = this->_find_stream(id); stream != nullptr) {
+    Dbg(dbg_ctl_http3, "[%" PRIu64 "] PRIORITY_UPDATE urgency=%u incremental=%d", id, priority.urgency, priority.incremental);
+    stream->set_priority(priority.urgency, priority.incremental, true);
+  } else if (static_cast<int64_t>(id) > this->_latest_stream_id) {
+    if (!this->_pending.add(id, priority, this->_max_pending)) {
+      Dbg(dbg_ctl_http3, "[%" PRIu64 "] PRIORITY_UPDATE dropped, too many idle streams prioritized", id);
+    }
+  } else {
+    Dbg(dbg_ctl_http3, "[%" PRIu64 "] PRIORITY_UPDATE for a closed stream", id);
+  }
+
+  return Http3ErrorUPtr(nullptr);
+}
+
+void
+Http3PriorityUpdateHandler::on_stream_open(QUICStream &stream)
+{
+  if (!stream.is_bidirectional()) {
+    return;
+  }
+
+  this->_latest_stream_id = std::max(this->_latest_stream_id, static_cast<int64_t>(stream.id()));
+
+  ExtensiblePriority::Priority priority;
+  if (this->_pending.take(stream.id(), priority)) {
+    stream.set_priority(priority.urgency, priority.incremental, true);
+  }
+}
@@ -605,6 +605,12 @@ Http3Transaction::_process_write_vio()
   ink_release_assert(this->_thread == this_ethread());
   SCOPED_MUTEX_LOCK(lock, this->_info.write_vio->mutex, this_ethread());
 
+  // [RFC 9218] quiche orders the data of the streams, it gets the priority the request asked for.
+  if (this->_header_handler->is_complete()) {
+    const ExtensiblePriority::Priority &priority = this->_header_handler->get_priority();
+    this->_info.adapter.stream().set_priority(priority.urgency, priority.incremental);
+  }
+
   size_t nwritten = 0;
   bool   all_done = false;
   auto   error    = this->_frame_collector.on_write_ready(this->_info.adapter.stream().id(), *this->_info.write_vio->get_writer(),
@@ -34,7 +34,6 @@
 #include "records/RecordsConfig.h"
 
 #include "iocore/net/quic/QUICConfig.h"
-#include "proxy/hdrs/HuffmanCodec.h"
 #include "proxy/hdrs/HTTP.h"
 
 #define TEST_THREADS 1
@@ -75,7 +74,6 @@ struct EventProcessorListener : Catch::TestEventListenerBase {
     url_init();
     mime_init();
     http_init();
-    hpack_huffman_init();
   }
 };
 CATCH_REGISTER_LISTENER(EventProcessorListener);
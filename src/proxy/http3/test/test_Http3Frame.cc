@@ -25,6 +25,7 @@
 #include <cstdio>
 #include "proxy/http3/Http3Frame.h"
 #include "proxy/http3/Http3FrameDispatcher.h"
+#include "proxy/http3/Http3PriorityUpdateHandler.h"
 #include "proxy/http3/Http3SettingsHandler.h"
 
 TEST_CASE("Http3Frame Type", "[http3]")
@@ -33,6 +34,8 @@ TEST_CASE("Http3Frame Type", "[http3]")
   // Undefined range
   CHECK(Http3Frame::type(reinterpret_cast<const uint8_t *>("\x0f\x00"), 2) == Http3FrameType::UNKNOWN);
   CHECK(Http3Frame::type(reinterpret_cast<const uint8_t *>("\xff\xff\xff\xff\xff\xff\xff\x00"), 9) == Http3FrameType::UNKNOWN);
+  // Known by its own type, the type code is outside the densely numbered ones
+  CHECK(Http3Frame::type(reinterpret_cast<const uint8_t *>("\x80\x0f\x07\x00"), 4) == Http3FrameType::PRIORITY_UPDATE);
 }
 
 TEST_CASE("Load DATA Frame", "[http3]")
@@ -325,3 +328,143 @@ TEST_CASE("SETTINGS frame handler", "[http3]")
 
   free_MIOBuffer(input);
 }
+
+TEST_CASE("Load PRIORITY_UPDATE Frame", "[http3]")
+{
+  MIOBuffer      *input        = new_MIOBuffer(BUFFER_SIZE_INDEX_128);
+  IOBufferReader *input_reader = input->alloc_reader();
+
+  SECTION("Normal")
+  {
+    uint8_t buf[] = {
+      0x80, 0x0f, 0x07, 0x00,          // Type
+      0x08,                            // Length
+      0x40, 0x44,                      // Prioritized Element ID
+      'u',  '=',  '1',  ',', ' ', 'i', // Priority Field Value
+    };
+    input->write(buf, sizeof(buf));
+
+    std::shared_ptr<Http3Frame> frame = Http3FrameFactory::create(*input_reader);
+    REQUIRE(frame->update());
+    CHECK(frame->type() == Http3FrameType::PRIORITY_UPDATE);
+
+    std::shared_ptr<Http3PriorityUpdateFrame> update_frame = std::dynamic_pointer_cast<Http3PriorityUpdateFrame>(frame);
+    REQUIRE(update_frame);
+    CHECK(update_frame->is_valid());
+    CHECK(update_frame->prioritized_element_id() == 0x44);
+    CHECK(update_frame->priority_field_value() == "u=1, i");
+  }
+
+  SECTION("Empty")
+  {
+    uint8_t buf[] = {
+      0x80, 0x0f, 0x07, 0x00, // Type
+      0x00,                   // Length
+    };
+    input->write(buf, sizeof(buf));
+
+    std::shared_ptr<Http3Frame> frame = Http3FrameFactory::create(*input_reader);
+    REQUIRE(frame->update());
+    CHECK_FALSE(frame->is_valid());
+  }
+
+  free_MIOBuffer(input);
+}
+
+namespace
+{
+std::shared_ptr<const Http3Frame>
+priority_update_frame(MIOBuffer *input, uint8_t id, std::string_view value)
+{
+  // The frame takes the reader, which starts after the frames loaded before
+  IOBufferReader *reader = input->alloc_reader();
+  reader->consume(reader->read_avail());
+
+  uint8_t header[] = {0x80, 0x0f, 0x07, 0x00, static_cast<uint8_t>(1 + value.size()), id};
+  input->write(header, sizeof(header));
+  input->write(value.data(), value.size());
+
+  std::shared_ptr<Http3Frame> frame = Http3FrameFactory::create(*reader);
+  REQUIRE(frame->update());
+  return frame;
+}
+
+} // end anonymous namespace
+
+TEST_CASE("PRIORITY_UPDATE frame handler", "[http3]")
+{
+  std::map<QUICStreamId, QUICStream> streams;
+  MIOBuffer                         *input = new_MIOBuffer(BUFFER_SIZE_INDEX_128);
+  Http3PriorityUpdateHandler         handler(
+    [&](QUICStreamId id) -> QUICStream * {
+      auto it = streams.find(id);
+      return it != streams.end() ? &it->second : nullptr;
+    },
+    2);
+  auto open = [&](QUICStreamId id) -> QUICStream & {
+    QUICStream &stream = streams.try_emplace(id, nullptr, id).first->second;
+    handler.on_stream_open(stream);
+    return stream;
+  };
+
+  SECTION("open stream")
+  {
+    QUICStream &stream = open(4);
+    stream.set_priority(5, false);
+    REQUIRE(handler.handle_frame(priority_update_frame(input, 4, "u=1, i")) == nullptr);
+    CHECK(stream.urgency() == 1);
+    CHECK(stream.is_incremental());
+
+    // The Priority header field of the request no longer changes it
+    stream.set_priority(6, false);
+    CHECK(stream.urgency() == 1);
+  }
+
+  SECTION("stream not open yet")
+  {
+    REQUIRE(handler.handle_frame(priority_update_frame(input, 8, "u=0")) == nullptr);
+    QUICStream &skipped = open(4);
+    CHECK(skipped.urgency() == 3);
+    QUICStream &stream = open(8);
+    CHECK(stream.urgency() == 0);
+    CHECK_FALSE(stream.is_incremental());
+    stream.set_priority(6, true);
+    CHECK(stream.urgency() == 0);
+  }
+
+  SECTION("closed stream")
+  {
+    open(4);
+    streams.clear();
+    REQUIRE(handler.handle_frame(priority_update_frame(input, 4, "u=0")) == nullptr);
+    CHECK(open(4).urgency() == 3);
+  }
+
+  SECTION("as many pending streams as may be open")
+  {
+    REQUIRE(handler.handle_frame(priority_update_frame(input, 4, "u=0")) == nullptr);
+    REQUIRE(handler.handle_frame(priority_update_frame(input, 8, "u=0")) == nullptr);
+    REQUIRE(handler.handle_frame(priority_update_frame(input, 12, "u=0")) == nullptr);
+    CHECK(open(4).urgency() == 0);
+    CHECK(open(8).urgency() == 0);
+    CHECK(open(12).urgency() == 3);
+  }
+
+  SECTION("field value which does not parse")
+  {
+    QUICStream &stream = open(4);
+    REQUIRE(handler.handle_frame(priority_update_frame(input, 4, "u=")) == nullptr);
+    CHECK(stream.urgency() == 3);
+    stream.set_priority(6, false);
+    CHECK(stream.urgency() == 6);
+  }
+
+  SECTION("not a request stream")
+  {
+    Http3ErrorUPtr error = handler.handle_frame(priority_update_frame(input, 2, "u=0"));
+    REQUIRE(error);
+    CHECK(error->code == Http3ErrorCode::H3_ID_ERROR);
+  }
+
+  free_MIOBuffer(input);
+}
@@ -347,3 +347,47 @@ TEST_CASE("Reserved frame type not allowed", "[http3]")
     free_MIOBuffer(buf);
   }
 }
+
+TEST_CASE("PRIORITY_UPDATE frame only on control stream", "[http3]")
+{
+  Http3FrameDispatcher  http3FrameDispatcher;
+  Http3ProtocolEnforcer enforcer;
+  http3FrameDispatcher.add_handler(&enforcer);
+
+  MIOBuffer      *buf    = new_MIOBuffer(BUFFER_SIZE_INDEX_512);
+  IOBufferReader *reader = buf->alloc_reader();
+  uint64_t        nread  = 0;
+  Http3ErrorUPtr  error  = Http3ErrorUPtr(nullptr);
+
+  uint8_t priority_update[] = {
+    0x80, 0x0f, 0x07, 0x00, // Type
+    0x04,                   // Length
+    0x00,                   // Prioritized Element ID
+    'u',  '=',  '0',        // Priority Field Value
+  };
+
+  SECTION("control stream")
+  {
+    uint8_t settings[] = {
+      0x04, // Type
+      0x00, // Length
+    };
+    buf->write(settings, sizeof(settings));
+    buf->write(priority_update, sizeof(priority_update));
+
+    error = http3FrameDispatcher.on_read_ready(0, Http3StreamType::CONTROL, *reader, nread);
+    CHECK(!error);
+    CHECK(nread == sizeof(settings) + sizeof(priority_update));
+  }
+
+  SECTION("request stream")
+  {
+    buf->write(priority_update, sizeof(priority_update));
+
+    error = http3FrameDispatcher.on_read_ready(0, Http3StreamType::UNKNOWN, *reader, nread);
+    REQUIRE(error);
+    CHECK(error->code == Http3ErrorCode::H3_FRAME_UNEXPECTED);
+  }
+
+  free_MIOBuffer(buf);
+}
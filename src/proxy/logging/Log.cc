@@ -1352,7 +1352,8 @@ Log::flush_thread_main(void * /* args ATS_UNUSED */)
         buf         = reinterpret_cast<char *>(buffer_header);
         total_bytes = buffer_header->byte_count;
 
-      } else if (logfile->m_file_format == LOG_FILE_ASCII || logfile->m_file_format == LOG_FILE_PIPE) {
+      } else if (logfile->m_file_format == LOG_FILE_ASCII || logfile->m_file_format == LOG_FILE_PIPE ||
+                 logfile->m_file_format == LOG_FILE_COLUMNAR) {
         buf         = static_cast<char *>(fdata->m_data);
         total_bytes = fdata->m_len;
 
@@ -0,0 +1,314 @@
+/** @file
+
+  Columnar, block compressed encoding of LogBuffers.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "proxy/logging/LogColumnar.h"
+#include "proxy/logging/LogBuffer.h"
+#include "proxy/logging/LogField.h"
+
+#include "tscore/ink_memory.h"
+
+#include <algorithm>
+#include <cstring>
+#ifdef HAVE_ZSTD_H
+#include <zstd.h>
+#endif
+
+namespace
+{
+DbgCtl dbg_ctl_log_columnar{"log-columnar"};
+
+// Favor speed, this runs for every LogBuffer.
+constexpr int ZSTD_LEVEL = 1;
+
+// Largest LogBuffer a block may decode to.
+constexpr uint32_t MAX_BUFFER_BYTES = 64 * 1024 * 1024;
+
+inline uint64_t
+zigzag(int64_t v)
+{
+  return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t
+unzigzag(uint64_t v)
+{
+  return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+void
+put_varint(std::vector<char> &out, uint64_t v)
+{
+  while (v >= 0x80) {
+    out.push_back(static_cast<char>(v | 0x80));
+    v >>= 7;
+  }
+  out.push_back(static_cast<char>(v));
+}
+
+bool
+get_varint(const char *&p, const char *end, uint64_t &v)
+{
+  v = 0;
+  for (int shift = 0; p < end && shift < 64; shift += 7) {
+    uint8_t byte  = static_cast<uint8_t>(*p++);
+    v            |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+#ifdef HAVE_ZSTD_H
+// One compression context per preproc thread, so it is not set up again for every buffer.
+struct CompressContext {
+  ZSTD_CCtx *cctx = ZSTD_createCCtx();
+  ~CompressContext() { ZSTD_freeCCtx(cctx); }
+};
+#endif
+
+} // end anonymous namespace
+
+char *
+LogColumnar::encode(LogBufferHeader *header, LogFieldList *fields, int *len)
+{
+  ink_assert(header != nullptr);
+  ink_assert(len != nullptr);
+
+  uint32_t const schema_bytes = header->data_offset;
+  if (schema_bytes < sizeof(LogBufferHeader) || schema_bytes > header->byte_count) {
+    Note("Cannot encode LogBuffer with data offset %u and %u bytes", schema_bytes, header->byte_count);
+    return nullptr;
+  }
+
+  unsigned const n_fields     = fields ? fields->count() : 0;
+  unsigned const column_count = n_fields > 0 ? n_fields : 1;
+
+  // Split every entry into its columns first, then lay the payload out column by column.
+  std::vector<const char *> entry_data;
+  std::vector<uint32_t>     segments;
+  std::vector<char>         payload;
+
+  entry_data.reserve(header->entry_count);
+  segments.reserve(static_cast<size_t>(header->entry_count) * column_count);
+  payload.reserve(header->byte_count);
+
+  char const       *buffer_end = reinterpret_cast<char *>(header) + header->byte_count;
+  LogBufferIterator iter(header);
+  int64_t           prev_timestamp = 0;
+  size_t            entry_bytes    = 0;
+
+  while (LogEntryHeader *entry = iter.next()) {
+    char const *data = reinterpret_cast<char *>(entry) + sizeof(LogEntryHeader);
+    size_t      room = buffer_end - reinterpret_cast<char *>(entry);
+    if (entry->entry_len < sizeof(LogEntryHeader) || entry->entry_len > room) {
+      Note("Cannot encode LogBuffer with an entry of %u bytes", entry->entry_len);
+      return nullptr;
+    }
+    put_varint(payload, zigzag(entry->timestamp - prev_timestamp));
+    put_varint(payload, zigzag(entry->timestamp_usec));
+    prev_timestamp = entry->timestamp;
+
+    // The sizes only have to be good guesses, the last column takes whatever is left.
+    unsigned    left  = entry->entry_len - sizeof(LogEntryHeader);
+    char const *p     = data;
+    LogField   *field = fields ? fields->first() : nullptr;
+    for (unsigned column = 0; column < column_count; ++column) {
+      unsigned n  = (column + 1 == column_count || field == nullptr) ? left : field->marshaled_len(p, left);
+      p          += n;
+      left       -= n;
+      segments.push_back(n);
+      field = field ? fields->next(field) : nullptr;
+    }
+    entry_data.push_back(data);
+    entry_bytes += entry->entry_len;
+  }
+  if (entry_data.size() != header->entry_count) {
+    Note("Cannot encode LogBuffer; found %zu of %u entries", entry_data.size(), header->entry_count);
+    return nullptr;
+  }
+
+  for (uint32_t n : segments) {
+    put_varint(payload, n);
+  }
+  size_t const lengths_end = payload.size();
+  payload.resize(lengths_end + entry_bytes - entry_data.size() * sizeof(LogEntryHeader));
+
+  // entry_data is the read position in each entry, the columns are copied in order
+  char *out = payload.data() + lengths_end;
+  for (unsigned column = 0; column < column_count; ++column) {
+    for (size_t e = 0; e < entry_data.size(); ++e) {
+      uint32_t n = segments[e * column_count + column];
+      memcpy(out, entry_data[e], n);
+      entry_data[e] += n;
+      out           += n;
+    }
+  }
+
+  size_t bound = payload.size();
+#ifdef HAVE_ZSTD_H
+  bound = std::max(bound, ZSTD_compressBound(payload.size()));
+#endif
+
+  char        *block  = static_cast<char *>(ats_malloc(sizeof(BlockHeader) + schema_bytes + bound));
+  BlockHeader *bh     = reinterpret_cast<BlockHeader *>(block);
+  char        *stored = block + sizeof(BlockHeader) + schema_bytes;
+
+  bh->cookie       = COOKIE;
+  bh->version      = VERSION;
+  bh->codec        = CODEC_NONE;
+  bh->schema_bytes = schema_bytes;
+  bh->raw_bytes    = payload.size();
+  bh->stored_bytes = payload.size();
+  bh->entry_count  = header->entry_count;
+  bh->column_count = column_count;
+  memcpy(block + sizeof(BlockHeader), header, schema_bytes);
+  // anything past the last entry is not part of the log
+  reinterpret_cast<LogBufferHeader *>(block + sizeof(BlockHeader))->byte_count = schema_bytes + entry_bytes;
+
+#ifdef HAVE_ZSTD_H
+  thread_local CompressContext ctx;
+  if (ctx.cctx != nullptr) {
+    size_t n = ZSTD_compressCCtx(ctx.cctx, stored, bound, payload.data(), payload.size(), ZSTD_LEVEL);
+    if (!ZSTD_isError(n) && n < payload.size()) {
+      bh->codec        = CODEC_ZSTD;
+      bh->stored_bytes = n;
+    }
+  }
+#endif
+  if (bh->codec == CODEC_NONE) {
+    memcpy(stored, payload.data(), payload.size());
+  }
+
+  Dbg(dbg_ctl_log_columnar, "encoded %u entries of %u bytes in %u columns into %u bytes", bh->entry_count, header->byte_count,
+      column_count, bh->stored_bytes);
+
+  *len = sizeof(BlockHeader) + schema_bytes + bh->stored_bytes;
+  return block;
+}
+
+bool
+LogColumnar::decode(const BlockHeader &block, const char *body, std::vector<char> &buffer)
+{
+  if (block.cookie != COOKIE || block.version != VERSION || block.schema_bytes < sizeof(LogBufferHeader) ||
+      block.column_count == 0) {
+    return false;
+  }
+
+  LogBufferHeader header;
+  memcpy(&header, body, sizeof(header));
+  if (header.data_offset != block.schema_bytes || header.entry_count != block.entry_count ||
+      header.byte_count < block.schema_bytes || header.byte_count > MAX_BUFFER_BYTES || block.raw_bytes > MAX_BUFFER_BYTES) {
+    return false;
+  }
+
+  // Bound the counts by the sizes before anything is allocated for them. Every entry takes at least a varint for each
+  // part of its timestamp and for the length of each column in the payload, and its LogEntryHeader in the buffer. The
+  // columns are at most the fields of the field list in the schema.
+  uint64_t const min_payload_bytes = static_cast<uint64_t>(block.entry_count) * (2 + static_cast<uint64_t>(block.column_count));
+  uint64_t const min_data_bytes    = static_cast<uint64_t>(block.entry_count) * sizeof(LogEntryHeader);
+  if (min_payload_bytes > block.raw_bytes || min_data_bytes > header.byte_count - block.schema_bytes ||
+      block.column_count > block.schema_bytes) {
+    return false;
+  }
+
+  char const       *payload = body + block.schema_bytes;
+  std::vector<char> raw;
+  switch (block.codec) {
+  case CODEC_NONE:
+    if (block.stored_bytes != block.raw_bytes) {
+      return false;
+    }
+    break;
+  case CODEC_ZSTD:
+#ifdef HAVE_ZSTD_H
+    raw.resize(block.raw_bytes);
+    if (ZSTD_decompress(raw.data(), raw.size(), payload, block.stored_bytes) != block.raw_bytes) {
+      return false;
+    }
+    payload = raw.data();
+    break;
+#else
+    Note("Cannot decode a zstd compressed log block; zstd is not available");
+    return false;
+#endif
+  default:
+    return false;
+  }
+
+  char const *p   = payload;
+  char const *end = payload + block.raw_bytes;
+
+  std::vector<LogEntryHeader> entries(block.entry_count);
+  int64_t                     timestamp = 0;
+  for (auto &entry : entries) {
+    uint64_t delta, usec;
+    if (!get_varint(p, end, delta) || !get_varint(p, end, usec)) {
+      return false;
+    }
+    timestamp           += unzigzag(delta);
+    entry.timestamp      = timestamp;
+    entry.timestamp_usec = static_cast<int32_t>(unzigzag(usec));
+  }
+
+  size_t const          n_segments = static_cast<size_t>(block.entry_count) * block.column_count;
+  std::vector<uint32_t> segments(n_segments);
+  std::vector<size_t>   column_start(block.column_count + 1, 0);
+  for (size_t i = 0; i < n_segments; ++i) {
+    uint64_t n;
+    if (!get_varint(p, end, n) || n > block.raw_bytes) {
+      return false;
+    }
+    segments[i]                                = n;
+    column_start[i % block.column_count + 1]  += n;
+    entries[i / block.column_count].entry_len += n;
+  }
+  for (unsigned c = 0; c < block.column_count; ++c) {
+    column_start[c + 1] += column_start[c];
+  }
+  if (static_cast<size_t>(end - p) != column_start[block.column_count]) {
+    return false;
+  }
+
+  buffer.resize(header.byte_count);
+  memcpy(buffer.data(), body, block.schema_bytes);
+
+  size_t out = block.schema_bytes;
+  for (size_t e = 0; e < entries.size(); ++e) {
+    LogEntryHeader &entry  = entries[e];
+    entry.entry_len       += sizeof(LogEntryHeader);
+    if (entry.entry_len > buffer.size() - out) {
+      return false;
+    }
+    memcpy(buffer.data() + out, &entry, sizeof(entry));
+    out += sizeof(entry);
+    for (unsigned c = 0; c < block.column_count; ++c) {
+      uint32_t n = segments[e * block.column_count + c];
+      memcpy(buffer.data() + out, p + column_start[c], n);
+      column_start[c] += n;
+      out             += n;
+    }
+  }
+
+  return out == buffer.size();
+}
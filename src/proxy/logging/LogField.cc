@@ -621,6 +621,72 @@ LogField::unmarshal(char **buf, char *dest, int len, LogEscapeType escape_type)
     m_unmarshal_func);
 }
 
+/*-------------------------------------------------------------------------
+  LogField::marshaled_len
+
+  This routine returns the number of bytes the field takes up in a
+  marshaled entry, without unmarshalling it.  @a buf points at the field
+  and @a len is the number of bytes left in the entry.  Fields that cannot
+  be sized from their type alone are taken to be a single int.
+  -------------------------------------------------------------------------*/
+unsigned
+LogField::marshaled_len(const char *buf, unsigned len) const
+{
+  auto str_len = [&](const char *s, unsigned n) -> unsigned { return LogAccess::round_strlen(strnlen(s, n) + 1); };
+  auto ip_len  = [&]() -> unsigned {
+    LogFieldIp ip;
+    if (len < sizeof(ip)) {
+      return len;
+    }
+    memcpy(&ip, buf, sizeof(ip));
+    switch (ip._family) {
+    case AF_INET:
+      return INK_ALIGN_DEFAULT(sizeof(LogFieldIp4));
+    case AF_INET6:
+      return INK_ALIGN_DEFAULT(sizeof(LogFieldIp6));
+    case AF_UNIX:
+      return INK_ALIGN_DEFAULT(sizeof(LogFieldUn));
+    default:
+      return INK_ALIGN_DEFAULT(sizeof(LogFieldIp));
+    }
+  };
+  auto by_type = [&]() -> unsigned {
+    switch (m_type) {
+    case STRING:
+      return str_len(buf, len);
+    case IP:
+      return ip_len();
+    default:
+      return INK_MIN_ALIGN;
+    }
+  };
+
+  auto slice_len = [&](UnmarshalFuncWithSlice f) -> unsigned {
+    unsigned n = str_len(buf, len);
+    // the request line is the method, the URL and the version
+    if (f == &LogAccess::unmarshal_http_text && n < len) {
+      n += str_len(buf + n, len - n) + 2 * INK_MIN_ALIGN;
+    }
+    return n;
+  };
+  auto func_len = [&](UnmarshalFunc f) -> unsigned {
+    if (f == &LogAccess::unmarshal_ip_to_str || f == &LogAccess::unmarshal_ip_to_hex) {
+      return ip_len();
+    } else if (f == &LogAccess::unmarshal_http_version) {
+      return 2 * INK_MIN_ALIGN;
+    }
+    return by_type();
+  };
+
+  unsigned n = std::visit(swoc::meta::vary{[&](UnmarshalFuncWithSlice f) -> unsigned { return slice_len(f); },
+                                           [&](UnmarshalFuncWithMap) -> unsigned { return INK_MIN_ALIGN; },
+                                           [&](UnmarshalFunc f) -> unsigned { return func_len(f); },
+                                           [&](decltype(nullptr)) -> unsigned { return by_type(); }},
+                          m_unmarshal_func);
+
+  return std::min(n, len);
+}
+
 /*-------------------------------------------------------------------------
   LogField::display
   -------------------------------------------------------------------------*/
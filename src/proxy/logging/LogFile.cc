@@ -49,6 +49,7 @@
 #include "proxy/logging/LogFilter.h"
 #include "proxy/logging/LogFormat.h"
 #include "proxy/logging/LogBuffer.h"
+#include "proxy/logging/LogColumnar.h"
 #include "proxy/logging/LogFile.h"
 #include "proxy/logging/LogObject.h"
 #include "proxy/logging/LogUtils.h"
@@ -223,7 +224,7 @@ LogFile::open_file()
   // file.
   //
   if (!file_exists) {
-    if (m_file_format != LOG_FILE_BINARY && m_header && m_log) {
+    if ((m_file_format == LOG_FILE_ASCII || m_file_format == LOG_FILE_PIPE) && m_header && m_log) {
       Dbg(dbg_ctl_log_file, "writing header to LogFile %s", m_name);
       writeln(m_header, strlen(m_header), fileno(m_log->m_fp), m_name);
     }
@@ -482,6 +483,8 @@ LogFile::preproc_and_try_delete(LogBuffer *lb)
   } else if (m_file_format == LOG_FILE_ASCII || m_file_format == LOG_FILE_PIPE) {
     write_ascii_logbuffer3(buffer_header);
     ret = 0;
+  } else if (m_file_format == LOG_FILE_COLUMNAR) {
+    ret = write_columnar_logbuffer(lb);
   } else {
     Note("Cannot write LogBuffer to LogFile %s; invalid file format: %d", m_name, m_file_format);
   }
@@ -660,6 +663,40 @@ LogFile::write_ascii_logbuffer3(LogBufferHeader *buffer_header, const char *alt_
   return total_bytes;
 }
 
+/*-------------------------------------------------------------------------
+  LogFile::write_columnar_logbuffer
+
+  Encode the given LogBuffer as a columnar block and pass it to the flush
+  thread.  The entries are split into columns using the fields of the
+  format of the LogObject that owns the buffer.
+  -------------------------------------------------------------------------*/
+
+int
+LogFile::write_columnar_logbuffer(LogBuffer *lb)
+{
+  LogBufferHeader *buffer_header = lb->header();
+  LogObject       *owner         = lb->get_owner();
+  LogFieldList    *fields        = owner ? &owner->m_format->m_field_list : nullptr;
+  int              len           = 0;
+
+  char *block = LogColumnar::encode(buffer_header, fields, &len);
+  if (block == nullptr) {
+    Note("Cannot write LogBuffer to LogFile %s; columnar encoding failed", m_name);
+    return -1;
+  }
+
+  LogFlushData *flush_data = new LogFlushData(this, block, len);
+
+  Metrics::Counter::increment(log_rsb.num_flush_to_disk, buffer_header->entry_count);
+  Metrics::Counter::increment(log_rsb.bytes_flush_to_disk, len);
+
+  ink_atomiclist_push(Log::flush_data_list, flush_data);
+
+  Log::flush_notify->signal();
+
+  return 0;
+}
+
 bool
 LogFile::rolled_logfile(char *file)
 {
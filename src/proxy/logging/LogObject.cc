@@ -37,6 +37,7 @@
 #include "proxy/logging/Log.h"
 
 #include <algorithm>
+#include <atomic>
 #include <vector>
 #include <thread>
 #include <map>
@@ -126,6 +127,8 @@ LogObject::LogObject(LogConfig *cfg, const LogFormat *format, const char *log_di
     m_flags |= BINARY;
   } else if (file_format == LOG_FILE_PIPE) {
     m_flags |= WRITES_TO_PIPE;
+  } else if (file_format == LOG_FILE_COLUMNAR) {
+    m_flags |= COLUMNAR;
   }
 
   generate_filenames(log_dir, basename, file_format);
@@ -223,6 +226,10 @@ LogObject::generate_filenames(const char *log_dir, const char *basename, LogFile
       ext     = LOG_FILE_PIPE_OBJECT_FILENAME_EXTENSION;
       ext_len = 5;
       break;
+    case LOG_FILE_COLUMNAR:
+      ext     = LOG_FILE_COLUMNAR_OBJECT_FILENAME_EXTENSION;
+      ext_len = 5;
+      break;
     default:
       ink_assert(!"unknown file format");
     }
@@ -288,8 +295,11 @@ LogObject::compute_signature(LogFormat *format, char *filename, unsigned int fla
     int   buf_size = strlen(fl) + strlen(ps) + strlen(filename) + 2;
     char *buffer   = static_cast<char *>(ats_malloc(buf_size));
 
-    ink_string_concatenate_strings(buffer, fl, ps, filename,
-                                   flags & LogObject::BINARY ? "B" : (flags & LogObject::WRITES_TO_PIPE ? "P" : "A"), NULL);
+    const char *mode = flags & LogObject::BINARY         ? "B" :
+                       flags & LogObject::COLUMNAR       ? "C" :
+                       flags & LogObject::WRITES_TO_PIPE ? "P" :
+                                                           "A";
+    ink_string_concatenate_strings(buffer, fl, ps, filename, mode, NULL);
 
     CryptoHash hash;
     CryptoContext().hash_immediate(hash, buffer, buf_size - 1);
@@ -489,14 +499,30 @@ LogObject::log(LogAccess *lad, const char *text_entry)
   return this->log(lad, std::string_view{text_entry ? text_entry : ""});
 }
 
+/*
+ * In 'fast' mode every thread stages its own LogBuffer for each LogObject, so the threads never share a buffer. Full
+ * buffers are kept on a per thread LogBufferList and handed to the preproc thread in batches. All of the buffers of a
+ * thread go to the same preproc thread, which keeps the entries of each thread in order.
+ */
 class ThreadLocalLogBufferManager : public Continuation
 {
 public:
   static LogBuffer *thread_local_buffer(LogObject *o, size_t *offset, size_t bytes_needed);
 
 private:
+  // Number of full buffers staged before they are handed to the preproc thread.
+  static constexpr int STAGING_BATCH_SIZE = 4;
+
+  struct Staging {
+    LogBuffer    *current = nullptr;
+    LogBufferList full;
+  };
+
   ThreadLocalLogBufferManager()
   {
+    static std::atomic<unsigned> next_preproc_idx{0};
+    preproc_idx = next_preproc_idx++;
+
     this->thread_affinity = this_ethread();
     SET_HANDLER(&ThreadLocalLogBufferManager::wakeup);
 
@@ -512,10 +538,13 @@ private:
   {
     Dbg(dbg_ctl_log_config, "thread local buffer manager destructor");
     // only the LogBuffer objects are owned by this
-    for (auto [o, b] : current_buffers) {
+    for (auto &[o, staging] : current_buffers) {
       // ideally we flush these here but there are shutdown order issues so if the
-      // logbuffer still exists at this point we have to drop it
-      delete b;
+      // logbuffer still exists at this point we have to drop it, along with the staged ones
+      delete staging.current;
+      while (LogBuffer *buffer = staging.full.get()) {
+        delete buffer;
+      }
     }
     current_buffers.clear();
   }
@@ -523,10 +552,13 @@ private:
   int
   wakeup(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
   {
-    for (auto &[o, b] : current_buffers) {
-      if (b && ink_hrtime_to_sec(ink_get_hrtime()) > b->expiration_time()) {
-        o->flush_buffer(b);
-        b = nullptr;
+    for (auto &[o, staging] : current_buffers) {
+      if (staging.current && ink_hrtime_to_sec(ink_get_hrtime()) > staging.current->expiration_time()) {
+        staging.full.add(staging.current);
+        staging.current = nullptr;
+      }
+      if (staging.full.get_size() > 0) {
+        o->flush_buffers(staging.full, preproc_idx);
       }
     }
 
@@ -536,24 +568,26 @@ private:
   LogBuffer *
   current_buffer(LogObject *o, size_t *offset, size_t bytes_needed)
   {
-    LogBuffer *buffer = current_buffers[o];
-    if (buffer == nullptr) {
-      buffer             = new LogBuffer(Log::config, o, Log::config->log_buffer_size);
-      current_buffers[o] = buffer;
+    Staging &staging = current_buffers[o];
+    if (staging.current == nullptr) {
+      staging.current = new LogBuffer(Log::config, o, Log::config->log_buffer_size);
     }
-    if (buffer->fast_write(offset, bytes_needed) != LogBuffer::LB_OK) {
-      o->flush_buffer(buffer);
+    if (staging.current->fast_write(offset, bytes_needed) != LogBuffer::LB_OK) {
+      staging.full.add(staging.current);
+      if (staging.full.get_size() >= STAGING_BATCH_SIZE) {
+        o->flush_buffers(staging.full, preproc_idx);
+      }
 
-      buffer             = new LogBuffer(Log::config, o, Log::config->log_buffer_size);
-      current_buffers[o] = buffer;
-      if (buffer->fast_write(offset, bytes_needed) != LogBuffer::LB_OK) {
+      staging.current = new LogBuffer(Log::config, o, Log::config->log_buffer_size);
+      if (staging.current->fast_write(offset, bytes_needed) != LogBuffer::LB_OK) {
         return nullptr;
       }
     };
-    return buffer;
+    return staging.current;
   }
 
-  std::map<LogObject *, LogBuffer *> current_buffers;
+  std::map<LogObject *, Staging> current_buffers;
+  unsigned                       preproc_idx = 0; ///< Selects the preproc thread for the buffers of this thread.
 };
 
 /*
@@ -568,12 +602,20 @@ ThreadLocalLogBufferManager::thread_local_buffer(LogObject *o, size_t *offset, s
 }
 
 void
-LogObject::flush_buffer(LogBuffer *buffer)
+LogObject::flush_buffers(LogBufferList &buffers, unsigned preproc_idx)
 {
-  int idx = m_buffer_manager_idx++ % m_flush_threads;
-  Dbg(dbg_ctl_log_logbuffer, "adding buffer %d to flush list after checkout", buffer->get_id());
-  m_buffer_manager[idx].add_to_flush_queue(buffer);
-  Log::preproc_notify[idx].signal();
+  int        idx = preproc_idx % m_flush_threads;
+  int        n   = 0;
+  LogBuffer *buffer;
+
+  while ((buffer = buffers.get()) != nullptr) {
+    m_buffer_manager[idx].add_to_flush_queue(buffer);
+    ++n;
+  }
+  if (n > 0) {
+    Dbg(dbg_ctl_log_logbuffer, "adding %d staged buffers to flush list %d", n, idx);
+    Log::preproc_notify[idx].signal();
+  }
 }
 
 int
@@ -53,12 +53,13 @@ benchmark_LogObject_LDADD = \
 #include "proxy/logging/LogConfig.h"
 #include "proxy/logging/Log.h"
 #include "proxy/shared/DiagsConfig.h"
-#include "records/RecLocal.h"
+#include "iocore/eventsystem/RecProcess.h"
 #include "tscore/Layout.h"
 
 #include <thread>
 #include <condition_variable>
 #include <chrono>
+#include <string>
 
 static char bind_stdout[512] = "";
 static char bind_stderr[512] = "";
@@ -109,8 +110,6 @@ TEST_CASE("LogObject", "[proxy/logging]")
   stacksize = RecGetRecordInt("proxy.config.thread.default.stacksize").value_or(0);
   eventProcessor.start(10, stacksize);
 
-  pmgmt = new ProcessManager(false);
-
   Log::init();
 
   LogFormat *fmt = MakeTextLogFormat();
@@ -128,66 +127,47 @@ TEST_CASE("LogObject", "[proxy/logging]")
   Log::config->log_object_manager.manage_object(slowo);
   Log::config->log_object_manager.manage_object(fasto);
 
-  BENCHMARK("logobject fast")
-  {
-    int             thread_cnt = 40;
+  REQUIRE(fasto->writes_to_disk());
+  REQUIRE(!fasto->writes_to_pipe());
+  REQUIRE(slowo->writes_to_disk());
+  REQUIRE(!slowo->writes_to_pipe());
+
+  // The same number of entries are logged whatever the thread count, so the times compare throughput.
+  auto run_threads = [&](LogObject *o, int thread_cnt, std::string_view logline) {
     notstd::barrier barrier(thread_cnt);
-    auto            test_object = [&](LogObject *o) {
+    int const       per_thread  = Log::config->log_buffer_size * 1000 / thread_cnt;
+    auto            test_object = [&]() {
       Thread *me = new EThread;
       me->set_specific();
       barrier.arrive_and_wait();
 
-      std::string_view logline = "012345678901234567890123456789012345678901234567890";
-      int              total   = 0;
-      while (total < Log::config->log_buffer_size * 100) {
+      int total = 0;
+      while (total < per_thread) {
         o->log(nullptr, logline);
         total += logline.size();
       }
     };
 
-    REQUIRE(fasto->writes_to_disk());
-    REQUIRE(!fasto->writes_to_pipe());
-
     std::vector<std::thread> threads;
     threads.reserve(thread_cnt);
 
     for (int i = 0; i < thread_cnt; ++i) {
-      threads.emplace_back(test_object, fasto);
+      threads.emplace_back(test_object);
     }
     for (int i = 0; i < thread_cnt; ++i) {
       threads[i].join();
     }
   };
 
-  BENCHMARK("logobject slow")
-  {
-    int             thread_cnt = 40;
-    notstd::barrier barrier(thread_cnt);
-
-    auto test_object = [&](LogObject *o) {
-      Thread *me = new EThread;
-      me->set_specific();
-      barrier.arrive_and_wait();
-
-      std::string_view logline = "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvw";
-      int              total   = 0;
-      while (total < Log::config->log_buffer_size * 100) {
-        o->log(nullptr, logline);
-        total += logline.size();
-      }
+  for (int thread_cnt : {1, 2, 4, 8, 16, 32, 64}) {
+    BENCHMARK("logobject fast, " + std::to_string(thread_cnt) + " threads")
+    {
+      run_threads(fasto, thread_cnt, "012345678901234567890123456789012345678901234567890");
     };
 
-    REQUIRE(slowo->writes_to_disk());
-    REQUIRE(!slowo->writes_to_pipe());
-
-    std::vector<std::thread> threads;
-    threads.reserve(thread_cnt);
-
-    for (int i = 0; i < thread_cnt; ++i) {
-      threads.emplace_back(test_object, slowo);
-    }
-    for (int i = 0; i < thread_cnt; ++i) {
-      threads[i].join();
-    }
-  };
+    BENCHMARK("logobject slow, " + std::to_string(thread_cnt) + " threads")
+    {
+      run_threads(slowo, thread_cnt, "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvw");
+    };
+  }
 }
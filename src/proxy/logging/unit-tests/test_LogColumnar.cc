@@ -0,0 +1,186 @@
+/** @file
+
+  Catch-based tests for LogColumnar.h.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "tscore/ink_align.h"
+#include "tscore/ink_memory.h"
+
+#include "proxy/logging/LogAccess.h"
+#include "proxy/logging/LogBuffer.h"
+#include "proxy/logging/LogColumnar.h"
+#include "proxy/logging/LogField.h"
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+namespace
+{
+// Lay down a LogBuffer the way LogBuffer does, with entries of "cqhm chi pssc".
+struct TestBuffer {
+  std::vector<char> bytes;
+
+  TestBuffer()
+  {
+    bytes.resize(sizeof(LogBufferHeader));
+    add_string("squid");
+    fieldlist_offset = bytes.size();
+    add_string("cqhm,chi,pssc");
+    data_offset = bytes.size();
+  }
+
+  void
+  add_string(const char *s)
+  {
+    size_t n = INK_ALIGN_DEFAULT(strlen(s) + 1);
+    size_t at = bytes.size();
+    bytes.resize(at + n, 0);
+    memcpy(bytes.data() + at, s, strlen(s));
+  }
+
+  void
+  add_entry(int64_t timestamp, const char *method, uint32_t addr, int64_t status)
+  {
+    size_t at = bytes.size();
+
+    bytes.resize(at + sizeof(LogEntryHeader));
+    add_string(method);
+
+    LogFieldIp4 ip;
+    memset(&ip, 0, sizeof(ip));
+    ip._family = AF_INET;
+    ip._addr   = addr;
+    size_t ip_at = bytes.size();
+    bytes.resize(ip_at + INK_ALIGN_DEFAULT(sizeof(ip)), 0);
+    memcpy(bytes.data() + ip_at, &ip, sizeof(ip));
+
+    size_t int_at = bytes.size();
+    bytes.resize(int_at + INK_MIN_ALIGN, 0);
+    memcpy(bytes.data() + int_at, &status, sizeof(status));
+
+    LogEntryHeader entry;
+    entry.timestamp      = timestamp;
+    entry.timestamp_usec = timestamp % 1000000;
+    entry.entry_len      = bytes.size() - at;
+    memcpy(bytes.data() + at, &entry, sizeof(entry));
+    ++entry_count;
+  }
+
+  LogBufferHeader *
+  header()
+  {
+    LogBufferHeader *h = reinterpret_cast<LogBufferHeader *>(bytes.data());
+    memset(h, 0, sizeof(*h));
+    h->cookie               = LOG_SEGMENT_COOKIE;
+    h->version              = LOG_SEGMENT_VERSION;
+    h->byte_count           = bytes.size();
+    h->entry_count          = entry_count;
+    h->fmt_name_offset      = sizeof(LogBufferHeader);
+    h->fmt_fieldlist_offset = fieldlist_offset;
+    h->data_offset          = data_offset;
+    return h;
+  }
+
+  size_t   fieldlist_offset = 0;
+  size_t   data_offset      = 0;
+  uint32_t entry_count      = 0;
+};
+
+void
+round_trip(TestBuffer &tb, LogFieldList *fields)
+{
+  LogBufferHeader *header = tb.header();
+  int              len    = 0;
+  char            *block  = LogColumnar::encode(header, fields, &len);
+  REQUIRE(block != nullptr);
+
+  LogColumnar::BlockHeader bh;
+  memcpy(&bh, block, sizeof(bh));
+  REQUIRE(len == static_cast<int>(sizeof(bh) + LogColumnar::body_bytes(bh)));
+  CHECK(bh.entry_count == tb.entry_count);
+
+  std::vector<char> decoded;
+  REQUIRE(LogColumnar::decode(bh, block + sizeof(bh), decoded));
+  CHECK(decoded == tb.bytes);
+
+  // a damaged block is refused
+  bh.raw_bytes += 1;
+  CHECK_FALSE(LogColumnar::decode(bh, block + sizeof(bh), decoded));
+  bh.raw_bytes -= 1;
+
+  // so are counts the block cannot hold, before anything is allocated for them
+  LogBufferHeader *schema = reinterpret_cast<LogBufferHeader *>(block + sizeof(bh));
+  bh.entry_count          = schema->entry_count = UINT32_MAX;
+  CHECK_FALSE(LogColumnar::decode(bh, block + sizeof(bh), decoded));
+  bh.entry_count = schema->entry_count = tb.entry_count;
+  bh.column_count                      = UINT32_MAX;
+  CHECK_FALSE(LogColumnar::decode(bh, block + sizeof(bh), decoded));
+
+  ats_free(block);
+}
+
+} // end anonymous namespace
+
+TEST_CASE("LogColumnar round trip", "[logging]")
+{
+  LogFieldList fields;
+  fields.add(new LogField("cqhm", "cqhm", LogField::STRING, &LogAccess::marshal_client_req_http_method, &LogAccess::unmarshal_str),
+             false);
+  fields.add(new LogField("chi", "chi", LogField::IP, &LogAccess::marshal_client_host_ip, &LogAccess::unmarshal_ip_to_str), false);
+  fields.add(new LogField("pssc", "pssc", LogField::sINT, &LogAccess::marshal_proxy_resp_status_code,
+                          &LogAccess::unmarshal_int_to_str),
+             false);
+
+  TestBuffer tb;
+  for (int i = 0; i < 200; ++i) {
+    tb.add_entry(1700000000 + i / 7, i % 3 ? "GET" : "PROPFIND", htonl(0x0a000000 + i), 200 + (i % 5));
+  }
+
+  SECTION("split by field")
+  {
+    round_trip(tb, &fields);
+  }
+  SECTION("one column")
+  {
+    round_trip(tb, nullptr);
+  }
+  SECTION("fields that do not match the data")
+  {
+    LogFieldList wrong;
+    wrong.add(new LogField("chi", "chi", LogField::IP, &LogAccess::marshal_client_host_ip, &LogAccess::unmarshal_ip_to_str),
+              false);
+    wrong.add(new LogField("cqhm", "cqhm", LogField::STRING, &LogAccess::marshal_client_req_http_method,
+                           &LogAccess::unmarshal_str),
+              false);
+    round_trip(tb, &wrong);
+  }
+}
+
+TEST_CASE("LogColumnar single entry", "[logging]")
+{
+  TestBuffer tb;
+  tb.add_entry(-5, "", 0, -1);
+  round_trip(tb, nullptr);
+}
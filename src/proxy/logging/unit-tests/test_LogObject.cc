@@ -0,0 +1,162 @@
+/** @file
+
+  Catch-based tests for the thread local buffers of fast LogObjects.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "proxy/logging/Log.h"
+#include "proxy/logging/LogConfig.h"
+#include "proxy/logging/LogObject.h"
+#include "proxy/shared/DiagsConfig.h"
+#include "iocore/eventsystem/EventSystem.h"
+#include "iocore/eventsystem/RecProcess.h"
+#include "tscore/Layout.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+namespace
+{
+constexpr int LOGGING_THREADS = 2;
+
+// Enough entries that every thread fills many batches of staged buffers.
+constexpr int ENTRIES_PER_THREAD = 20000;
+
+/// Logs numbered entries to a fast LogObject from the event thread it is scheduled on.
+struct Logger : Continuation {
+  LogObject        *object;
+  int               id;
+  int               failed = 0;
+  std::atomic<int> &done;
+
+  Logger(LogObject *object, int id, std::atomic<int> &done)
+    : Continuation(new_ProxyMutex()), object(object), id(id), done(done)
+  {
+    SET_HANDLER(&Logger::handle_event);
+  }
+
+  int
+  handle_event(int /* event ATS_UNUSED */, void * /* data ATS_UNUSED */)
+  {
+    char entry[64];
+    for (int i = 0; i < ENTRIES_PER_THREAD; ++i) {
+      int n = snprintf(entry, sizeof(entry), "logger %d entry %d", id, i);
+      if (object->log(nullptr, std::string_view{entry, static_cast<size_t>(n)}) != Log::LOG_OK) {
+        ++failed;
+      }
+    }
+    ++done;
+    return EVENT_DONE;
+  }
+};
+
+std::string
+temp_dir()
+{
+  char        buffer[PATH_MAX];
+  const char *tmpdir = getenv("TMPDIR");
+  snprintf(buffer, sizeof(buffer), "%s/test_LogObject.XXXXXX", tmpdir ? tmpdir : "/tmp");
+  REQUIRE(mkdtemp(buffer) != nullptr);
+  return buffer;
+}
+
+/// The entries of each logger found in @a path, in the order they were written.
+std::vector<std::vector<int>>
+read_entries(const char *path)
+{
+  std::vector<std::vector<int>> entries(LOGGING_THREADS);
+  std::ifstream                 file(path);
+  std::string                   line;
+  int                           id, i;
+
+  while (std::getline(file, line)) {
+    if (sscanf(line.c_str(), "logger %d entry %d", &id, &i) == 2 && 0 <= id && id < LOGGING_THREADS) {
+      entries[id].push_back(i);
+    }
+  }
+  return entries;
+}
+
+} // end anonymous namespace
+
+TEST_CASE("LogObject fast buffers", "[proxy/logging]")
+{
+  ink_freelist_init_ops(true, true);
+  init_buffer_allocators(0);
+
+  Thread *main_thread = new EThread;
+  main_thread->set_specific();
+
+  new DiagsConfig("Server", "diags.log", "", "", false);
+  Layout::create(temp_dir());
+  RecProcessInit();
+  eventProcessor.start(LOGGING_THREADS);
+
+  Log::init();
+  // Idle buffers are handed over after this long, so the last partly filled buffer of each thread is written too.
+  Log::config->max_secs_per_buffer = 1;
+
+  LogFormat *fmt = MakeTextLogFormat();
+  Log::config->format_list.add(fmt, false);
+
+  std::string dir = temp_dir();
+  LogObject  *o   = new LogObject(Log::config, fmt, dir.c_str(), "fast", LOG_FILE_ASCII, nullptr, Log::NO_ROLLING, 1, 0, 0, 0,
+                                  false, 0, 0, false, 0, true);
+  Log::config->log_object_manager.manage_object(o);
+
+  // Every thread hands its full buffers over in batches, which must reach the file in the order the thread filled them.
+  std::atomic<int>                     done{0};
+  std::vector<std::unique_ptr<Logger>> loggers;
+  for (int i = 0; i < LOGGING_THREADS; ++i) {
+    loggers.push_back(std::make_unique<Logger>(o, i, done));
+    eventProcessor.thread_group[ET_CALL]._thread[i]->schedule_imm(loggers.back().get());
+  }
+
+  std::vector<std::vector<int>> entries;
+  auto                          deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  for (bool complete = false; !complete && std::chrono::steady_clock::now() < deadline;) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    entries  = read_entries(o->get_full_filename());
+    complete = done == LOGGING_THREADS;
+    for (auto const &e : entries) {
+      complete = complete && e.size() == ENTRIES_PER_THREAD;
+    }
+  }
+
+  for (auto const &logger : loggers) {
+    CHECK(logger->failed == 0);
+  }
+  for (auto const &e : entries) {
+    REQUIRE(e.size() == ENTRIES_PER_THREAD);
+    for (int i = 0; i < ENTRIES_PER_THREAD; ++i) {
+      REQUIRE(e[i] == i);
+    }
+  }
+}
@@ -0,0 +1,345 @@
+/** @file
+
+    Unit tests for the RFC 9218 priority parsing and scheduling
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "proxy/ExtensiblePriority.h"
+
+using namespace ExtensiblePriority;
+
+namespace
+{
+Priority
+parsed(std::string_view value)
+{
+  Priority priority;
+  REQUIRE(parse(value, priority));
+  return priority;
+}
+
+// A response being sent, the scheduler picks one frame of it at a time.
+struct Response {
+  std::string name;
+  uint32_t    id;
+  Priority    priority;
+  size_t      size;
+  size_t      sent = 0;
+  Node       *node = nullptr;
+};
+
+constexpr size_t FRAME_SIZE = 16384;
+
+/** Send the responses frame by frame, as Http2ConnectionState does, starting each one after the frame
+ * number in @a start.
+ *
+ * @return The name of the response of every frame.
+ */
+std::vector<std::string>
+simulate(Scheduler &scheduler, std::vector<Response> &responses, std::vector<size_t> const &start)
+{
+  std::vector<std::string> frames;
+  for (auto &r : responses) {
+    r.node = scheduler.add(r.id, r.priority, &r);
+  }
+  for (size_t frame = 0;; ++frame) {
+    for (size_t i = 0; i < responses.size(); ++i) {
+      if (start[i] == frame) {
+        scheduler.activate(responses[i].node);
+      }
+    }
+    Node *node = scheduler.top();
+    if (node == nullptr) {
+      if (std::all_of(start.begin(), start.end(), [&](size_t s) { return s <= frame; })) {
+        break;
+      }
+      continue;
+    }
+    Response *r   = static_cast<Response *>(node->t);
+    size_t    len = std::min(FRAME_SIZE, r->size - r->sent);
+    r->sent      += len;
+    frames.push_back(r->name);
+    if (r->sent == r->size) {
+      scheduler.deactivate(node, len);
+    } else {
+      scheduler.update(node, len);
+    }
+  }
+  for (auto &r : responses) {
+    scheduler.remove(r.node);
+  }
+  REQUIRE(scheduler.size() == 0);
+  return frames;
+}
+
+size_t
+first_frame(std::vector<std::string> const &frames, std::string const &name)
+{
+  return std::find(frames.begin(), frames.end(), name) - frames.begin();
+}
+
+size_t
+last_frame(std::vector<std::string> const &frames, std::string const &name)
+{
+  return frames.rend() - std::find(frames.rbegin(), frames.rend(), name) - 1;
+}
+
+} // end anonymous namespace
+
+TEST_CASE("ExtensiblePriority parse", "[proxy][ExtensiblePriority]")
+{
+  SECTION("defaults")
+  {
+    Priority priority = parsed("");
+    REQUIRE(priority.urgency == DEFAULT_URGENCY);
+    REQUIRE(priority.incremental == false);
+  }
+
+  SECTION("urgency and incremental")
+  {
+    REQUIRE(parsed("u=0") == Priority{0, false});
+    REQUIRE(parsed("u=7, i") == Priority{7, true});
+    REQUIRE(parsed("i=?1,u=5") == Priority{5, true});
+    REQUIRE(parsed("i=?0") == Priority{DEFAULT_URGENCY, false});
+    REQUIRE(parsed("u=1, u=4") == Priority{4, false});
+    REQUIRE(parsed("  u=2 ,\ti") == Priority{2, true});
+  }
+
+  SECTION("ignored values")
+  {
+    // Out of range, or of the wrong type
+    REQUIRE(parsed("u=8") == Priority{});
+    REQUIRE(parsed("u=-1") == Priority{});
+    REQUIRE(parsed("u=1.5") == Priority{});
+    REQUIRE(parsed("u=?1, i=2") == Priority{});
+    REQUIRE(parsed("u=\"1\", i=tok") == Priority{});
+    // Other members and parameters
+    REQUIRE(parsed("foo=bar, u=1;x=2, i;y, b=:AQID:, l=(1 \"a\" b);z") == Priority{1, true});
+    REQUIRE(parsed("s=\"a \\\" b, u=0\", u=6") == Priority{6, false});
+  }
+
+  SECTION("invalid")
+  {
+    for (auto value : {"u=", "U=1", "u=1,", "u=1 i", ",u=1", "u=\"1", "l=(1 2", "u=1;", "1=u"}) {
+      Priority priority{1, true};
+      REQUIRE(parse(value, priority) == false);
+      // Left as it was
+      REQUIRE(priority == Priority{1, true});
+    }
+  }
+
+  SECTION("updates what is present")
+  {
+    Priority priority{1, true};
+    REQUIRE(parse("u=5", priority));
+    REQUIRE(priority == Priority{5, true});
+  }
+}
+
+TEST_CASE("ExtensiblePriority scheduler", "[proxy][ExtensiblePriority]")
+{
+  Scheduler scheduler;
+  int       a, b, c, d;
+
+  Node *na = scheduler.add(1, Priority{3, false}, &a);
+  Node *nb = scheduler.add(3, Priority{3, true}, &b);
+  Node *nc = scheduler.add(5, Priority{1, false}, &c);
+  Node *nd = scheduler.add(7, Priority{3, true}, &d);
+  REQUIRE(scheduler.size() == 4);
+  REQUIRE(scheduler.top() == nullptr);
+
+  SECTION("urgency first, then non-incremental")
+  {
+    scheduler.activate(nd);
+    scheduler.activate(nb);
+    REQUIRE(scheduler.top() == nd);
+    scheduler.activate(na);
+    REQUIRE(scheduler.top() == na);
+    scheduler.activate(nc);
+    REQUIRE(scheduler.top() == nc);
+
+    scheduler.deactivate(nc, 0);
+    REQUIRE(scheduler.top() == na);
+    // A non-incremental response keeps going
+    scheduler.update(na, FRAME_SIZE);
+    REQUIRE(scheduler.top() == na);
+    scheduler.deactivate(na, 0);
+
+    // Incremental ones take turns
+    REQUIRE(scheduler.top() == nd);
+    scheduler.update(nd, FRAME_SIZE);
+    REQUIRE(scheduler.top() == nb);
+    scheduler.update(nb, FRAME_SIZE);
+    REQUIRE(scheduler.top() == nd);
+  }
+
+  SECTION("non-incremental in id order")
+  {
+    Node *ne = scheduler.add(9, Priority{3, false}, nullptr);
+    scheduler.activate(ne);
+    scheduler.activate(na);
+    REQUIRE(scheduler.top() == na);
+    scheduler.activate(na);
+    scheduler.deactivate(na, 0);
+    REQUIRE(scheduler.top() == ne);
+    scheduler.remove(ne);
+    REQUIRE(scheduler.top() == nullptr);
+  }
+
+  SECTION("reprioritize")
+  {
+    scheduler.activate(na);
+    scheduler.activate(nb);
+    REQUIRE(scheduler.top() == na);
+    scheduler.reprioritize(nb, Priority{0, true});
+    REQUIRE(scheduler.top() == nb);
+    // Inactive nodes keep the new priority for later
+    scheduler.reprioritize(nc, Priority{7, false});
+    scheduler.activate(nc);
+    scheduler.deactivate(nb, 0);
+    REQUIRE(scheduler.top() == na);
+    scheduler.deactivate(na, 0);
+    REQUIRE(scheduler.top() == nc);
+  }
+
+  SECTION("remove an active node")
+  {
+    scheduler.activate(na);
+    scheduler.activate(nb);
+    scheduler.remove(na);
+    na = nullptr;
+    REQUIRE(scheduler.top() == nb);
+    REQUIRE(scheduler.size() == 3);
+  }
+
+  for (Node *node : {na, nb, nc, nd}) {
+    if (node) {
+      scheduler.remove(node);
+    }
+  }
+  REQUIRE(scheduler.size() == 0);
+}
+
+TEST_CASE("ExtensiblePriority pending updates", "[proxy][ExtensiblePriority]")
+{
+  PendingUpdates pending;
+  Priority       priority;
+
+  SECTION("applied when the stream opens")
+  {
+    REQUIRE(pending.add(5, Priority{1, true}, 10));
+    REQUIRE(pending.size() == 1);
+    REQUIRE_FALSE(pending.take(3, priority));
+    REQUIRE(pending.size() == 1);
+    REQUIRE(pending.take(5, priority));
+    CHECK(priority == Priority{1, true});
+    REQUIRE(pending.size() == 0);
+    REQUIRE_FALSE(pending.take(5, priority));
+  }
+
+  SECTION("the last update wins")
+  {
+    REQUIRE(pending.add(5, Priority{1, true}, 1));
+    REQUIRE(pending.add(5, Priority{6, false}, 1));
+    REQUIRE(pending.take(5, priority));
+    CHECK(priority == Priority{6, false});
+  }
+
+  SECTION("streams skipped by a higher one are forgotten")
+  {
+    REQUIRE(pending.add(3, Priority{1, false}, 10));
+    REQUIRE(pending.add(5, Priority{2, false}, 10));
+    REQUIRE(pending.add(9, Priority{4, false}, 10));
+    REQUIRE(pending.take(5, priority));
+    CHECK(priority.urgency == 2);
+    REQUIRE(pending.size() == 1);
+    REQUIRE_FALSE(pending.take(7, priority));
+    REQUIRE(pending.take(9, priority));
+    CHECK(priority.urgency == 4);
+  }
+
+  SECTION("limited")
+  {
+    REQUIRE(pending.add(1, Priority{}, 2));
+    REQUIRE(pending.add(3, Priority{}, 2));
+    REQUIRE_FALSE(pending.add(5, Priority{}, 2));
+    // A stream that already has an update may change it
+    REQUIRE(pending.add(3, Priority{0, false}, 2));
+    REQUIRE(pending.size() == 2);
+    pending.clear();
+    REQUIRE(pending.size() == 0);
+  }
+}
+
+TEST_CASE("ExtensiblePriority page load", "[proxy][ExtensiblePriority]")
+{
+  // Priorities as a browser sends them: the document and style sheets first, then scripts, and images incrementally.
+  Scheduler             scheduler;
+  std::vector<Response> responses = {
+    {"html",  1,  parsed("u=0"),      60000 },
+    {"img1",  3,  parsed("u=5, i"),   400000},
+    {"img2",  5,  parsed("u=5, i"),   250000},
+    {"css",   7,  parsed("u=0"),      90000 },
+    {"js",    9,  parsed("u=1"),      150000},
+    {"img3",  11, parsed("u=5, i"),   300000},
+    {"font",  13, parsed("u=2"),      40000 },
+    {"track", 15, parsed("u=6, i=?1"), 20000 },
+  };
+  // The images are requested before the style sheet and the script.
+  std::vector<size_t>      start  = {0, 1, 1, 6, 6, 8, 10, 0};
+  std::vector<std::string> frames = simulate(scheduler, responses, start);
+
+  for (auto const &r : responses) {
+    REQUIRE(r.sent == r.size);
+  }
+
+  // Nothing of lower urgency is sent while a render blocking response has data to send.
+  size_t const css_end = last_frame(frames, "css");
+  size_t const js_end  = last_frame(frames, "js");
+  for (auto img : {"img1", "img2", "img3"}) {
+    for (size_t f = start[3]; f <= js_end; ++f) {
+      REQUIRE(frames[f] != img);
+    }
+  }
+  REQUIRE(css_end < first_frame(frames, "js"));
+  REQUIRE(js_end < first_frame(frames, "font"));
+  REQUIRE(last_frame(frames, "html") < start[3]);
+  // The style sheet is not interleaved with anything
+  REQUIRE(css_end - first_frame(frames, "css") + 1 == (responses[3].size + FRAME_SIZE - 1) / FRAME_SIZE);
+
+  // Once all of them are sending, and until one is done, the images share the connection frame by frame.
+  std::vector<size_t> sent(3);
+  for (size_t f = first_frame(frames, "img3"); f < last_frame(frames, "img2"); ++f) {
+    REQUIRE(frames[f].rfind("img", 0) == 0);
+    ++sent[frames[f][3] - '1'];
+    auto [lo, hi] = std::minmax_element(sent.begin(), sent.end());
+    REQUIRE(*hi - *lo <= 1);
+  }
+  REQUIRE(sent[1] > 4);
+
+  // The least urgent response goes last.
+  REQUIRE(first_frame(frames, "track") > last_frame(frames, "img1"));
+}
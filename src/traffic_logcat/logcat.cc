@@ -31,6 +31,8 @@
 #define MAX_LOGBUFFER_SIZE 524288 // 512KB
 
 #include <poll.h>
+#include <string>
+#include <vector>
 
 #include "../proxy/logging/LogStandalone.cc"
 
@@ -42,6 +44,7 @@
 #include "proxy/logging/LogObject.h"
 #include "proxy/logging/LogConfig.h"
 #include "proxy/logging/LogBuffer.h"
+#include "proxy/logging/LogColumnar.h"
 #include "proxy/logging/LogUtils.h"
 #include "proxy/logging/Log.h"
 
@@ -54,6 +57,7 @@ int  follow_flag             = 0;
 int  clf_flag                = 0;
 int  elf_flag                = 0;
 int  elf2_flag               = 0;
+int  json_flag               = 0;
 int  auto_filenames          = 0;
 int  overwrite_existing_file = 0;
 char output_file[1024];
@@ -69,6 +73,7 @@ const ArgumentDescription argument_descriptions[] = {
   {"debug_tags",       'T', "Colon-Separated Debug Tags",          "S1023", error_tags,               NULL, NULL},
   {"overwrite_output", 'w', "Overwrite existing output file(s)",   "T",     &overwrite_existing_file, NULL, NULL},
   {"elf2",             '2', "Convert to Extended2 Logging Format", "T",     &elf2_flag,               NULL, NULL},
+  {"json",             'j', "Convert to JSON, one entry per line", "T",     &json_flag,               NULL, NULL},
   HELP_ARGUMENT_DESCRIPTION(),
   VERSION_ARGUMENT_DESCRIPTION(),
   RUNROOT_ARGUMENT_DESCRIPTION()
@@ -120,6 +125,128 @@ follow_rotate(const char *input_file, ino_t old_inode_num)
   }
 }
 
+/*
+ * Reads exactly @a n bytes, waiting for more data when following a file
+ *
+ * @returns true if all of the bytes were read
+ */
+bool
+read_fully(int fd, char *buf, size_t n)
+{
+  size_t nread = 0;
+  while (nread < n) {
+    auto rc = read(fd, buf + nread, n - nread);
+    if (rc < 0 || (rc == 0 && !follow_flag)) {
+      return false;
+    }
+    if (rc == 0) {
+      usleep(10000);
+    }
+    nread += rc;
+  }
+  return true;
+}
+
+/*
+ * Writes each entry of a LogBuffer as a JSON object keyed by field symbol
+ *
+ * @returns the number of bytes written
+ */
+int
+write_json_logbuffer(LogBufferHeader *header, int out_fd)
+{
+  // buffers of the same log share the field list, only parse it when it changes
+  static std::string  fieldlist_str;
+  static LogFieldList fieldlist;
+
+  if (fieldlist_str != header->fmt_fieldlist()) {
+    bool contains_aggregates = false;
+    fieldlist.clear();
+    fieldlist_str = header->fmt_fieldlist();
+    LogFormat::parse_symbol_string(fieldlist_str.c_str(), &fieldlist, &contains_aggregates);
+  }
+
+  LogBufferIterator iter(header);
+  LogEntryHeader   *entry;
+  std::string       out;
+  char              value[LOG_MAX_FORMATTED_LINE];
+
+  while ((entry = iter.next())) {
+    char *read_from = reinterpret_cast<char *>(entry) + sizeof(LogEntryHeader);
+    char *entry_end = reinterpret_cast<char *>(entry) + entry->entry_len;
+    char  sep       = '{';
+
+    for (LogField *field = fieldlist.first(); field && read_from < entry_end; field = fieldlist.next(field)) {
+      int n = field->unmarshal(&read_from, value, sizeof(value), LOG_ESCAPE_JSON);
+      out.append(1, sep).append("\"").append(field->symbol()).append("\":\"");
+      out.append(value, n > 0 ? n : 0).append("\"");
+      sep = ',';
+    }
+    out.append(sep == '{' ? "{}\n" : "}\n");
+  }
+
+  return LogFile::writeln(out.data(), out.size(), out_fd, ".");
+}
+
+/*
+ * Writes a LogBuffer read from a log file in the requested output format
+ */
+void
+write_logbuffer(LogBufferHeader *header, int out_fd)
+{
+  // see if there is an alternate format request from the command
+  // line
+  //
+  const char *alt_format = nullptr;
+  // convert the buffer to ascii entries and place onto stdout
+  //
+  if (!header->fmt_fieldlist()) {
+    // TODO investigate why this buffer goes wonky
+  } else if (json_flag) {
+    write_json_logbuffer(header, out_fd);
+  } else {
+    LogFile::write_ascii_logbuffer(header, out_fd, ".", alt_format);
+  }
+}
+
+/*
+ * Reads the rest of a columnar block, of which @a first_size bytes are in
+ * @a first, and writes the LogBuffer it holds
+ *
+ * @returns 0 on success, otherwise 1
+ */
+int
+process_columnar_block(int in_fd, int out_fd, const char *first, unsigned first_size)
+{
+  LogColumnar::BlockHeader block;
+
+  memcpy(&block, first, first_size);
+  if (!read_fully(in_fd, reinterpret_cast<char *>(&block) + first_size, sizeof(block) - first_size)) {
+    fprintf(stderr, "Bad columnar block header read!\n");
+    return 1;
+  }
+
+  uint64_t body_bytes = LogColumnar::body_bytes(block);
+  if (body_bytes > MAX_LOGBUFFER_SIZE) {
+    fprintf(stderr, "Columnar block too large! bytes=%" PRIu64 "\n", body_bytes);
+    return 1;
+  }
+
+  std::vector<char> body(body_bytes);
+  std::vector<char> buffer;
+  if (!read_fully(in_fd, body.data(), body.size())) {
+    fprintf(stderr, "Bad columnar block read!\n");
+    return 1;
+  }
+  if (!LogColumnar::decode(block, body.data(), buffer)) {
+    fprintf(stderr, "Bad columnar block!\n");
+    return 1;
+  }
+
+  write_logbuffer(reinterpret_cast<LogBufferHeader *>(buffer.data()), out_fd);
+  return 0;
+}
+
 int
 process_file(int in_fd, int out_fd)
 {
@@ -144,6 +271,15 @@ process_file(int in_fd, int out_fd)
       return 0;
     }
 
+    // columnar log files hold encoded LogBuffers
+    //
+    if (header->cookie == LogColumnar::COOKIE) {
+      if (process_columnar_block(in_fd, out_fd, buffer, first_read_size) != 0) {
+        return 1;
+      }
+      continue;
+    }
+
     // ensure that this is a valid logbuffer header
     //
     if (header->cookie != LOG_SEGMENT_COOKIE) {
@@ -198,17 +334,7 @@ process_file(int in_fd, int out_fd)
       fprintf(stderr, "Read too many bytes!\n");
       return 1;
     }
-    // see if there is an alternate format request from the command
-    // line
-    //
-    const char *alt_format = nullptr;
-    // convert the buffer to ascii entries and place onto stdout
-    //
-    if (header->fmt_fieldlist()) {
-      LogFile::write_ascii_logbuffer(header, out_fd, ".", alt_format);
-    } else {
-      // TODO investigate why this buffer goes wonky
-    }
+    write_logbuffer(header, out_fd);
   }
 }
 
@@ -301,7 +427,6 @@ main(int /* argc ATS_UNUSED */, const char *argv[])
   int error = NO_ERROR;
 
   if (n_file_arguments) {
-    int bin_ext_len   = strlen(LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION);
     int ascii_ext_len = strlen(LOG_FILE_ASCII_OBJECT_FILENAME_EXTENSION);
 
     for (unsigned i = 0; i < n_file_arguments; ++i) {
@@ -327,13 +452,16 @@ main(int /* argc ATS_UNUSED */, const char *argv[])
         }
 #endif
         if (auto_filenames) {
-          // change .blog to .log
+          // change .blog or .clog to .log
           //
-          int n = strlen(file_arguments[i]);
-          int copy_len =
-            (n >= bin_ext_len ?
-               (strcmp(&file_arguments[i][n - bin_ext_len], LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION) == 0 ? n - bin_ext_len : n) :
-               n);
+          int n        = strlen(file_arguments[i]);
+          int copy_len = n;
+          for (const char *ext : {LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION, LOG_FILE_COLUMNAR_OBJECT_FILENAME_EXTENSION}) {
+            int ext_len = strlen(ext);
+            if (n >= ext_len && strcmp(&file_arguments[i][n - ext_len], ext) == 0) {
+              copy_len = n - ext_len;
+            }
+          }
 
           char *out_filename = (char *)ats_malloc(copy_len + ascii_ext_len + 1);
 
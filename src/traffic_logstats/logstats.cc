@@ -34,6 +34,7 @@
 // Includes and namespaces etc.
 #include "../proxy/logging/LogStandalone.cc"
 
+#include "proxy/logging/LogColumnar.h"
 #include "proxy/logging/LogObject.h"
 #include "proxy/hdrs/HTTP.h"
 
@@ -1768,6 +1769,91 @@ parse_log_buff(LogBufferHeader *buf_header, bool summary = false, bool aggregate
   return 0;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Read the payload of a log buffer, waiting a little for a partial write.
+int
+read_buffer(int in_fd, char *buffer, int buffer_bytes)
+{
+  const int MAX_READ_TRIES       = 5;
+  int       nread                = 0;
+  int       total_read           = 0;
+  int       read_tries_remaining = MAX_READ_TRIES; // since the data will be old anyway, let's only try a few times.
+  do {
+    nread = read(in_fd, &buffer[total_read], buffer_bytes - total_read);
+    if (EOF == nread || !nread) { // just bail on error
+      Dbg(dbg_ctl_logstats, "Read failed while reading log buffer, wanted %d bytes, nread=%d, errno=%d", buffer_bytes - total_read,
+          nread, errno);
+      return 1;
+    } else {
+      total_read += nread;
+    }
+
+    if (total_read < buffer_bytes) {
+      if (--read_tries_remaining <= 0) {
+        Dbg(dbg_ctl_logstats_failed_retries, "Unable to read after %d tries, total_read=%d, buffer_bytes=%d", MAX_READ_TRIES,
+            total_read, buffer_bytes);
+        return 1;
+      }
+      // let's wait until we get more data on this file descriptor
+      Dbg(dbg_ctl_logstats_partial_read,
+          "Failed to read buffer payload [%d bytes], total_read=%d, buffer_bytes=%d, tries_remaining=%d", buffer_bytes - total_read,
+          total_read, buffer_bytes, read_tries_remaining);
+      usleep(50 * 1000); // wait 50ms
+    }
+  } while (total_read < buffer_bytes);
+
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Collect the stats of a log buffer.
+int
+process_buffer(LogBufferHeader *header, unsigned max_age)
+{
+  // Possibly skip too old entries (the entire buffer is skipped)
+  if (header->high_timestamp >= max_age) {
+    if (parse_log_buff(header, cl.summary != 0, cl.report_per_user != 0) != 0) {
+      Dbg(dbg_ctl_logstats, "Failed to parse log buffer.");
+      return 1;
+    }
+  } else {
+    Dbg(dbg_ctl_logstats, "Skipping old buffer (age=%d, max=%d)", header->high_timestamp, max_age);
+  }
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Read and collect the stats of a columnar block, the first bytes of which
+// have already been read.
+int
+process_columnar_block(int in_fd, const char *first, unsigned first_read_size, unsigned max_age)
+{
+  LogColumnar::BlockHeader block;
+
+  memcpy(&block, first, first_read_size);
+  if (read_buffer(in_fd, reinterpret_cast<char *>(&block) + first_read_size, sizeof(block) - first_read_size) != 0) {
+    return 1;
+  }
+
+  uint64_t body_bytes = LogColumnar::body_bytes(block);
+  if (body_bytes > MAX_LOGBUFFER_SIZE) {
+    Dbg(dbg_ctl_logstats, "Columnar block size [%" PRIu64 "] > expected [%d]", body_bytes, MAX_LOGBUFFER_SIZE);
+    return 1;
+  }
+
+  std::vector<char> body(body_bytes);
+  std::vector<char> buffer;
+  if (read_buffer(in_fd, body.data(), body.size()) != 0) {
+    return 1;
+  }
+  if (!LogColumnar::decode(block, body.data(), buffer)) {
+    Dbg(dbg_ctl_logstats, "Invalid columnar block.");
+    return 1;
+  }
+
+  return process_buffer(reinterpret_cast<LogBufferHeader *>(buffer.data()), max_age);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Process a file (FD)
 int
@@ -1801,8 +1887,8 @@ process_file(int in_fd, off_t offset, unsigned max_age)
         if (!nread || EOF == nread) {
           return 0;
         }
-        // ensure that this is a valid logbuffer header
-        if (header->cookie && (LOG_SEGMENT_COOKIE == header->cookie)) {
+        // ensure that this is a valid logbuffer header or columnar block
+        if (header->cookie && (LOG_SEGMENT_COOKIE == header->cookie || LogColumnar::COOKIE == header->cookie)) {
           offset = 0;
           break;
         }
@@ -1817,13 +1903,20 @@ process_file(int in_fd, off_t offset, unsigned max_age)
         return 0;
       }
 
-      // ensure that this is a valid logbuffer header
-      if (header->cookie != LOG_SEGMENT_COOKIE) {
+      // ensure that this is a valid logbuffer header or columnar block
+      if (header->cookie != LOG_SEGMENT_COOKIE && header->cookie != LogColumnar::COOKIE) {
         Dbg(dbg_ctl_logstats, "Invalid segment cookie (expected %d, got %d)", LOG_SEGMENT_COOKIE, header->cookie);
         return 1;
       }
     }
 
+    if (header->cookie == LogColumnar::COOKIE) {
+      if (process_columnar_block(in_fd, buffer, first_read_size, max_age) != 0) {
+        return 1;
+      }
+      continue;
+    }
+
     Dbg(dbg_ctl_logstats, "LogBuffer version %d, current = %d", header->version, LOG_SEGMENT_VERSION);
     if (header->version != LOG_SEGMENT_VERSION) {
       return 1;
@@ -1850,41 +1943,12 @@ process_file(int in_fd, off_t offset, unsigned max_age)
       return 1;
     }
 
-    const int MAX_READ_TRIES       = 5;
-    int       total_read           = 0;
-    int       read_tries_remaining = MAX_READ_TRIES; // since the data will be old anyway, let's only try a few times.
-    do {
-      nread = read(in_fd, &buffer[sizeof(LogBufferHeader) + total_read], buffer_bytes - total_read);
-      if (EOF == nread || !nread) { // just bail on error
-        Dbg(dbg_ctl_logstats, "Read failed while reading log buffer, wanted %d bytes, nread=%d, errno=%d",
-            buffer_bytes - total_read, nread, errno);
-        return 1;
-      } else {
-        total_read += nread;
-      }
-
-      if (total_read < buffer_bytes) {
-        if (--read_tries_remaining <= 0) {
-          Dbg(dbg_ctl_logstats_failed_retries, "Unable to read after %d tries, total_read=%d, buffer_bytes=%d", MAX_READ_TRIES,
-              total_read, buffer_bytes);
-          return 1;
-        }
-        // let's wait until we get more data on this file descriptor
-        Dbg(dbg_ctl_logstats_partial_read,
-            "Failed to read buffer payload [%d bytes], total_read=%d, buffer_bytes=%d, tries_remaining=%d",
-            buffer_bytes - total_read, total_read, buffer_bytes, read_tries_remaining);
-        usleep(50 * 1000); // wait 50ms
-      }
-    } while (total_read < buffer_bytes);
+    if (read_buffer(in_fd, &buffer[sizeof(LogBufferHeader)], buffer_bytes) != 0) {
+      return 1;
+    }
 
-    // Possibly skip too old entries (the entire buffer is skipped)
-    if (header->high_timestamp >= max_age) {
-      if (parse_log_buff(header, cl.summary != 0, cl.report_per_user != 0) != 0) {
-        Dbg(dbg_ctl_logstats, "Failed to parse log buffer.");
-        return 1;
-      }
-    } else {
-      Dbg(dbg_ctl_logstats, "Skipping old buffer (age=%d, max=%d)", header->high_timestamp, max_age);
+    if (process_buffer(header, max_age) != 0) {
+      return 1;
     }
   }
 
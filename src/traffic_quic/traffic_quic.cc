@@ -30,7 +30,6 @@
 #include "proxy/hdrs/URL.h"
 #include "proxy/hdrs/MIME.h"
 #include "proxy/hdrs/HTTP.h"
-#include "proxy/hdrs/HuffmanCodec.h"
 #include "proxy/http3/Http3Config.h"
 
 #include "diags.h"
@@ -116,7 +115,6 @@ main(int argc, const char **argv)
   url_init();
   mime_init();
   http_init();
-  hpack_huffman_init();
 
   ts::Http3Config::startup();
 
@@ -64,5 +64,7 @@ register_admin_jsonrpc_handlers()
                           {{rpc::RESTRICTED_API}});
   rpc::add_method_handler("admin_storage_get_device_status", &get_storage_status, &core_ats_rpc_service_provider_handle,
                           {{rpc::NON_RESTRICTED_API}});
+  rpc::add_method_handler("admin_storage_get_stripe_status", &get_stripe_status, &core_ats_rpc_service_provider_handle,
+                          {{rpc::NON_RESTRICTED_API}});
 }
 } // namespace rpc::admin
@@ -99,7 +99,6 @@ extern "C" int plock(int);
 #include "proxy/ParentSelection.h"
 #include "proxy/HostStatus.h"
 #include "proxy/hdrs/HTTP.h"
-#include "proxy/hdrs/HuffmanCodec.h"
 #include "proxy/Plugin.h"
 #include "proxy/shared/DiagsConfig.h"
 #include "proxy/http/remap/RemapConfig.h"
@@ -1541,7 +1540,6 @@ init_http_header()
   url_init();
   mime_init();
   http_init();
-  hpack_huffman_init();
 }
 
 #if TS_HAS_TESTS
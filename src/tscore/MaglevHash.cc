@@ -0,0 +1,148 @@
+/** @file
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "tscore/MaglevHash.h"
+#include "tscore/ink_assert.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+bool
+is_prime(uint32_t n)
+{
+  if (n < 2) {
+    return false;
+  }
+  for (uint32_t d = 2; d * d <= n; ++d) {
+    if (n % d == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t
+node_hash(ATSHash64 *h, const char *prefix, const char *name)
+{
+  h->update(prefix, strlen(prefix));
+  h->update(name, strlen(name));
+  h->final();
+  uint64_t value = h->get();
+  h->clear();
+  return value;
+}
+
+} // end anonymous namespace
+
+ATSMaglevHash::ATSMaglevHash(uint32_t s) : min_size(s) {}
+
+void
+ATSMaglevHash::insert(ATSConsistentHashNode *node, float weight)
+{
+  ink_assert(table.empty());
+  // as in ATSConsistentHash, a node without weight gets no share of the keys.
+  if (weight > 0) {
+    nodes.emplace_back(node, weight);
+  }
+}
+
+void
+ATSMaglevHash::build(ATSHash64 *h)
+{
+  table.clear();
+  if (nodes.empty()) {
+    return;
+  }
+
+  // keep the table well above 100 slots per node for an even spread, and prime so that every
+  // permutation covers all of the slots.
+  uint32_t size = std::max<uint32_t>({min_size, static_cast<uint32_t>(nodes.size() * 100), 2});
+  while (!is_prime(size)) {
+    ++size;
+  }
+
+  std::vector<uint32_t> offset(nodes.size());
+  std::vector<uint32_t> skip(nodes.size());
+  std::vector<uint32_t> next(nodes.size(), 0);
+  std::vector<float>    credit(nodes.size(), 0);
+  float                 max_weight = 0;
+
+  for (size_t n = 0; n < nodes.size(); ++n) {
+    const char *name = nodes[n].first->name ? nodes[n].first->name : "";
+    offset[n]        = node_hash(h, "offset-", name) % size;
+    skip[n]          = node_hash(h, "skip-", name) % (size - 1) + 1;
+    max_weight       = std::max(max_weight, nodes[n].second);
+  }
+
+  constexpr uint32_t EMPTY = UINT32_MAX;
+  table.assign(size, EMPTY);
+
+  // each round every node earns credit in proportion to its weight and takes its next preferred free
+  // slot when it has a whole turn. The heaviest node takes a slot every round.
+  for (uint32_t filled = 0; filled < size;) {
+    for (size_t n = 0; n < nodes.size() && filled < size; ++n) {
+      credit[n] += nodes[n].second / max_weight;
+      if (credit[n] < 1.0f) {
+        continue;
+      }
+      credit[n] -= 1.0f;
+
+      uint32_t slot;
+      do {
+        slot = (offset[n] + static_cast<uint64_t>(next[n]) * skip[n]) % size;
+        ++next[n];
+      } while (table[slot] != EMPTY);
+      table[slot] = n;
+      ++filled;
+    }
+  }
+}
+
+ATSConsistentHashNode *
+ATSMaglevHash::lookup_by_hashval(uint64_t hashval, ATSMaglevHashIter *i, bool *w) const
+{
+  if (table.empty()) {
+    *w = true;
+    return nullptr;
+  }
+
+  // the table size is prime, so any stride visits every slot before returning to the first.
+  i->slot   = hashval % table.size();
+  i->stride = (hashval >> 32) % (table.size() - 1) + 1;
+  i->steps  = 0;
+  *w        = false;
+  return nodes[table[i->slot]].first;
+}
+
+ATSConsistentHashNode *
+ATSMaglevHash::lookup_next(ATSMaglevHashIter *i, bool *w) const
+{
+  if (table.empty()) {
+    *w = true;
+    return nullptr;
+  }
+
+  i->slot = (static_cast<uint64_t>(i->slot) + i->stride) % table.size();
+  // every slot has been visited once the walk is back at the first one.
+  *w = ++i->steps >= table.size();
+  return nodes[table[i->slot]].first;
+}
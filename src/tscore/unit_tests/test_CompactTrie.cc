@@ -0,0 +1,129 @@
+/** @file
+
+    Unit tests for CompactTrie
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tscore/CompactTrie.h"
+#include "tscore/Trie.h"
+#include "catch.hpp"
+
+namespace
+{
+struct Value {
+  explicit Value(int i) : id(i) {}
+  void
+  Print() const
+  {
+  }
+
+  int id;
+  LINK(Value, link);
+};
+
+int
+id_of(Value const *v)
+{
+  return v ? v->id : -1;
+}
+
+} // end anonymous namespace
+
+TEST_CASE("CompactTrie prefix search", "[libts][CompactTrie]")
+{
+  CompactTrie<Value> trie;
+
+  REQUIRE(trie.Insert("", new Value(0), 10));
+  REQUIRE(trie.Insert("foo", new Value(1), 5));
+  REQUIRE(trie.Insert("foo/bar", new Value(2), 7));
+  REQUIRE(trie.Insert("foo/baz", new Value(3), 1));
+  REQUIRE(trie.Insert("fox", new Value(4), 20));
+
+  Value *dup = new Value(5);
+  CHECK_FALSE(trie.Insert("foo", dup, 0));
+  delete dup;
+
+  trie.Freeze();
+  REQUIRE(trie.Frozen());
+
+  CHECK(id_of(trie.Search("")) == 0);
+  CHECK(id_of(trie.Search("bar")) == 0);
+  CHECK(id_of(trie.Search("fo")) == 0);
+  CHECK(id_of(trie.Search("foo")) == 1);
+  CHECK(id_of(trie.Search("foo/")) == 1);
+  // a longer match with a higher rank does not win
+  CHECK(id_of(trie.Search("foo/bar/index.html")) == 1);
+  CHECK(id_of(trie.Search("foo/baz")) == 3);
+  CHECK(id_of(trie.Search("foo/bazooka")) == 3);
+  CHECK(id_of(trie.Search("fox")) == 0);
+  CHECK(id_of(trie.Search("foo/bar", 3)) == 1);
+
+  // values are iterated in insertion order
+  std::vector<int> ids;
+  for (auto const *v : trie) {
+    ids.push_back(v->id);
+  }
+  CHECK(ids == std::vector<int>{0, 1, 2, 3, 4});
+
+  Value *late = new Value(6);
+  CHECK_FALSE(trie.Insert("late", late, 0));
+  delete late;
+}
+
+TEST_CASE("CompactTrie matches Trie", "[libts][CompactTrie]")
+{
+  std::mt19937                       rng(13);
+  std::uniform_int_distribution<int> len(0, 12);
+  std::uniform_int_distribution<int> chr(0, 5);
+  std::uniform_int_distribution<int> rank(0, 1000);
+  auto                               random_key = [&]() {
+    std::string key;
+    for (int n = len(rng); n > 0; --n) {
+      key += "/ab\xff.z"[chr(rng)];
+    }
+    return key;
+  };
+
+  Trie<Value>        trie;
+  CompactTrie<Value> compact;
+  for (int i = 0; i < 2000; ++i) {
+    std::string key = random_key();
+    int         r   = rank(rng);
+    Value      *v   = new Value(i);
+    if (trie.Insert(key.data(), v, r, key.size())) {
+      REQUIRE(compact.Insert(key.data(), new Value(i), r, key.size()));
+    } else {
+      delete v;
+      Value *c = new Value(i);
+      REQUIRE_FALSE(compact.Insert(key.data(), c, r, key.size()));
+      delete c;
+    }
+  }
+  compact.Freeze();
+
+  for (int i = 0; i < 10000; ++i) {
+    std::string key = random_key();
+    REQUIRE(id_of(compact.Search(key.data(), key.size())) == id_of(trie.Search(key.data(), key.size())));
+  }
+}
@@ -0,0 +1,189 @@
+/** @file
+
+    Unit tests for ATSMaglevHash
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tscore/HashSip.h"
+#include "tscore/MaglevHash.h"
+#include "catch.hpp"
+
+namespace
+{
+constexpr int N_NODES = 10;
+constexpr int N_KEYS  = 100000;
+
+struct Node : ATSConsistentHashNode {
+  explicit Node(int i) : label("parent" + std::to_string(i) + ".example.com") { name = label.data(); }
+  std::string label;
+};
+
+std::vector<uint64_t>
+make_keys()
+{
+  std::mt19937_64       rng(7);
+  std::vector<uint64_t> keys(N_KEYS);
+  for (auto &k : keys) {
+    k = rng();
+  }
+  return keys;
+}
+
+// the first node for each key that is not @a down.
+std::vector<ATSConsistentHashNode *>
+assign(ATSMaglevHash const &table, std::vector<uint64_t> const &keys, ATSConsistentHashNode *down = nullptr)
+{
+  std::vector<ATSConsistentHashNode *> result;
+  for (auto k : keys) {
+    ATSMaglevHashIter      iter;
+    bool                   wrapped = false;
+    ATSConsistentHashNode *node    = table.lookup_by_hashval(k, &iter, &wrapped);
+    while (node == down && !wrapped) {
+      node = table.lookup_next(&iter, &wrapped);
+    }
+    result.push_back(node);
+  }
+  return result;
+}
+
+} // end anonymous namespace
+
+TEST_CASE("MaglevHash balance", "[libts][MaglevHash]")
+{
+  std::deque<Node> nodes;
+  for (int i = 0; i < N_NODES; ++i) {
+    nodes.emplace_back(i);
+  }
+  ATSHash64Sip24 hash;
+  ATSMaglevHash  table;
+  for (auto &n : nodes) {
+    table.insert(&n, &n == &nodes[0] ? 2.0 : 1.0);
+  }
+  table.build(&hash);
+  REQUIRE(table.table_size() >= 100 * N_NODES);
+
+  std::map<ATSConsistentHashNode *, int> counts;
+  for (auto *n : assign(table, make_keys())) {
+    ++counts[n];
+  }
+
+  // nodes[0] has twice the weight of the others.
+  double share = static_cast<double>(N_KEYS) / (N_NODES + 1);
+  CHECK(counts[&nodes[0]] > 2 * share * 0.9);
+  CHECK(counts[&nodes[0]] < 2 * share * 1.1);
+  for (int i = 1; i < N_NODES; ++i) {
+    CHECK(counts[&nodes[i]] > share * 0.9);
+    CHECK(counts[&nodes[i]] < share * 1.1);
+  }
+}
+
+TEST_CASE("MaglevHash remapping", "[libts][MaglevHash]")
+{
+  std::deque<Node> nodes;
+  for (int i = 0; i < N_NODES; ++i) {
+    nodes.emplace_back(i);
+  }
+  ATSHash64Sip24 hash;
+  ATSMaglevHash  table;
+  for (auto &n : nodes) {
+    table.insert(&n);
+  }
+  table.build(&hash);
+
+  auto keys   = make_keys();
+  auto before = assign(table, keys);
+
+  SECTION("a parent goes down")
+  {
+    // Walking past the down parent moves only its own keys, and spreads them over all the others.
+    ATSConsistentHashNode                 *down  = &nodes[3];
+    auto                                   after = assign(table, keys, down);
+    int                                    moved = 0;
+    std::map<ATSConsistentHashNode *, int> taken;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      REQUIRE(after[i] != down);
+      if (before[i] != after[i]) {
+        REQUIRE(before[i] == down);
+        ++moved;
+        ++taken[after[i]];
+      }
+    }
+    CHECK(moved == std::count(before.begin(), before.end(), down));
+    CHECK(taken.size() == N_NODES - 1);
+    for (auto const &[node, count] : taken) {
+      CHECK(count > moved / (N_NODES - 1) * 0.8);
+    }
+  }
+
+  SECTION("a parent is removed from the config")
+  {
+    // Rebuilding the table without the parent moves its keys and, unlike the walk, a few others.
+    ATSMaglevHash smaller;
+    for (auto &n : nodes) {
+      if (&n != &nodes[3]) {
+        smaller.insert(&n);
+      }
+    }
+    smaller.build(&hash);
+
+    auto after = assign(smaller, keys);
+    int  moved = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      moved += before[i] != after[i];
+    }
+    double fraction = static_cast<double>(moved) / N_KEYS;
+    CHECK(fraction > 1.0 / N_NODES * 0.9);
+    CHECK(fraction < 1.0 / N_NODES * 1.5);
+  }
+
+  SECTION("all parents are down")
+  {
+    ATSMaglevHashIter iter;
+    bool              wrapped = false;
+    table.lookup_by_hashval(keys[0], &iter, &wrapped);
+    uint32_t steps = 0;
+    while (!wrapped) {
+      table.lookup_next(&iter, &wrapped);
+      ++steps;
+    }
+    CHECK(steps == table.table_size());
+  }
+}
+
+TEST_CASE("MaglevHash empty", "[libts][MaglevHash]")
+{
+  ATSHash64Sip24    hash;
+  ATSMaglevHash     table;
+  ATSMaglevHashIter iter;
+  bool              wrapped = false;
+
+  Node zero(0);
+  table.insert(&zero, 0.0);
+  table.build(&hash);
+  CHECK(table.lookup_by_hashval(1, &iter, &wrapped) == nullptr);
+  CHECK(wrapped);
+}
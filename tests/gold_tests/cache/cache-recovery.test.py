@@ -0,0 +1,99 @@
+'''
+Test that the cache directory is recovered on the task threads at startup.
+'''
+#  Licensed to the Apache Software Foundation (ASF) under one
+#  or more contributor license agreements.  See the NOTICE file
+#  distributed with this work for additional information
+#  regarding copyright ownership.  The ASF licenses this file
+#  to you under the Apache License, Version 2.0 (the
+#  "License"); you may not use this file except in compliance
+#  with the License.  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+Test.Summary = '''
+Test that a second traffic_server on the storage of the first recovers its directory on the task threads
+'''
+
+Test.ContinueOnFail = True
+
+server = Test.MakeOriginServer("server")
+request_header = {"headers": "GET /cached HTTP/1.1\r\nHost: www.example.com\r\n\r\n", "timestamp": "1469733493.993", "body": ""}
+response_header = {
+    "headers": "HTTP/1.1 200 OK\r\nConnection: close\r\nCache-Control: max-age=300\r\nContent-Length: 11\r\n\r\n",
+    "timestamp": "1469733493.993",
+    "body": "yabadabadoo"
+}
+server.addResponse("sessionlog.json", request_header, response_header)
+
+ts1 = Test.MakeATSProcess("ts1")
+# Both processes use the same storage, the second one starts with the directory the first one synced.
+storage_path = ts1.Variables.STORAGEDIR
+ts1.Disk.storage_config.AddLine(f"{storage_path} 256M")
+ts1.Disk.remap_config.AddLine(f'map / http://127.0.0.1:{server.Variables.Port}')
+ts1.Disk.records_config.update({
+    'proxy.config.cache.dir.sync_frequency': 1,
+    'proxy.config.cache.dir.sync_delay': 1,
+})
+
+ts2 = Test.MakeATSProcess("ts2")
+ts2.Disk.storage_config.AddLine(f"{storage_path} 256M")
+ts2.Disk.remap_config.AddLine(f'map / http://127.0.0.1:{server.Variables.Port}')
+ts2.Disk.records_config.update(
+    {
+        'proxy.config.diags.debug.enabled': 1,
+        'proxy.config.diags.debug.tags': 'cache_init',
+        'proxy.config.task_threads': 1,
+    })
+
+curl = '-s -D - -o /dev/null --ipv4 --http1.1 -H "Host: www.example.com" http://localhost:{port}/cached'
+
+tr = Test.AddTestRun("Fill the cache")
+tr.Processes.Default.StartBefore(server)
+tr.Processes.Default.StartBefore(ts1)
+tr.MakeCurlCommand(curl.format(port=ts1.Variables.port))
+tr.Processes.Default.ReturnCode = 0
+tr.Processes.Default.Streams.stdout = Testers.ContainsExpression("200 OK", "The response should be served")
+tr.StillRunningAfter = server
+tr.StillRunningAfter = ts1
+
+# Wait for the directory to be synced, then stop the first process.
+tr = Test.AddTestRun("Sync the directory")
+tr.Processes.Default.Command = 'sleep 5'
+tr.Processes.Default.ReturnCode = 0
+tr.StillRunningAfter = server
+
+tr = Test.AddTestRun("Serve from the recovered cache")
+tr.Processes.Default.StartBefore(ts2)
+tr.MakeCurlCommand(curl.format(port=ts2.Variables.port))
+tr.Processes.Default.ReturnCode = 0
+tr.Processes.Default.Streams.stdout = Testers.ContainsExpression("200 OK", "The response should be served")
+tr.StillRunningAfter = server
+tr.StillRunningAfter = ts2
+
+tr = Test.AddTestRun("Check the cache hit")
+tr.Processes.Default.Command = 'traffic_ctl metric get proxy.process.http.cache_hit_fresh'
+tr.Processes.Default.Env = ts2.Env
+tr.Processes.Default.ReturnCode = 0
+tr.Processes.Default.Streams.stdout = Testers.ContainsExpression(
+    'proxy.process.http.cache_hit_fresh 1', 'The object cached by the first process should be a hit')
+tr.StillRunningAfter = ts2
+
+tr = Test.AddTestRun("Check the stripe status")
+tr.Processes.Default.Command = 'traffic_ctl rpc invoke admin_storage_get_stripe_status'
+tr.Processes.Default.Env = ts2.Env
+tr.Processes.Default.ReturnCode = 0
+tr.Processes.Default.Streams.stdout = Testers.ContainsExpression('ready', 'The stripes should have been recovered')
+tr.Processes.Default.Streams.stdout += Testers.ExcludesExpression('failed', 'No stripe should have failed')
+tr.StillRunningAfter = ts2
+
+ts2.Disk.traffic_out.Content = Testers.ContainsExpression(
+    r"\[ET_TASK 0\] DEBUG: .*\(cache_init\) recovering", "The directory should be recovered on the task thread")
+ts2.Disk.traffic_out.Content += Testers.ExcludesExpression(
+    r"\[ET_NET [0-9]+\] DEBUG: .*\(cache_init\) recovering", "The directory should not be recovered on a net thread")
@@ -0,0 +1,76 @@
+'''
+Test that a sharded server session pool hands sessions between threads.
+'''
+#  Licensed to the Apache Software Foundation (ASF) under one
+#  or more contributor license agreements.  See the NOTICE file
+#  distributed with this work for additional information
+#  regarding copyright ownership.  The ASF licenses this file
+#  to you under the Apache License, Version 2.0 (the
+#  "License"); you may not use this file except in compliance
+#  with the License.  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+Test.Summary = '''
+Test that a sharded server session pool takes a session from the pool of another thread
+'''
+
+server = Test.MakeOriginServer("server")
+for path in ['one', 'two', 'three']:
+    request_header = {
+        "headers": f"GET /{path} HTTP/1.1\r\nHost: www.example.com\r\nContent-Length: 0\r\n\r\n",
+        "timestamp": "1469733493.993",
+        "body": ""
+    }
+    response_header = {
+        "headers": "HTTP/1.1 200 OK\r\nServer: microserver\r\nContent-Length: 0\r\n\r\n",
+        "timestamp": "1469733493.993",
+        "body": ""
+    }
+    server.addResponse("sessionlog.json", request_header, response_header)
+
+ts = Test.MakeATSProcess("ts")
+ts.Disk.remap_config.AddLine(f'map / http://127.0.0.1:{server.Variables.Port}')
+ts.Disk.records_config.update(
+    {
+        'proxy.config.diags.debug.enabled': 1,
+        'proxy.config.diags.debug.tags': 'http_ss',
+        # Two net threads, which the one accept thread hands the client connections to in turn.
+        'proxy.config.exec_thread.autoconfig.enabled': 0,
+        'proxy.config.exec_thread.limit': 2,
+        'proxy.config.accept_threads': 1,
+        'proxy.config.http.server_session_sharing.pool': 'sharded',
+        'proxy.config.http.server_session_sharing.match': 'both',
+    })
+
+# Every request comes on a new client connection, so the next one runs on the other thread, where the origin session is
+# not pooled.
+tr = Test.AddTestRun("Requests on alternate threads")
+tr.MakeCurlCommandMulti(
+    '{{curl}} -v -H"Host: www.example.com" -H"Connection: close" http://127.0.0.1:{port}/one &&'
+    '{{curl}} -v -H"Host: www.example.com" -H"Connection: close" http://127.0.0.1:{port}/two &&'
+    '{{curl}} -v -H"Host: www.example.com" -H"Connection: close" http://127.0.0.1:{port}/three'.format(port=ts.Variables.port))
+tr.Processes.Default.ReturnCode = 0
+tr.Processes.Default.StartBefore(server)
+tr.Processes.Default.StartBefore(ts)
+tr.Processes.Default.Streams.stderr = "gold/200.gold"
+tr.StillRunningAfter = ts
+tr.StillRunningAfter = server
+
+ts.Disk.traffic_out.Content = Testers.ContainsExpression(
+    "return session from the pool of thread", "Verify that a session was taken from another thread")
+
+tr = Test.AddTestRun("Check the steals")
+tr.Processes.Default.Command = 'traffic_ctl metric get proxy.process.http.pooled_server_session.steals'
+tr.Processes.Default.ReturnCode = 0
+tr.Processes.Default.Env = ts.Env
+tr.Processes.Default.Streams.stdout = Testers.ContainsExpression(
+    'proxy.process.http.pooled_server_session.steals [1-9]', 'Sessions should have been stolen from another thread')
+tr.StillRunningAfter = ts
+tr.StillRunningAfter = server
@@ -0,0 +1,147 @@
+/** @file
+
+  Micro benchmark of the parent selection hashes - requires Catch2 v2.9.0+
+
+  Compares ATSConsistentHash (ring) and ATSMaglevHash lookups, for the primary
+  parent and for the next one after it fails.
+  ```
+  $ ./benchmark_ConsistentHash --ts-nhosts 32
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "tscore/ConsistentHash.h"
+#include "tscore/HashSip.h"
+#include "tscore/MaglevHash.h"
+
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Args
+struct Conf {
+  int nhosts = 16;
+};
+
+Conf conf;
+
+constexpr int N_KEYS = 10000;
+
+struct Node : ATSConsistentHashNode {
+  explicit Node(int i) : label("parent" + std::to_string(i) + ".example.com") { name = label.data(); }
+  std::string label;
+};
+
+} // end anonymous namespace
+
+TEST_CASE("ConsistentHash", "")
+{
+  std::deque<Node> nodes;
+  for (int i = 0; i < conf.nhosts; ++i) {
+    nodes.emplace_back(i);
+  }
+
+  ATSHash64Sip24    hash;
+  ATSConsistentHash ring;
+  ATSMaglevHash     maglev;
+  for (auto &n : nodes) {
+    ring.insert(&n, 1.0, &hash);
+    hash.clear();
+    maglev.insert(&n);
+  }
+  maglev.build(&hash);
+
+  std::mt19937_64       rng(11);
+  std::vector<uint64_t> keys(N_KEYS);
+  for (auto &k : keys) {
+    k = rng();
+  }
+
+  BENCHMARK("ring lookup")
+  {
+    ATSConsistentHashIter iter;
+    bool                  wrapped = false;
+    uintptr_t             sum     = 0;
+    for (auto k : keys) {
+      sum += reinterpret_cast<uintptr_t>(ring.lookup_by_hashval(k, &iter, &wrapped));
+    }
+    return sum;
+  };
+
+  BENCHMARK("maglev lookup")
+  {
+    ATSMaglevHashIter iter;
+    bool              wrapped = false;
+    uintptr_t         sum     = 0;
+    for (auto k : keys) {
+      sum += reinterpret_cast<uintptr_t>(maglev.lookup_by_hashval(k, &iter, &wrapped));
+    }
+    return sum;
+  };
+
+  BENCHMARK("ring lookup and next")
+  {
+    ATSConsistentHashIter iter;
+    bool                  wrapped = false;
+    uintptr_t             sum     = 0;
+    for (auto k : keys) {
+      sum += reinterpret_cast<uintptr_t>(ring.lookup_by_hashval(k, &iter, &wrapped));
+      sum += reinterpret_cast<uintptr_t>(ring.lookup(nullptr, &iter, &wrapped, &hash));
+    }
+    return sum;
+  };
+
+  BENCHMARK("maglev lookup and next")
+  {
+    ATSMaglevHashIter iter;
+    bool              wrapped = false;
+    uintptr_t         sum     = 0;
+    for (auto k : keys) {
+      sum += reinterpret_cast<uintptr_t>(maglev.lookup_by_hashval(k, &iter, &wrapped));
+      sum += reinterpret_cast<uintptr_t>(maglev.lookup_next(&iter, &wrapped));
+    }
+    return sum;
+  };
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  auto cli = session.cli() | Opt(conf.nhosts, "")["--ts-nhosts"]("number of parents (default: 16)");
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  return session.run();
+}
@@ -0,0 +1,156 @@
+/** @file
+
+  Micro benchmark of the remap path tries - requires Catch2 v2.9.0+
+
+  Compares building and searching Trie and CompactTrie with generated remap style paths.
+  ```
+  $ ./benchmark_Trie --ts-npaths 100000
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "tscore/CompactTrie.h"
+#include "tscore/Trie.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Args
+struct Conf {
+  int npaths = 10000;
+};
+
+Conf conf;
+
+struct Value {
+  void
+  Print() const
+  {
+  }
+
+  LINK(Value, link);
+};
+
+std::vector<std::string>
+make_paths(int n)
+{
+  std::mt19937                       rng(1);
+  std::uniform_int_distribution<int> depth(1, 4);
+  std::uniform_int_distribution<int> segment(0, 999);
+
+  std::vector<std::string> paths;
+  paths.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    std::string path = "tenant" + std::to_string(i % 512);
+    for (int d = depth(rng); d > 0; --d) {
+      path += "/dir" + std::to_string(segment(rng));
+    }
+    paths.push_back(std::move(path));
+  }
+  return paths;
+}
+
+template <typename T>
+void
+fill(T &trie, std::vector<std::string> const &paths)
+{
+  for (size_t i = 0; i < paths.size(); ++i) {
+    Value *v = new Value;
+    if (!trie.Insert(paths[i].data(), v, i, paths[i].size())) {
+      delete v;
+    }
+  }
+}
+
+} // end anonymous namespace
+
+TEST_CASE("Trie", "")
+{
+  auto paths = make_paths(conf.npaths);
+
+  std::vector<std::string> requests;
+  for (size_t i = 0; i < paths.size(); i += 7) {
+    requests.push_back(paths[i] + "/index.html?q=1");
+  }
+
+  BENCHMARK("Trie build")
+  {
+    Trie<Value> trie;
+    fill(trie, paths);
+    return trie.Empty();
+  };
+
+  BENCHMARK("CompactTrie build")
+  {
+    CompactTrie<Value> trie;
+    fill(trie, paths);
+    trie.Freeze();
+    return trie.NodeCount();
+  };
+
+  Trie<Value> trie;
+  fill(trie, paths);
+  CompactTrie<Value> compact;
+  fill(compact, paths);
+  compact.Freeze();
+
+  BENCHMARK("Trie search")
+  {
+    int found = 0;
+    for (auto const &r : requests) {
+      found += trie.Search(r.data(), r.size()) != nullptr;
+    }
+    return found;
+  };
+
+  BENCHMARK("CompactTrie search")
+  {
+    int found = 0;
+    for (auto const &r : requests) {
+      found += compact.Search(r.data(), r.size()) != nullptr;
+    }
+    return found;
+  };
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  auto cli = session.cli() | Opt(conf.npaths, "")["--ts-npaths"]("number of paths (default: 10000)");
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  return session.run();
+}